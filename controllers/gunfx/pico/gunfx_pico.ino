@@ -6,6 +6,7 @@
   - Nozzle flash LED (PWM)
   - Smoke heater and fan
   - Gun servos (srv_1, srv_2, srv_3)
+  - Optional PWM input capture (PIO timed) streamed back to the Pi
   
   Binary Serial Protocol (115200 baud, COBS framed, delimiter 0x00):
   Packet: [type:u8][len:u8][payload:len][crc8(0x07)]; frame encoded with COBS, terminated by 0x00
@@ -19,21 +20,27 @@
     0xF0 INIT          payload: none (daemon initialization - reset to safe state)
     0xF1 SHUTDOWN      payload: none (daemon shutdown - enter safe state)
     0xF2 KEEPALIVE     payload: none (periodic keepalive from daemon)
+    0x30 CAPTURE_CTRL  payload: enable:u8 (0=stop, 1=stream capture frames)
   Telemetry (Pico -> Pi):
     0xF3 INIT_READY    payload: module_name:string (sent in response to INIT)
     0xF4 STATUS        payload: flags:u8 (bit0=firing, bit1=flash_active, bit2=flash_fading, bit3=heater_on, bit4=fan_on, bit5=fan_spindown),
                                   fan_off_remaining_ms:u16le, servo_us[3]:u16le each, rate_of_fire_rpm:u16le
+    0x31 CAPTURE_FRAME payload: fresh_mask:u8 (bit i = input i has a new pulse), age_us:u16le (newest
+                                  capture to send), pulse_us[inputs]:u16le each
 */
 
 #include <Arduino.h>
 #include <Servo.h>
 #include <math.h>
+#include <hardware/clocks.h>
+#include <hardware/pio.h>
 
 // ---------------------- Pin Configuration ----------------------
 // GunFX Pico Board Pinout:
 //   GPIO 1:  Servo 1
 //   GPIO 2:  Servo 2
 //   GPIO 3:  Servo 3
+//   GPIO 4-8: PWM capture inputs 1-5
 //   GPIO 13: Blue LED (status)
 //   GPIO 14: Yellow LED (heater indicator)
 //   GPIO 16: Smoke Fan Motor
@@ -54,6 +61,10 @@ const uint8_t PIN_SMOKE_HEATER    = 17; // GP17 - Smoke heater
 const uint8_t PIN_LED_BLUE        = 13; // GP13 - Blue status LED
 const uint8_t PIN_LED_YELLOW      = 14; // GP14 - Yellow heater indicator LED
 
+// PWM capture inputs (one PIO state machine each; the servos use PIO too)
+const uint8_t PIN_CAPTURE[]       = { 4, 5, 6, 7, 8 }; // GP4-GP8 - capture inputs 1-5
+const size_t  CAPTURE_INPUTS      = sizeof(PIN_CAPTURE) / sizeof(PIN_CAPTURE[0]);
+
 // ---------------------- Constants ----------------------
 const uint32_t SERIAL_BAUD        = 115200;
 const uint8_t FLASH_PWM_DUTY      = 255;      // Full brightness during flash
@@ -65,6 +76,8 @@ const int SERVO_DEFAULT_MAX_SPEED = 4000;     // us per second
 const int SERVO_DEFAULT_ACCEL     = 8000;     // us per second^2
 const int SERVO_DEFAULT_DECEL     = 8000;     // us per second^2
 const uint32_t STATUS_INTERVAL_MS = 1000;     // Periodic status interval
+const uint32_t CAPTURE_FRAME_INTERVAL_US = 5000; // Minimum spacing of capture frames
+const uint32_t CAPTURE_TICK_HZ    = 2000000;  // PIO clock: one 2-cycle count loop per microsecond
 
 // ---------------------- Binary Protocol (COBS framed, delimiter 0x00) ----------------------
 //  Packet format (before COBS): [type:u8][len:u8][payload:len bytes][crc:u8]
@@ -79,9 +92,11 @@ const uint32_t STATUS_INTERVAL_MS = 1000;     // Periodic status interval
 //  0xF0: INIT          payload: none (daemon initialization - reset to safe state)
 //  0xF1: SHUTDOWN      payload: none (daemon shutdown - enter safe state)
 //  0xF2: KEEPALIVE     payload: none (periodic keepalive from daemon)
+//  0x30: CAPTURE_CTRL  payload: enable:u8 (0=stop, 1=stream capture frames)
 //  Telemetry (Pico -> Pi):
 //  0xF3: INIT_READY    payload: module_name:string (sent in response to INIT)
 //  0xF4: STATUS        payload: flags:u8, fan_off_remaining_ms:u16le, servo_us[3]:u16le each, rate_of_fire_rpm:u16le
+//  0x31: CAPTURE_FRAME payload: fresh_mask:u8, age_us:u16le, pulse_us[CAPTURE_INPUTS]:u16le each
 
 const uint8_t PKT_TRIGGER_ON      = 0x01;
 const uint8_t PKT_TRIGGER_OFF     = 0x02;
@@ -89,6 +104,8 @@ const uint8_t PKT_SRV_SET         = 0x10;
 const uint8_t PKT_SRV_SETTINGS    = 0x11;
 const uint8_t PKT_SRV_RECOIL_JERK = 0x12;
 const uint8_t PKT_SMOKE_HEAT      = 0x20;
+const uint8_t PKT_CAPTURE_CTRL    = 0x30;
+const uint8_t PKT_CAPTURE_FRAME   = 0x31;
 
 // Universal protocol packets (high values, used across all modules)
 const uint8_t PKT_INIT            = 0xF0;
@@ -163,6 +180,22 @@ ServoMotionState servo_motion[] = {
 
 uint32_t next_status_ms = 0;
 
+// PWM capture state
+struct CaptureInput {
+  PIO pio;            // nullptr when no state machine was free
+  uint sm;
+  uint16_t pulse_us;  // Last measured high time
+};
+
+CaptureInput capture_inputs[CAPTURE_INPUTS];
+int capture_program_offset[2] = { -1, -1 }; // Per PIO block, -1 = not loaded
+uint16_t capture_program_instructions[7];
+pio_program_t capture_program;
+bool capture_enabled = false;
+uint8_t capture_fresh_mask = 0;
+uint32_t capture_newest_us = 0;
+uint32_t capture_last_frame_us = 0;
+
 // Watchdog state
 const uint32_t WATCHDOG_TIMEOUT_MS = 90000; // 90 seconds
 uint32_t last_keepalive_ms = 0;
@@ -267,6 +300,109 @@ void sendInitReady() {
   sendPacket(PKT_INIT_READY, (const uint8_t*)module_name, strlen(module_name));
 }
 
+// ---------------------- PWM Capture ----------------------
+// Each input runs the same PIO program: wait for a rising edge, count down
+// x once per 2 cycles while the pin stays high, then push the loop count.
+// At CAPTURE_TICK_HZ one loop is one microsecond, independent of USB or
+// loop() latency; loop() only drains the FIFOs.
+
+void buildCaptureProgram() {
+  capture_program_instructions[0] = pio_encode_wait_pin(false, 0);         // wait 0 pin 0
+  capture_program_instructions[1] = pio_encode_wait_pin(true, 0);          // wait 1 pin 0
+  capture_program_instructions[2] = pio_encode_mov_not(pio_x, pio_null);   // x = 0xFFFFFFFF
+  capture_program_instructions[3] = pio_encode_jmp_x_dec(4);               // x--
+  capture_program_instructions[4] = pio_encode_jmp_pin(3);                 // loop while high
+  capture_program_instructions[5] = pio_encode_mov_not(pio_isr, pio_x);    // isr = loops counted
+  capture_program_instructions[6] = pio_encode_push(false, false);         // push noblock
+  capture_program.instructions = capture_program_instructions;
+  capture_program.length = 7;
+  capture_program.origin = -1;
+}
+
+// Claim a state machine on either PIO block (loading the program there first)
+bool startCaptureInput(CaptureInput* input, uint8_t pin) {
+  PIO blocks[2] = { pio0, pio1 };
+  for (int b = 0; b < 2; b++) {
+    PIO pio = blocks[b];
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) continue;
+    if (capture_program_offset[b] < 0) {
+      if (!pio_can_add_program(pio, &capture_program)) {
+        pio_sm_unclaim(pio, (uint)sm);
+        continue;
+      }
+      capture_program_offset[b] = (int)pio_add_program(pio, &capture_program);
+    }
+
+    uint offset = (uint)capture_program_offset[b];
+    pio_sm_config c = pio_get_default_sm_config();
+    sm_config_set_wrap(&c, offset, offset + capture_program.length - 1);
+    sm_config_set_in_pins(&c, pin);
+    sm_config_set_jmp_pin(&c, pin);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv(&c, (float)clock_get_hz(clk_sys) / (float)CAPTURE_TICK_HZ);
+    pio_sm_set_consecutive_pindirs(pio, (uint)sm, pin, 1, false);
+    pio_sm_init(pio, (uint)sm, offset, &c);
+    pio_sm_set_enabled(pio, (uint)sm, true);
+
+    input->pio = pio;
+    input->sm = (uint)sm;
+    return true;
+  }
+  return false;
+}
+
+void setupCapture() {
+  buildCaptureProgram();
+  for (size_t i = 0; i < CAPTURE_INPUTS; i++) {
+    pinMode(PIN_CAPTURE[i], INPUT_PULLDOWN); // Unplugged inputs read low, not noise
+    capture_inputs[i] = { nullptr, 0, 0 };
+    if (!startCaptureInput(&capture_inputs[i], PIN_CAPTURE[i])) {
+      Serial.print("WARN: No PIO state machine for capture input ");
+      Serial.println(i + 1);
+    }
+  }
+}
+
+// Drain the capture FIFOs; called every loop()
+void pollCapture() {
+  for (size_t i = 0; i < CAPTURE_INPUTS; i++) {
+    CaptureInput* input = &capture_inputs[i];
+    if (!input->pio) continue;
+    while (!pio_sm_is_rx_fifo_empty(input->pio, input->sm)) {
+      uint32_t loops = pio_sm_get(input->pio, input->sm);
+      if (loops > 0xFFFF) continue; // Stuck high, not a servo pulse
+      input->pulse_us = (uint16_t)loops;
+      capture_fresh_mask |= (uint8_t)(1u << i);
+      capture_newest_us = time_us_32();
+    }
+  }
+}
+
+// Send the inputs with new pulses. A host that stops reading must not stall
+// the loop, so the frame is dropped when the USB FIFO cannot take it.
+void sendCaptureFrame(uint32_t now_us) {
+  if (!capture_enabled || capture_fresh_mask == 0) return;
+  if (now_us - capture_last_frame_us < CAPTURE_FRAME_INTERVAL_US) return;
+  if (Serial.availableForWrite() < (int)COBS_BUFFER_SIZE + 1) return;
+
+  uint8_t payload[3 + 2 * CAPTURE_INPUTS];
+  size_t idx = 0;
+  uint32_t age_us = now_us - capture_newest_us;
+  if (age_us > 0xFFFF) age_us = 0xFFFF;
+  payload[idx++] = capture_fresh_mask;
+  payload[idx++] = (uint8_t)(age_us & 0xFF);
+  payload[idx++] = (uint8_t)(age_us >> 8);
+  for (size_t i = 0; i < CAPTURE_INPUTS; i++) {
+    payload[idx++] = (uint8_t)(capture_inputs[i].pulse_us & 0xFF);
+    payload[idx++] = (uint8_t)(capture_inputs[i].pulse_us >> 8);
+  }
+  sendPacket(PKT_CAPTURE_FRAME, payload, idx);
+
+  capture_fresh_mask = 0;
+  capture_last_frame_us = now_us;
+}
+
 // ---------------------- Watchdog Management ----------------------
 
 void watchdogReset() {
@@ -765,6 +901,13 @@ void processPacket(const uint8_t *payload, size_t len) {
       watchdogReset();
       break;
     }
+    case PKT_CAPTURE_CTRL: {
+      if (plen != 1) { Serial.println("ERROR: CAPTURE_CTRL len"); break; }
+      capture_enabled = body[0] != 0;
+      capture_fresh_mask = 0;
+      Serial.println(capture_enabled ? "INFO: Pulse capture streaming" : "INFO: Pulse capture stopped");
+      break;
+    }
     default:
       Serial.print("ERROR: Unknown pkt type ");
       Serial.println(type, HEX);
@@ -913,6 +1056,9 @@ void setup() {
   servo_motion[0].last_update_ms = now;
   servo_motion[1].last_update_ms = now;
   servo_motion[2].last_update_ms = now;
+
+  // PWM capture takes the PIO state machines the servos left free
+  setupCapture();
   
   Serial.println("GunFX Pico Controller Ready (binary protocol, COBS framed, delimiter 0x00)");
   Serial.println("Packets: type,len,payload...,crc8(0x07)");
@@ -945,6 +1091,10 @@ void loop() {
     }
   }
   
+  // Stream measured input pulses
+  pollCapture();
+  sendCaptureFrame(time_us_32());
+
   // Update hardware states
   updateMuzzleFlash();
   updateSmokeFan();
@@ -0,0 +1,38 @@
+#ifndef ALLOC_CHECK_H
+#define ALLOC_CHECK_H
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/**
+ * @file alloc_check.h
+ * @brief Counting allocator for verifying allocation-free hot loops
+ * 
+ * Built with `make ALLOC_CHECK=1`, alloc_check.c interposes malloc/calloc/
+ * realloc/free (including calls made from shared libraries such as libgpiod)
+ * and counts allocations on threads that have opted in. Without ALLOC_CHECK
+ * the functions below compile to no-ops.
+ */
+
+#ifdef ALLOC_CHECK
+
+/**
+ * Start or stop counting heap allocations made by the calling thread
+ * @param enable true to count, false to stop counting
+ */
+void alloc_check_thread_enable(bool enable);
+
+/**
+ * Get the number of heap allocations counted on the calling thread
+ * @return Allocations (malloc, calloc, realloc, aligned variants) since counting was enabled
+ */
+uint64_t alloc_check_thread_count(void);
+
+#else
+
+static inline void alloc_check_thread_enable(bool enable) { (void)enable; }
+static inline uint64_t alloc_check_thread_count(void) { return 0; }
+
+#endif // ALLOC_CHECK
+
+#endif // ALLOC_CHECK_H
@@ -2,6 +2,7 @@
 #define AUDIO_PLAYER_H
 
 #include <stdbool.h>
+#include <stdint.h>
 
 // Forward declarations
 typedef struct AudioMixer AudioMixer;
@@ -11,17 +12,61 @@ typedef struct Sound Sound;
 typedef struct {
     bool loop;              // Loop playback
     float volume;           // Volume level (0.0 to 1.0)
+    int fade_in_ms;         // Fade-in ramp (0 = hard start, PLAYBACK_FADE_IN_ENVELOPE = channel envelope)
 } PlaybackOptions;
 
+#define PLAYBACK_FADE_IN_ENVELOPE (-1)
+
 // Default playback options
-#define PLAYBACK_DEFAULTS (PlaybackOptions){ .loop = false, .volume = 1.0f }
+#define PLAYBACK_DEFAULTS (PlaybackOptions){ .loop = false, .volume = 1.0f, .fade_in_ms = PLAYBACK_FADE_IN_ENVELOPE }
 
 // Stop options with explicit values (C23 compatible)
 typedef enum {
     STOP_IMMEDIATE = 0,         // Stop immediately
-    STOP_AFTER_FINISH = 1       // Wait until current track finishes
+    STOP_AFTER_FINISH = 1,      // Wait until current track finishes
+    STOP_FADE_OUT = 2           // Ramp to silence over the channel's fade_out_ms (non-blocking)
 } StopMode;
 
+// Per-channel volume envelope, applied per sample by the audio thread
+typedef struct {
+    int fade_in_ms;         // Ramp from silence when a sound starts
+    int fade_out_ms;        // Ramp to silence on STOP_FADE_OUT
+    int volume_ramp_ms;     // Smoothing for audio_mixer_set_volume() changes
+    Sound *release_tail;    // Played once when a STOP_FADE_OUT fade completes (optional)
+} ChannelEnvelope;
+
+// Default envelope: hard starts/stops, no tail
+#define CHANNEL_ENVELOPE_DEFAULTS (ChannelEnvelope){ .fade_in_ms = 0, .fade_out_ms = 0, .volume_ramp_ms = 0, .release_tail = nullptr }
+
+// In-memory storage format for decoded sounds
+typedef enum {
+    SOUND_STORAGE_PCM = 0,      // 32-bit float PCM (no decode cost, largest)
+    SOUND_STORAGE_ADPCM = 1     // IMA-ADPCM, ~8x smaller, decoded per block in the audio callback
+} SoundStorage;
+
+// Options applied when a sound is loaded (and again on hot reload)
+typedef struct {
+    SoundStorage storage;   // In-memory format
+    bool normalize;         // Apply loudness normalisation gain
+    float target_lufs;      // Normalisation target (integrated loudness)
+} SoundLoadOptions;
+
+// Default load options
+#define SOUND_LOAD_DEFAULTS (SoundLoadOptions){ .storage = SOUND_STORAGE_PCM, .normalize = false, .target_lufs = -16.0f }
+
+// One entry of a scheduled sequence (see audio_mixer_play_sequence)
+typedef struct {
+    Sound *sound;               // Sound to play
+    int channel;                // Mixer channel (events on one channel hand over in start order)
+    int64_t start_frame_offset; // Start time in output frames after the sequence is submitted
+    int sound_start_ms;         // Position within the sound to start from
+    float gain;                 // Volume level (0.0 to 1.0)
+    int fade_in_ms;             // Fade-in; the previous event on the channel fades out across it
+    bool loop;                  // Loop playback
+} SequenceEvent;
+
+#define MAX_SEQUENCE_EVENTS 16
+
 // ============================================================================
 // SOUND API - For Loading Audio Files
 // ============================================================================
@@ -33,6 +78,23 @@ typedef enum {
  */
 Sound* sound_load(const char *filename);
 
+/**
+ * Create a new sound by loading from file with explicit load options
+ * With normalize set, loudness is analysed once and cached in a
+ * "<filename>.loudness" sidecar; the resulting gain scales the PCM as it is read.
+ * @param filename Path to audio file
+ * @param options Load options (or nullptr for defaults)
+ * @return Sound handle or nullptr on error
+ */
+Sound* sound_load_with_options(const char *filename, const SoundLoadOptions *options);
+
+/**
+ * Get the length of a sound
+ * @param sound Sound handle
+ * @return Length in milliseconds, or -1 on error
+ */
+int sound_get_length_ms(Sound *sound);
+
 /**
  * Destroy sound and free resources
  * @param sound Sound handle
@@ -57,7 +119,8 @@ AudioMixer* audio_mixer_create(int max_channels);
 void audio_mixer_destroy(AudioMixer *mixer);
 
 /**
- * Play a sound on a channel immediately, stopping any current track on that channel
+ * Play a sound on a channel immediately, replacing any current track on that channel
+ * (a track still playing is crossfaded out over the channel's fade_out_ms)
  * @param mixer Audio mixer handle
  * @param channel_id Channel number (0 to max_channels-1)
  * @param sound Sound handle
@@ -77,6 +140,38 @@ int audio_mixer_play(AudioMixer *mixer, int channel_id, Sound *sound, const Play
  */
 int audio_mixer_play_from(AudioMixer *mixer, int channel_id, Sound *sound, int start_ms, const PlaybackOptions *options);
 
+/**
+ * Schedule a timeline of sounds, executed sample-accurately by the audio thread
+ * Whatever a channel used by the sequence still plays fades out (over the
+ * channel's fade_out_ms, or else across its first event's fade-in) instead of
+ * being cut. On error nothing is scheduled and the channels are left as they
+ * were. Events on the same channel
+ * hand over in start order: the earlier sound fades out across the later one's
+ * fade-in and stops. The last event on a channel becomes that channel's current
+ * sound for stop/volume/remaining-time calls.
+ * @param mixer Audio mixer handle
+ * @param events Sequence events (any order)
+ * @param count Number of events (1 to MAX_SEQUENCE_EVENTS)
+ * @return 0 on success, -1 on error
+ */
+int audio_mixer_play_sequence(AudioMixer *mixer, const SequenceEvent *events, int count);
+
+/**
+ * Get time until a channel's current sound becomes audible
+ * @param mixer Audio mixer handle
+ * @param channel_id Channel number (0 to max_channels-1)
+ * @return milliseconds until start, 0 if already started, -1 if nothing is playing or scheduled
+ */
+int audio_mixer_get_channel_start_delay_ms(AudioMixer *mixer, int channel_id);
+
+/**
+ * Convert milliseconds to output frames (for SequenceEvent.start_frame_offset)
+ * @param mixer Audio mixer handle
+ * @param ms Duration in milliseconds
+ * @return Number of frames at the mixer's output sample rate
+ */
+int64_t audio_mixer_ms_to_frames(AudioMixer *mixer, int ms);
+
 /**
  * Start playback on a specific channel (channel must have a loaded track)
  * @param mixer Audio mixer handle
@@ -102,6 +197,16 @@ int audio_mixer_stop_channel(AudioMixer *mixer, int channel_id, StopMode mode);
  */
 int audio_mixer_stop_looping(AudioMixer *mixer, int channel_id);
 
+/**
+ * Configure the fade envelope and release tail of a channel
+ * Takes effect for sounds started after the call.
+ * @param mixer Audio mixer handle
+ * @param channel_id Channel number (0 to max_channels-1)
+ * @param envelope Envelope settings (or nullptr for defaults)
+ * @return 0 on success, -1 on error
+ */
+int audio_mixer_set_channel_envelope(AudioMixer *mixer, int channel_id, const ChannelEnvelope *envelope);
+
 /**
  * Set volume for a specific channel
  * @param mixer Audio mixer handle
@@ -111,6 +216,17 @@ int audio_mixer_stop_looping(AudioMixer *mixer, int channel_id);
  */
 int audio_mixer_set_volume(AudioMixer *mixer, int channel_id, float volume);
 
+/**
+ * Set the playback rate (pitch) of a channel. Channels play without the
+ * resampling stage until this is first called; call it once before starting
+ * playback so the sounds are created with pitch control.
+ * @param mixer Audio mixer handle
+ * @param channel_id Channel number (0 to max_channels-1)
+ * @param pitch Playback rate (1.0 = original, > 0)
+ * @return 0 on success, -1 on error
+ */
+int audio_mixer_set_pitch(AudioMixer *mixer, int channel_id, float pitch);
+
 /**
  * Check if mixer is currently playing
  * @param mixer Audio mixer handle
@@ -156,6 +272,7 @@ typedef enum {
     SOUND_GUN_RATE_8,
     SOUND_GUN_RATE_9,
     SOUND_GUN_RATE_10,
+    SOUND_GUN_RELEASE_TAIL,
     
     SOUND_ID_COUNT
 } SoundID;
@@ -184,6 +301,13 @@ void sound_manager_destroy(SoundManager *manager);
  */
 int sound_manager_load_sound(SoundManager *manager, SoundID id, const char *filename);
 
+/**
+ * Set the load options used by subsequent sound_manager_load_sound() calls
+ * @param manager SoundManager handle
+ * @param options Load options (or nullptr for defaults)
+ */
+void sound_manager_set_load_options(SoundManager *manager, const SoundLoadOptions *options);
+
 /**
  * Get a sound
  * @param manager SoundManager handle
@@ -192,4 +316,20 @@ int sound_manager_load_sound(SoundManager *manager, SoundID id, const char *file
  */
 Sound* sound_manager_get_sound(SoundManager *manager, SoundID id);
 
+/**
+ * Enable hot reload of loaded sound files
+ * Asset directories are watched with inotify; a changed file is decoded on a
+ * background thread and swapped in atomically. Playing voices finish their
+ * current pass on the old audio and pick up the new one on the next loop/play.
+ * @param manager SoundManager handle
+ * @return 0 on success, -1 on error
+ */
+int sound_manager_enable_hot_reload(SoundManager *manager);
+
+/**
+ * Stop watching sound files for changes
+ * @param manager SoundManager handle
+ */
+void sound_manager_disable_hot_reload(SoundManager *manager);
+
 #endif // AUDIO_PLAYER_H
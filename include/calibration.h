@@ -0,0 +1,93 @@
+#ifndef CALIBRATION_H
+#define CALIBRATION_H
+
+#include "rc_receiver.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Forward declarations
+typedef struct ScaleFXConfig ScaleFXConfig;
+
+/**
+ * @file calibration.h
+ * @brief Per-channel input calibration profiles and precomputed mapping tables
+ *
+ * `sfxhub --calibrate` records min, max and centre for every configured input
+ * from live monitor averages and writes a profile. The profile is loaded at
+ * startup; servo mappings are then compiled into per-channel lookup tables
+ * that use the learned endpoints and centre instead of input_min_us/input_max_us,
+ * and switch / mux decoders space their levels over the learned endpoints.
+ */
+
+#define CALIBRATION_MAX_CHANNELS RC_RECEIVER_MAX_CHANNELS  // Highest input channel
+#define CALIBRATION_MIN_TRAVEL_US 200    // Smaller min-max spans are not saved
+
+// Input range covered by mapping tables (the PWM pulse sanity range)
+#define INPUT_MAP_MIN_US 500
+#define INPUT_MAP_MAX_US 3000
+
+// Learned travel of one input channel
+typedef struct {
+    int min_us;
+    int center_us;
+    int max_us;
+} ChannelCalibration;
+
+// Input pulse width -> output pulse width, one entry per microsecond
+typedef struct {
+    int center_in_us;                    // Input treated as neutral
+    int16_t out_us[INPUT_MAP_MAX_US - INPUT_MAP_MIN_US + 1];
+} InputMap;
+
+/**
+ * Load a calibration profile. Replaces any profile loaded before.
+ * @param path Profile written by calibration_run()
+ * @return 0 on success, -1 if the file is missing or invalid (no profile active)
+ */
+int calibration_load(const char *path);
+
+/**
+ * Get the loaded calibration of an input channel
+ * @param channel Input channel (1-CALIBRATION_MAX_CHANNELS)
+ * @param cal Out parameter for the calibration
+ * @return true if the channel is calibrated, false otherwise
+ */
+bool calibration_get(int channel, ChannelCalibration *cal);
+
+/**
+ * Build a mapping table for an input channel. Uses the channel's calibration
+ * (piecewise linear through the learned centre) when one is loaded, otherwise
+ * maps in_min-in_max linearly. Inputs outside the range are clamped.
+ * @param map Table to fill
+ * @param channel Input channel (used to look up the calibration)
+ * @param in_min Configured input minimum (µs)
+ * @param in_max Configured input maximum (µs)
+ * @param out_min Output minimum (µs)
+ * @param out_max Output maximum (µs)
+ */
+void input_map_build(InputMap *map, int channel, int in_min, int in_max, int out_min, int out_max);
+
+/**
+ * Map an input pulse width through a table built by input_map_build()
+ * @param map Mapping table
+ * @param input_us Input pulse width (µs)
+ * @return Output pulse width (µs)
+ */
+static inline int input_map_lookup(const InputMap *map, int input_us) {
+    if (input_us < INPUT_MAP_MIN_US) input_us = INPUT_MAP_MIN_US;
+    if (input_us > INPUT_MAP_MAX_US) input_us = INPUT_MAP_MAX_US;
+    return map->out_us[input_us - INPUT_MAP_MIN_US];
+}
+
+/**
+ * Interactive learning mode: monitor every configured input, track its
+ * min/max while the user moves sticks and switches, take the centre when
+ * Enter is pressed and write the profile. Call after input_init().
+ * @param config Loaded configuration (selects the channels)
+ * @param path Profile file to write
+ * @param running Cleared by the signal handler to abort without saving
+ * @return 0 if a profile was written, -1 on error or abort
+ */
+int calibration_run(const ScaleFXConfig *config, const char *path, volatile bool *running);
+
+#endif // CALIBRATION_H
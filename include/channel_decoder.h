@@ -0,0 +1,92 @@
+#ifndef CHANNEL_DECODER_H
+#define CHANNEL_DECODER_H
+
+#include <stdbool.h>
+
+/**
+ * @file channel_decoder.h
+ * @brief Multi-position switch and multiplexed channel decoding
+ *
+ * Splits one input channel into virtual channels: a 2-6 position switch
+ * (one output carrying the position) or a bit-packed channel carrying up to
+ * four binary switches (one output per switch). The input range is divided
+ * into equally spaced levels; a new level must be entered past the level
+ * boundary plus a hysteresis margin and hold for a number of pulses before
+ * it is accepted. Outputs are ordinary pulse widths (1000-2000 µs), so FX
+ * modules use them with their usual thresholds.
+ */
+
+#define CHANNEL_DECODER_MAX_POSITIONS 6
+#define CHANNEL_DECODER_MAX_BITS 4
+#define CHANNEL_DECODER_MAX_OUTPUTS CHANNEL_DECODER_MAX_BITS
+
+// Virtual channel numbers used for decoder outputs (above all physical channels)
+#define VIRTUAL_CHANNEL_MIN 21
+#define VIRTUAL_CHANNEL_MAX 40
+#define INPUT_MAX_DECODERS 8
+
+// Output pulse widths
+#define CHANNEL_DECODER_OUTPUT_MIN_US 1000
+#define CHANNEL_DECODER_OUTPUT_MAX_US 2000
+
+// Decoder types
+typedef enum {
+    CHANNEL_DECODER_SWITCH = 0,   // Multi-position switch, one output
+    CHANNEL_DECODER_MUX           // Bit-packed binary switches, one output per bit
+} ChannelDecoderType;
+
+// Decoder state (exposed so callers can embed it; use the functions below)
+typedef struct ChannelDecoder {
+    ChannelDecoderType type;
+    int levels;                   // Positions, or 2^bits for mux
+    int outputs;                  // 1 for switch, bits for mux
+    int in_min_us;                // Input width of level 0
+    int in_max_us;                // Input width of the last level
+    int hysteresis_us;
+    int debounce_pulses;
+    int level;                    // Accepted level, -1 until the first one settles
+    int pending_level;            // Candidate level being debounced
+    int pending_count;
+} ChannelDecoder;
+
+/**
+ * Parse a decoder type name
+ * @param name "switch" or "mux"
+ * @param type Out parameter
+ * @return 0 on success, -1 if unknown
+ */
+int channel_decoder_type_from_string(const char *name, ChannelDecoderType *type);
+
+/**
+ * Initialize a decoder
+ * @param dec Decoder state
+ * @param type Switch or mux
+ * @param size Positions (2-CHANNEL_DECODER_MAX_POSITIONS) or bits (1-CHANNEL_DECODER_MAX_BITS)
+ * @param in_min_us Input width of the lowest level (µs)
+ * @param in_max_us Input width of the highest level (µs)
+ * @param hysteresis_us Margin past a level boundary before the level changes
+ * @param debounce_pulses Consecutive pulses a new level must hold (>= 1)
+ * @return 0 on success, -1 on invalid parameters
+ */
+int channel_decoder_init(ChannelDecoder *dec, ChannelDecoderType type, int size,
+                         int in_min_us, int in_max_us, int hysteresis_us, int debounce_pulses);
+
+/**
+ * Feed one input pulse
+ * @param dec Decoder state
+ * @param pulse_us Input pulse width (µs)
+ * @return true if a level has been accepted (outputs are valid), false otherwise
+ */
+bool channel_decoder_feed(ChannelDecoder *dec, int pulse_us);
+
+/**
+ * Get an output pulse width for the accepted level. A switch output spreads
+ * the positions evenly over 1000-2000 µs; a mux output is 2000 µs when its
+ * bit is set and 1000 µs otherwise (output 0 = least significant bit).
+ * @param dec Decoder state
+ * @param output Output index (0 to outputs-1)
+ * @return Pulse width in µs
+ */
+int channel_decoder_output_us(const ChannelDecoder *dec, int output);
+
+#endif // CHANNEL_DECODER_H
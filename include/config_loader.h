@@ -13,6 +13,29 @@ typedef struct RateOfFireConfig {
     char *sound_file;
 } RateOfFireConfig;
 
+// Input filter chain configuration (per input channel, all stages optional)
+typedef struct InputFilterConfig {
+    int glitch_us;             // Reject single-pulse jumps larger than this (0=off)
+    int median_samples;        // Median of last N pulses (0=off, max 9)
+    float ema_alpha;           // One-pole IIR weight 0-1 (0=off)
+    int rate_limit_us_per_s;   // Maximum slew in µs/second (0=off)
+    int avg_window_pulses;     // Averaging window in pulses (default: 10; duration follows the frame rate)
+    int avg_window_ms;         // Deprecated: converted to pulses at 50 Hz when avg_window_pulses is unset
+} InputFilterConfig;
+
+// Input failsafe configuration (applies to all inputs of a module)
+typedef struct FailsafeConfig {
+    int timeout_ms;            // No valid pulse for this long => failsafe (default: 500)
+    char *action;              // "hold", "neutral" or "stop" (default: gun stop, engine hold)
+} FailsafeConfig;
+
+// Reaction to an input in failsafe
+typedef enum {
+    FAILSAFE_HOLD = 0,         // Keep the last commanded state
+    FAILSAFE_NEUTRAL,          // Act as if the input were at neutral (centre / off)
+    FAILSAFE_STOP              // Stop the effect (cease fire, shut down)
+} FailsafeAction;
+
 // Servo configuration with defaults
 typedef struct ServoConfig {
     int servo_id;               // Pico servo ID (1, 2, or 3)
@@ -26,17 +49,20 @@ typedef struct ServoConfig {
     float max_decel_us_per_sec2;// Default: 8000.0
     int recoil_jerk_us;         // Recoil jerk offset per shot (optional, 0=disabled)
     int recoil_jerk_variance_us;// Random variance for recoil jerk (optional)
+    InputFilterConfig filter;   // Input filter (optional)
 } ServoConfig;
 
 // Engine Toggle configuration
 typedef struct EngineToggleConfig {
     int input_channel;         // Input channel 1-10
     int threshold_us;          // Default: 1500
+    InputFilterConfig filter;  // Input filter (optional)
 } EngineToggleConfig;
 
 // Gun Trigger configuration
 typedef struct TriggerConfig {
     int input_channel;         // Input channel 1-10
+    InputFilterConfig filter;  // Input filter (optional)
 } TriggerConfig;// Engine Sounds Transitions configuration
 typedef struct EngineSoundsTransitionsConfig {
     int starting_offset_ms;    // Default: 60000 (60 seconds)
@@ -51,6 +77,16 @@ typedef struct EngineSoundsConfig {
     EngineSoundsTransitionsConfig transitions;
 } EngineSoundsConfig;
 
+// Rotor tachometer configuration (engine pitch follows rotor speed)
+typedef struct RotorTachConfig {
+    int input_channel;         // GPIO input channel 1-10 (0 = disabled); always a physical pin
+    int pulses_per_rev;        // Sensor pulses per rotor revolution (default: 1)
+    int nominal_rpm;           // Rotor RPM at which the running sound plays at its recorded pitch
+    float min_pitch;           // Default: 0.5
+    float max_pitch;           // Default: 1.5
+    int window_ms;             // Frequency averaging window (default: 250)
+} RotorTachConfig;
+
 // Engine type enumeration
 typedef enum {
     ENGINE_TYPE_TURBINE = 0,
@@ -64,6 +100,8 @@ typedef struct EngineFXConfig {
     char *type;               // Engine type: "turbine", "radial", "diesel" (default: turbine)
     EngineToggleConfig engine_toggle;
     EngineSoundsConfig sounds;
+    FailsafeConfig failsafe;
+    RotorTachConfig rotor_tach;
 } EngineFXConfig;
 
 // Smoke configuration
@@ -71,8 +109,22 @@ typedef struct SmokeConfig {
     int heater_toggle_channel; // Input channel 1-10
     int heater_pwm_threshold_us; // Default: 1500
     int fan_off_delay_ms;        // Default: 2000
+    InputFilterConfig filter;    // Heater toggle input filter (optional)
 } SmokeConfig;
 
+// Gun sound envelope configuration
+typedef struct SoundEnvelopeConfig {
+    int fade_in_ms;            // Default: 5 (0 = hard start)
+    int fade_out_ms;           // Default: 40 (trigger release; 0 = hard stop)
+    int volume_ramp_ms;        // Default: 20 (0 = no smoothing)
+    char *release_tail;        // Spin-down sound played after the fade-out (optional)
+    
+    // Values as given in the YAML (nullptr = not set), resolved into the fields above
+    int *fade_in_ms_set;
+    int *fade_out_ms_set;
+    int *volume_ramp_ms_set;
+} SoundEnvelopeConfig;
+
 // Turret Control configuration
 typedef struct TurretControlConfig {
     ServoConfig pitch;
@@ -84,12 +136,61 @@ typedef struct GunFXConfig {
     TriggerConfig trigger;
     SmokeConfig smoke;
     TurretControlConfig turret_control;
+    SoundEnvelopeConfig envelope;
+    FailsafeConfig failsafe;
     RateOfFireConfig *rates;
     int rate_count;
 } GunFXConfig;
 
+// Audio asset configuration
+typedef struct AudioConfig {
+    char *asset_storage;      // In-memory sound format: "pcm" or "adpcm" (default: pcm)
+    bool normalize;           // Loudness-normalise sounds at load (default: false)
+    float target_lufs;        // Normalisation target loudness (default: -16.0)
+} AudioConfig;
+
+// Channel decoder: one input channel split into virtual channels
+typedef struct ChannelDecoderConfig {
+    int input_channel;        // Input channel carrying the switch / mux signal
+    char *type;               // "switch" (multi-position) or "mux" (bit-packed binary switches)
+    int positions;            // switch: 2-6 positions (default: 3)
+    int bits;                 // mux: 1-4 binary switches (default: 2)
+    int output_channel;       // First virtual channel (21-40); mux uses one per bit
+    int hysteresis_us;        // Margin past a level boundary before switching (default: 20)
+    int debounce_pulses;      // Pulses a new level must hold (default: 3)
+} ChannelDecoderConfig;
+
+// Input source configuration
+typedef struct InputConfig {
+    char *source;             // "pwm" (GPIO inputs, default), "ppm", "sbus", "ibus" or "crsf"
+    char *device;             // Serial receiver UART, e.g. "/dev/ttyAMA0" (serial sources only)
+    int ppm_channel;          // Input channel (1-10) wired to the PPM signal (default: 1)
+    char *calibration;        // Calibration profile (default: <config file>.calibration)
+    ChannelDecoderConfig *decoders;  // Switch / mux decoders (optional)
+    int decoder_count;
+} InputConfig;
+
+// Real-time settings for one thread role
+typedef struct RealtimeThreadConfig {
+    char *policy;             // "fifo", "rr" or "other" (default: other)
+    int priority;             // 1-99 for fifo / rr
+    char *cpus;               // CPU affinity list, e.g. "3", "2,3" or "0-1" (default: any CPU)
+} RealtimeThreadConfig;
+
+// Real-time scheduling configuration
+typedef struct RealtimeConfig {
+    bool lock_memory;         // mlockall on first touch, RT thread stacks prefaulted (default: false)
+    RealtimeThreadConfig input;   // PWM monitoring / serial receiver threads
+    RealtimeThreadConfig audio;   // Audio device callback
+    RealtimeThreadConfig engine;  // Engine FX processing thread
+    RealtimeThreadConfig gun;     // Gun FX processing thread
+} RealtimeConfig;
+
 // Complete ScaleFX configuration
 typedef struct ScaleFXConfig {
+    AudioConfig audio;
+    InputConfig inputs;
+    RealtimeConfig realtime;
     EngineFXConfig engine;
     GunFXConfig gun;
 } ScaleFXConfig;
@@ -114,6 +215,22 @@ int config_validate(const ScaleFXConfig *config);
  */
 void config_print(const ScaleFXConfig *config);
 
+/**
+ * Count the PWM monitors the configuration creates (FX inputs, PPM decoder,
+ * channel decoders and their outputs, rotor tachometer)
+ * @param config Validated configuration
+ * @return Number of monitors (sizes the GPIO monitor registry)
+ */
+int config_monitor_count(const ScaleFXConfig *config);
+
+/**
+ * Resolve a failsafe action from configuration
+ * @param config Failsafe configuration
+ * @param default_action Action used when none is configured
+ * @return Configured action
+ */
+FailsafeAction config_failsafe_action(const FailsafeConfig *config, FailsafeAction default_action);
+
 /**
  * Free configuration memory (uses cyaml_free)
  * @param config Configuration to free
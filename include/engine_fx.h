@@ -7,6 +7,7 @@
 typedef struct AudioMixer AudioMixer;
 typedef struct Sound Sound;
 typedef struct EngineFXConfig EngineFXConfig;
+typedef struct PWMHealth PWMHealth;
 
 // Engine states
 typedef enum {
@@ -77,5 +78,7 @@ bool engine_fx_is_transitioning(EngineFX *engine);
 // Getter functions for status display
 int engine_fx_get_toggle_pwm(EngineFX *engine);
 int engine_fx_get_toggle_pin(EngineFX *engine);
+bool engine_fx_get_toggle_health(EngineFX *engine, PWMHealth *health);
+float engine_fx_get_rotor_rpm(EngineFX *engine);   // -1 if no rotor tachometer
 
 #endif // ENGINE_FX_H
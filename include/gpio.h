@@ -2,20 +2,94 @@
 #define GPIO_H
 
 #include <stdbool.h>
+#include <stdint.h>
 #include <threads.h>
 
 // Forward declarations
 typedef struct PWMMonitor PWMMonitor;
+typedef struct ChannelDecoder ChannelDecoder;
 
 // PWM reading structure
 typedef struct {
     int pin;                // GPIO pin number
     int duration_us;        // Pulse duration in microseconds
+    int64_t timestamp_ns;   // Edge timestamp of the pulse end (CLOCK_MONOTONIC)
 } PWMReading;
 
-// Callback function type for PWM readings
+// Callback function type for PWM readings. Called on the thread that decoded
+// the pulse (monitoring thread, or the caller of pwm_monitor_inject_pulse())
+// after the monitor registry lock is released, so it may start, stop or
+// configure monitors. It must not stop the last running GPIO monitor (that
+// joins the monitoring thread). No callback of a monitor runs after
+// pwm_monitor_stop() has returned.
 typedef void (*PWMCallback)(PWMReading reading, void *user_data);
 
+// Default change needed in the averaged value before a monitor's event fd is signalled
+#define PWM_CHANGE_THRESHOLD_DEFAULT_US 5
+
+// Input signal health
+#define PWM_FAILSAFE_TIMEOUT_DEFAULT_MS 500
+
+typedef enum {
+    PWM_SIGNAL_NONE = 0,        // No valid pulse received yet
+    PWM_SIGNAL_OK,              // Valid pulses arriving
+    PWM_SIGNAL_FAILSAFE         // No valid pulse within the failsafe timeout
+} PWMSignalState;
+
+typedef struct PWMHealth {
+    PWMSignalState state;
+    float frame_rate_hz;        // Smoothed rate of valid pulses
+    int jitter_us;              // Smoothed deviation of the pulse period
+    uint32_t valid_pulses;      // Pulses inside the 500-3000 µs sanity range
+    uint32_t rejected_pulses;   // Pulses outside it
+    int ms_since_last_pulse;    // -1 if no valid pulse yet
+    int frame_period_us;        // Detected frame period (0 = not detected yet)
+} PWMHealth;
+
+// Frame period detection: median of recent pulse intervals inside the RC range
+// (500 Hz down to 20 Hz). Until detected, a 50 Hz frame is assumed.
+#define PWM_FRAME_PERIOD_MIN_US      2000
+#define PWM_FRAME_PERIOD_MAX_US      50000
+#define PWM_FRAME_PERIOD_DEFAULT_US  20000
+
+// Averaging window, sized in pulses so its duration follows the frame rate
+#define PWM_AVG_MAX_SAMPLES            64
+#define PWM_AVG_WINDOW_DEFAULT_PULSES  10
+
+// Per-channel input filter chain, applied in the monitoring thread at edge time.
+// Stages run in order: glitch rejection -> median -> EMA -> rate limit; 0 disables a stage.
+#define PWM_FILTER_MAX_MEDIAN 9
+typedef struct {
+    int glitch_us;              // Drop a single pulse jumping more than this from the last one
+    int median_samples;         // Median of the last N pulses (1-9, odd recommended)
+    float ema_alpha;            // One-pole IIR weight of the new pulse (0 < alpha < 1)
+    int rate_limit_us_per_s;    // Maximum output slew in µs per second
+    int avg_window_pulses;      // Pulses averaged by pwm_monitor_get_average (1-64, default 10)
+} PWMFilter;
+
+#define PWM_FILTER_DEFAULTS ((PWMFilter){ .avg_window_pulses = PWM_AVG_WINDOW_DEFAULT_PULSES })
+
+// PPM sum-signal decoding: up to 12 channels per frame, frames separated by a
+// sync gap of at least 3 ms (channel slots are 0.7-2.2 ms)
+#define PPM_MAX_CHANNELS 12
+#define PPM_MIN_CHANNELS 4
+#define PPM_SYNC_MIN_US  3000
+
+// Frequency / tachometer input: rising-edge rate over a sliding time window
+#define TACH_MIN_HZ                1      // Slower edge rates read as stopped
+#define TACH_MAX_HZ                500    // Edges closer than half this period are rejected as bounce
+#define TACH_WINDOW_DEFAULT_MS     250
+#define TACH_WINDOW_MAX_MS         500    // Edge ring holds a full window at TACH_MAX_HZ
+
+// Tachometer reading
+typedef struct {
+    float frequency_hz;         // Edge rate over the window (0 = stopped / not yet measured)
+    float rpm;                  // frequency_hz * 60 / pulses_per_rev
+    int64_t last_edge_ns;       // CLOCK_MONOTONIC timestamp of the newest edge (0 = none)
+    uint32_t edges;             // Edges accepted since start
+    uint32_t rejected;          // Edges rejected as bounce
+} TachReading;
+
 // Input channel range (1-10 maps to fixed GPIO pins on PCB)
 #define INPUT_CHANNEL_MIN 1
 #define INPUT_CHANNEL_MAX 10
@@ -56,11 +130,28 @@ bool is_valid_channel(int channel);
 // GPIO INITIALIZATION API
 // ============================================================================
 
+// GPIO chip used when none is given (Raspberry Pi header GPIOs)
+#define GPIO_DEFAULT_CHIP "/dev/gpiochip0"
+
+// Monitor registry slots when gpio_set_monitor_capacity() is not called
+#define GPIO_MONITOR_CAPACITY_DEFAULT 16
+
+/**
+ * Size the PWM monitor registry. Monitors (GPIO, PPM, tachometer and virtual)
+ * are kept in one contiguous block of this many slots; creating more still
+ * works but adds another block. Must be called before gpio_init().
+ * @param monitors Expected number of monitors (>= 1)
+ * @return 0 on success, -1 if invalid or GPIO is already initialized
+ */
+int gpio_set_monitor_capacity(int monitors);
+
 /**
  * Initialize GPIO subsystem
+ * @param chip_path GPIO chip device, e.g. a gpio-sim chip for hardware-free
+ *                  testing (nullptr = GPIO_DEFAULT_CHIP)
  * @return 0 on success, -1 on error
  */
-int gpio_init(void);
+int gpio_init(const char *chip_path);
 
 /**
  * Cleanup GPIO subsystem
@@ -121,6 +212,109 @@ PWMMonitor* pwm_monitor_create(int pin, PWMCallback callback, void *user_data);
  */
 PWMMonitor* pwm_monitor_create_with_name(int pin, const char *feature_name, PWMCallback callback, void *user_data);
 
+/**
+ * Create a virtual PWM monitor with no GPIO line. Pulses come from another
+ * input backend (serial receiver, PPM decoder, replay) through
+ * pwm_monitor_inject_pulse(), and then go through the same filtering,
+ * averaging, health and notification path as GPIO edges.
+ * @param feature_name Name of the feature for logging (can be nullptr)
+ * @param callback Callback function called for each pulse (optional, can be nullptr)
+ * @param user_data User data passed to callback
+ * @return PWMMonitor handle (pin reported as -1), or nullptr on error
+ */
+PWMMonitor* pwm_monitor_create_virtual(const char *feature_name, PWMCallback callback, void *user_data);
+
+/**
+ * Feed one decoded pulse into a started virtual monitor (ignored for GPIO monitors)
+ * @param monitor Virtual PWM monitor handle
+ * @param duration_us Pulse width / channel value in microseconds
+ * @param timestamp_ns CLOCK_MONOTONIC timestamp of the pulse in nanoseconds
+ */
+void pwm_monitor_inject_pulse(PWMMonitor *monitor, int duration_us, int64_t timestamp_ns);
+
+/**
+ * Create a PPM (CPPM sum-signal) decoder on one GPIO. The decoder splits each
+ * frame into up to PPM_MAX_CHANNELS channels and publishes them through the
+ * virtual monitors attached with pwm_monitor_ppm_attach(); its own health
+ * reports the PPM frame rate. Start it like any other monitor.
+ * @param pin GPIO pin carrying the PPM signal (either polarity)
+ * @param feature_name Name for logging (can be nullptr)
+ * @return PWMMonitor handle or nullptr on error
+ */
+PWMMonitor* pwm_monitor_create_ppm(int pin, const char *feature_name);
+
+/**
+ * Publish a PPM channel to a virtual monitor
+ * @param ppm Decoder from pwm_monitor_create_ppm()
+ * @param channel PPM channel (1-PPM_MAX_CHANNELS)
+ * @param output Virtual monitor from pwm_monitor_create_virtual() (nullptr to detach)
+ * @return 0 on success, -1 on invalid decoder or channel
+ */
+int pwm_monitor_ppm_attach(PWMMonitor *ppm, int channel, PWMMonitor *output);
+
+/**
+ * Detach a virtual monitor from whichever PPM channel it is attached to
+ * @param ppm Decoder from pwm_monitor_create_ppm()
+ * @param output Monitor to detach
+ */
+void pwm_monitor_ppm_detach(PWMMonitor *ppm, PWMMonitor *output);
+
+/**
+ * Create a frequency / tachometer monitor on one GPIO (hall or optical rotor
+ * sensor). Only rising edges are requested; the edge rate is measured over a
+ * sliding window of window_ms (at least two edges, so 1 Hz inputs still read
+ * after one period) and published lock-free for pwm_monitor_get_tach().
+ * Start, stop and destroy it like any other monitor.
+ * @param pin GPIO pin carrying the sensor signal
+ * @param feature_name Name for logging (can be nullptr)
+ * @param pulses_per_rev Sensor pulses per revolution (>= 1)
+ * @param window_ms Averaging window (1-TACH_WINDOW_MAX_MS, 0 = TACH_WINDOW_DEFAULT_MS)
+ * @return PWMMonitor handle or nullptr on error
+ */
+PWMMonitor* pwm_monitor_create_tach(int pin, const char *feature_name, int pulses_per_rev, int window_ms);
+
+/**
+ * Get the current reading of a tachometer monitor (lock-free). Without new
+ * edges the frequency decays as 1/elapsed, so a stopping rotor reads down to
+ * 0 instead of holding its last speed.
+ * @param monitor Monitor from pwm_monitor_create_tach()
+ * @param reading Out parameter
+ * @return true on success, false if not a tachometer monitor
+ */
+bool pwm_monitor_get_tach(PWMMonitor *monitor, TachReading *reading);
+
+/**
+ * Get the number of channels in the last accepted PPM frame
+ * @param ppm Decoder from pwm_monitor_create_ppm()
+ * @return Channel count, 0 if no frame decoded yet
+ */
+int pwm_monitor_ppm_channel_count(PWMMonitor *ppm);
+
+/**
+ * Run every accepted pulse of a monitor through a channel decoder and publish
+ * the decoded outputs through the virtual monitors attached with
+ * pwm_monitor_decoder_attach(). The monitor itself keeps reporting the raw input.
+ * @param monitor Source monitor (GPIO, PPM channel or receiver channel)
+ * @param decoder Initialized decoder, owned by the caller (nullptr to remove)
+ */
+void pwm_monitor_set_decoder(PWMMonitor *monitor, ChannelDecoder *decoder);
+
+/**
+ * Publish a decoder output to a virtual monitor
+ * @param monitor Source monitor with a decoder set
+ * @param output Decoder output index (0-CHANNEL_DECODER_MAX_OUTPUTS-1)
+ * @param target Virtual monitor from pwm_monitor_create_virtual()
+ * @return 0 on success, -1 on invalid monitor or output
+ */
+int pwm_monitor_decoder_attach(PWMMonitor *monitor, int output, PWMMonitor *target);
+
+/**
+ * Detach a virtual monitor from whichever decoder output it is attached to
+ * @param monitor Source monitor with a decoder set
+ * @param target Monitor to detach
+ */
+void pwm_monitor_decoder_detach(PWMMonitor *monitor, PWMMonitor *target);
+
 /**
  * Destroy PWM monitor and stop monitoring thread
  * @param monitor PWM monitor handle
@@ -151,6 +345,8 @@ bool pwm_monitor_get_reading(PWMMonitor *monitor, PWMReading *reading);
 
 /**
  * Wait for next PWM reading (blocking)
+ * Returns immediately if an unread reading is pending, otherwise blocks on the
+ * monitor's event fd until the averaged value changes.
  * @param monitor PWM monitor handle
  * @param reading Pointer to PWMReading structure to fill
  * @param timeout_ms Timeout in milliseconds (-1 for infinite)
@@ -158,6 +354,29 @@ bool pwm_monitor_get_reading(PWMMonitor *monitor, PWMReading *reading);
  */
 bool pwm_monitor_wait_reading(PWMMonitor *monitor, PWMReading *reading, int timeout_ms);
 
+/**
+ * Get the monitor's change event fd for use with poll()/epoll.
+ * Becomes readable when the averaged value moves more than the change
+ * threshold from the last signalled value; clear it with pwm_monitor_clear_event().
+ * Signal loss does not signal the fd, so consumers should still poll with a timeout.
+ * @param monitor PWM monitor handle
+ * @return File descriptor (owned by the monitor), or -1 if monitor is nullptr
+ */
+int pwm_monitor_get_event_fd(PWMMonitor *monitor);
+
+/**
+ * Clear a pending change event (non-blocking)
+ * @param monitor PWM monitor handle
+ */
+void pwm_monitor_clear_event(PWMMonitor *monitor);
+
+/**
+ * Set how far the averaged value must move before the event fd is signalled.
+ * @param monitor PWM monitor handle
+ * @param threshold_us Change in microseconds (0 = every pulse, default PWM_CHANGE_THRESHOLD_DEFAULT_US)
+ */
+void pwm_monitor_set_change_threshold(PWMMonitor *monitor, int threshold_us);
+
 /**
  * Check if PWM monitor is currently running
  * @param monitor PWM monitor handle
@@ -172,18 +391,121 @@ bool pwm_monitor_is_running(PWMMonitor *monitor);
 bool gpio_is_initialized(void);
 
 /**
- * Set averaging window for PWM readings used by average APIs.
+ * Set averaging window for PWM readings used by average APIs. The window holds
+ * a number of pulses, so it spans pulses x detected frame period: 200 ms for
+ * 10 pulses at 50 Hz, 30 ms at 333 Hz.
+ * @param monitor PWM monitor handle
+ * @param pulses Pulses in the window (1-PWM_AVG_MAX_SAMPLES, default PWM_AVG_WINDOW_DEFAULT_PULSES)
+ */
+void pwm_monitor_set_avg_window_pulses(PWMMonitor *monitor, int pulses);
+
+/**
+ * Set the input filter chain for a monitor. Resets filter state; safe to call
+ * while the monitor is running.
  * @param monitor PWM monitor handle
- * @param window_ms Averaging window in milliseconds (default 200ms)
+ * @param filter Filter settings (nullptr restores PWM_FILTER_DEFAULTS)
  */
-void pwm_monitor_set_avg_window_ms(PWMMonitor *monitor, int window_ms);
+void pwm_monitor_set_filter(PWMMonitor *monitor, const PWMFilter *filter);
 
 /**
  * Get average PWM duration over the monitor's configured window.
+ * Constant time: the monitoring thread maintains the window and publishes it
+ * through a seqlock, so this never blocks the reader or the edge path.
  * @param monitor PWM monitor handle
  * @param avg_us Out parameter for average in microseconds
  * @return true if average computed from at least 1 sample, false otherwise
  */
 bool pwm_monitor_get_average(PWMMonitor *monitor, int *avg_us);
 
+/**
+ * Same as pwm_monitor_get_average(), also returning the edge timestamp of the
+ * newest pulse in the window (used to measure end-to-end input latency)
+ * @param monitor PWM monitor handle
+ * @param avg_us Out parameter for average in microseconds
+ * @param newest_ns Out parameter for the newest pulse timestamp (CLOCK_MONOTONIC ns)
+ * @return true if average computed from at least 1 sample, false otherwise
+ */
+bool pwm_monitor_get_average_ts(PWMMonitor *monitor, int *avg_us, int64_t *newest_ns);
+
+/**
+ * Set how long a monitor may go without a valid pulse before it reports failsafe
+ * @param monitor PWM monitor handle
+ * @param timeout_ms Timeout in milliseconds (default PWM_FAILSAFE_TIMEOUT_DEFAULT_MS, minimum 50)
+ */
+void pwm_monitor_set_failsafe_timeout(PWMMonitor *monitor, int timeout_ms);
+
+/**
+ * Get signal health statistics (lock-free, safe from any thread)
+ * @param monitor PWM monitor handle
+ * @param health Out parameter for the statistics
+ * @return true on success, false if monitor or health is nullptr
+ */
+bool pwm_monitor_get_health(PWMMonitor *monitor, PWMHealth *health);
+
+/**
+ * Check whether a monitor has lost a signal it was receiving
+ * @param monitor PWM monitor handle
+ * @return true if in failsafe, false if the signal is OK or was never received
+ */
+bool pwm_monitor_in_failsafe(PWMMonitor *monitor);
+
+/**
+ * Get a display string for a signal state
+ * @param state Signal state
+ * @return Static string
+ */
+const char* pwm_signal_state_to_string(PWMSignalState state);
+
+// ============================================================================
+// EDGE TRACE RECORD / REPLAY API
+// ============================================================================
+
+// Edge trace files: an 8-byte magic followed by fixed 11-byte records holding the
+// gpiod edge timestamp (CLOCK_MONOTONIC ns), 16-bit line offset and edge type
+// (1 = rising), in host byte order. Version 1 traces (10-byte records with an
+// 8-bit line offset) are still replayed.
+#define GPIO_TRACE_MAGIC            "HFXEDGE2"
+#define GPIO_TRACE_MAGIC_V1         "HFXEDGE1"
+#define GPIO_TRACE_MAGIC_LEN        8
+#define GPIO_TRACE_RECORD_SIZE      11
+#define GPIO_TRACE_RECORD_SIZE_V1   10
+
+/**
+ * Replay PWM input edges from a recorded trace instead of the GPIO chip.
+ * Must be called before gpio_init(); no chip is opened, so GPIO outputs are
+ * unavailable. Edges go through the same decoding path as live input.
+ * @param path Trace file from gpio_trace_record_start() (nullptr = live input)
+ * @param realtime true to keep the recorded timing, false to run as fast as possible
+ * @param loop true to restart the trace when it ends
+ * @return 0 on success, -1 if GPIO is already initialized
+ */
+int gpio_trace_set_replay(const char *path, bool realtime, bool loop);
+
+/**
+ * Start recording every PWM input edge (timestamp, line, edge type) to a file
+ * @param path Output file path
+ * @return 0 on success, -1 on error
+ */
+int gpio_trace_record_start(const char *path);
+
+/**
+ * Stop recording and close the trace file (called by gpio_cleanup())
+ */
+void gpio_trace_record_stop(void);
+
+#ifdef GPIO_BENCH
+// ============================================================================
+// BENCHMARK HOOK (builds with -DGPIO_BENCH only)
+// ============================================================================
+
+// Called from the monitoring / replay thread as each edge enters decoding
+typedef void (*GPIOBenchEdgeHook)(int pin, uint64_t edge_ns, int64_t now_ns);
+
+/**
+ * Install the edge hook (nullptr to remove). Set before starting monitors.
+ * @param hook Hook function
+ */
+void gpio_bench_set_edge_hook(GPIOBenchEdgeHook hook);
+#endif
+
 #endif // GPIO_H
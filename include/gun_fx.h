@@ -7,6 +7,8 @@
 typedef struct AudioMixer AudioMixer;
 typedef struct Sound Sound;
 typedef struct GunFXConfig GunFXConfig;
+typedef struct PWMHealth PWMHealth;
+typedef struct SerialBusTxStats SerialBusTxStats;
 
 // Gun FX controller
 typedef struct GunFX GunFX;
@@ -75,6 +77,50 @@ int gun_fx_get_pitch_pin(GunFX *gun);
 int gun_fx_get_yaw_pwm(GunFX *gun);
 int gun_fx_get_yaw_pin(GunFX *gun);
 
+// Input signal health getters (false if the input is not configured)
+bool gun_fx_get_trigger_health(GunFX *gun, PWMHealth *health);
+bool gun_fx_get_heater_toggle_health(GunFX *gun, PWMHealth *health);
+bool gun_fx_get_pitch_health(GunFX *gun, PWMHealth *health);
+bool gun_fx_get_yaw_health(GunFX *gun, PWMHealth *health);
+bool gun_fx_in_failsafe(GunFX *gun);
+
+/**
+ * Get the Pico link's TX queue statistics
+ * @param gun GunFX handle
+ * @param stats Out parameter
+ * @return true if the Pico link is open, false otherwise
+ */
+bool gun_fx_get_link_stats(GunFX *gun, SerialBusTxStats *stats);
+
+// Last STATUS reported by the Pico (sent about once a second)
+typedef struct {
+    bool firing;
+    bool flash_active;
+    bool flash_fading;
+    bool heater_on;
+    bool fan_on;
+    bool fan_spindown;          // Fan running on after firing stopped
+    int fan_off_remaining_ms;
+    int servo_us[3];            // Current output of Pico servos 1-3
+    int rate_of_fire_rpm;
+    int age_ms;                 // Time since the STATUS was received
+} GunFXTelemetry;
+
+/**
+ * Get the latest Pico telemetry. Never blocks the link's reader thread.
+ * @param gun GunFX handle
+ * @param telemetry Out parameter
+ * @return true if a STATUS has been received, false otherwise
+ */
+bool gun_fx_get_telemetry(GunFX *gun, GunFXTelemetry *telemetry);
+
+/**
+ * Get the module name the Pico reported in INIT_READY
+ * @param gun GunFX handle
+ * @return Module name, or nullptr if the Pico has not answered yet
+ */
+const char* gun_fx_get_module_name(GunFX *gun);
+
 // Recoil jerk settings getters
 int gun_fx_get_pitch_recoil_jerk(GunFX *gun);
 int gun_fx_get_pitch_recoil_jerk_variance(GunFX *gun);
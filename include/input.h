@@ -0,0 +1,62 @@
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdbool.h>
+
+// Forward declarations
+typedef struct PWMMonitor PWMMonitor;
+typedef struct InputConfig InputConfig;
+
+/**
+ * @file input.h
+ * @brief Input source selection for FX modules
+ *
+ * FX modules ask for an input channel and get a PWMMonitor back, regardless of
+ * whether the channel is a GPIO PWM line, a slot of a PPM sum signal on one
+ * GPIO, or a channel of a serial receiver (SBUS / iBUS / CRSF).
+ * Call input_init() after gpio_init().
+ */
+
+/**
+ * Initialize the configured input source. For PPM this starts the decoder on
+ * the configured GPIO; for serial sources it opens the receiver and starts its
+ * reader thread.
+ * @param config Input configuration (nullptr = GPIO PWM)
+ * @return 0 on success, -1 on error
+ */
+int input_init(const InputConfig *config);
+
+/**
+ * Stop the PPM decoder / close the serial receiver (if any).
+ * Call after all FX modules are destroyed.
+ */
+void input_cleanup(void);
+
+/**
+ * Check whether all channels share one input (PPM or serial receiver)
+ * @return true for PPM / SBUS / iBUS / CRSF, false for GPIO PWM
+ */
+bool input_is_multiplexed(void);
+
+/**
+ * Get the GPIO pin backing an input channel
+ * @param channel Input channel number
+ * @return GPIO pin, or -1 for PPM / serial receiver channels and invalid channels
+ */
+int input_channel_pin(int channel);
+
+/**
+ * Create a monitor for an input channel (not started)
+ * @param channel Input channel number (1-10 for GPIO PWM, 1-12 for PPM, 1-16 for serial receivers)
+ * @param feature_name Feature name for logging
+ * @return PWMMonitor, or nullptr on error
+ */
+PWMMonitor* input_monitor_create(int channel, const char *feature_name);
+
+/**
+ * Stop, detach and destroy a monitor from input_monitor_create()
+ * @param monitor Monitor to destroy
+ */
+void input_monitor_destroy(PWMMonitor *monitor);
+
+#endif // INPUT_H
@@ -49,6 +49,9 @@ void logging_write(const char *level, const char *component, const char *fmt, ..
 #define LOG_AUDIO    "[AUDIO]  "
 #define LOG_SMOKE    "[SMOKE]  "
 #define LOG_GPIO     "[GPIO]   "
+#define LOG_INPUT    "[INPUT]  "
+#define LOG_CALIB    "[CALIB]  "
+#define LOG_RT       "[RT]     "
 #define LOG_LIGHTS   "[LIGHTS] "
 
 /* System component tag for logging infrastructure itself */
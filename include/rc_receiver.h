@@ -0,0 +1,130 @@
+#ifndef RC_RECEIVER_H
+#define RC_RECEIVER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Forward declarations
+typedef struct PWMMonitor PWMMonitor;
+
+/**
+ * @file rc_receiver.h
+ * @brief Serial RC receiver input backend (SBUS, FlySky iBUS, CRSF, Pico capture)
+ *
+ * Reads all receiver channels from one UART with one parser thread and
+ * publishes them through virtual PWMMonitors, so FX modules use the same
+ * averaging, filter, health and event-fd API as for GPIO PWM inputs.
+ * Channel values are converted to the usual 1000-2000 µs range.
+ *
+ * The "pico" source reads PWM pulses measured by the GunFX Pico's PIO state
+ * machines, streamed as capture packets over its USB serial link. The link is
+ * a shared serial bus (see serial_bus.h), so the same Pico can also run the
+ * GunFX outputs; capture packets are not decoded by the stream parser.
+ */
+
+#define RC_RECEIVER_MAX_CHANNELS 16
+#define RC_PICO_MAX_CHANNELS 8   // Pulse inputs carried by a Pico capture frame
+
+// Serial receiver protocols
+typedef enum {
+    RC_PROTOCOL_SBUS = 0,   // 100000 baud 8E2, inverted line (needs a hardware inverter on the Pi UART)
+    RC_PROTOCOL_IBUS,       // 115200 baud 8N1, FlySky iBUS servo output
+    RC_PROTOCOL_CRSF,       // 420000 baud 8N1, TBS Crossfire / ELRS
+    RC_PROTOCOL_PICO        // USB serial, COBS framed capture packets from the GunFX Pico
+} RCProtocol;
+
+// Receiver handle
+typedef struct RCReceiver RCReceiver;
+
+// Stream parser state (exposed so captures can be decoded without a device)
+typedef struct {
+    RCProtocol protocol;
+    uint8_t buf[64];
+    size_t len;
+    uint32_t frames;        // Valid channel frames decoded
+    uint32_t errors;        // Bytes discarded while resynchronising
+    uint32_t failsafe_frames;  // Frames flagged failsafe / frame lost by the receiver
+} RCParser;
+
+/**
+ * Parse a protocol name
+ * @param name "sbus", "ibus", "crsf" or "pico"
+ * @param protocol Out parameter
+ * @return 0 on success, -1 if unknown
+ */
+int rc_protocol_from_string(const char *name, RCProtocol *protocol);
+
+/**
+ * Get protocol display name
+ * @param protocol Protocol
+ * @return Static string
+ */
+const char* rc_protocol_to_string(RCProtocol protocol);
+
+/**
+ * Reset a stream parser
+ * @param parser Parser state
+ * @param protocol Protocol to decode
+ */
+void rc_parser_init(RCParser *parser, RCProtocol protocol);
+
+/**
+ * Discard partially received bytes (call after an inter-frame gap)
+ * @param parser Parser state
+ */
+void rc_parser_resync(RCParser *parser);
+
+/**
+ * Feed bytes to a parser. Calls on_frame for every valid channel frame that
+ * is not flagged failsafe by the receiver.
+ * @param parser Parser state
+ * @param data Received bytes
+ * @param len Number of bytes
+ * @param on_frame Called with channel values in µs (index 0 = channel 1)
+ * @param user_data Passed to on_frame
+ */
+void rc_parser_feed(RCParser *parser, const uint8_t *data, size_t len,
+                    void (*on_frame)(const int *channels_us, int count, void *user_data),
+                    void *user_data);
+
+/**
+ * Open a serial receiver (a pty path works for testing)
+ * @param device_path UART device, e.g. "/dev/ttyAMA0" (the Pico's ttyACM for RC_PROTOCOL_PICO)
+ * @param protocol Receiver protocol
+ * @return RCReceiver handle, or nullptr on error
+ */
+RCReceiver* rc_receiver_open(const char *device_path, RCProtocol protocol);
+
+/**
+ * Stop the reader thread and close the receiver. Attached monitors are not destroyed.
+ * @param rx RCReceiver handle
+ */
+void rc_receiver_close(RCReceiver *rx);
+
+/**
+ * Publish a receiver channel to a virtual PWM monitor
+ * @param rx RCReceiver handle
+ * @param channel Receiver channel (1-16)
+ * @param monitor Virtual monitor from pwm_monitor_create_virtual()
+ * @return 0 on success, -1 on invalid channel
+ */
+int rc_receiver_attach(RCReceiver *rx, int channel, PWMMonitor *monitor);
+
+/**
+ * Detach a monitor from whichever channel it is attached to
+ * @param rx RCReceiver handle
+ * @param monitor Monitor to detach
+ */
+void rc_receiver_detach(RCReceiver *rx, PWMMonitor *monitor);
+
+/**
+ * Start the reader thread. For RC_PROTOCOL_PICO this registers the capture
+ * packet handler and asks the Pico to start streaming capture frames
+ * (stopped again by rc_receiver_close()).
+ * @param rx RCReceiver handle
+ * @return 0 on success, -1 on failure
+ */
+int rc_receiver_start(RCReceiver *rx);
+
+#endif // RC_RECEIVER_H
@@ -0,0 +1,43 @@
+#ifndef RT_SCHED_H
+#define RT_SCHED_H
+
+// Forward declarations
+typedef struct RealtimeConfig RealtimeConfig;
+
+/**
+ * @file rt_sched.h
+ * @brief Real-time scheduling, CPU affinity and memory locking
+ *
+ * Latency-critical threads call rt_sched_apply() once when they start; the
+ * policy, priority and CPU set for their role come from the `realtime:`
+ * config section. Roles without settings keep default CFS scheduling.
+ */
+
+// Thread roles that can be given real-time settings
+typedef enum {
+    RT_ROLE_INPUT = 0,      // PWM monitoring / edge replay / serial receiver threads
+    RT_ROLE_AUDIO,          // miniaudio device callback
+    RT_ROLE_ENGINE,         // Engine FX processing thread
+    RT_ROLE_GUN,            // Gun FX processing thread
+    RT_ROLE_COUNT
+} RTRole;
+
+/**
+ * Store per-role settings and lock process memory if requested.
+ * Call once at startup, before any latency-critical thread is created.
+ * Missing privileges (CAP_SYS_NICE / CAP_IPC_LOCK or rlimits) only produce warnings.
+ * @param config Realtime configuration (nullptr = leave everything at defaults)
+ * @return 0 on success, -1 on invalid configuration
+ */
+int rt_sched_init(const RealtimeConfig *config);
+
+/**
+ * Apply the role's scheduling policy, priority and CPU affinity to the calling
+ * thread and name it. When memory is locked, a fixed block of the thread's
+ * stack is prefaulted (except for the audio role, applied from the device callback).
+ * @param role Thread role
+ * @param thread_name Thread name shown by top/ps (max 15 characters)
+ */
+void rt_sched_apply(RTRole role, const char *thread_name);
+
+#endif // RT_SCHED_H
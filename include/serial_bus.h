@@ -8,6 +8,47 @@
 // Forward declaration
 typedef struct SerialBus SerialBus;
 
+// Writes are queued in a TX ring and sent by a per-bus writer thread, which
+// batches everything queued within a short window into one write(). Callers
+// never block on the device: when the ring is full the write is rejected.
+//
+// Received packets are split, checked and dispatched by a per-bus reader
+// thread, started when the first packet handler is registered. Frames are
+// COBS-decoded in place in the RX ring where possible, and handlers get a
+// pointer into that buffer (valid only for the duration of the call).
+//
+// Opening a device that is already open returns the same bus (reference
+// counted), so several modules can share one link to a controller.
+
+#define SERIAL_BUS_RX_RING_SIZE 1024   // Received bytes buffered for framing (power of two)
+
+// TX queue statistics
+typedef struct SerialBusTxStats {
+    uint32_t packets_queued;    // Packets / writes accepted into the TX ring
+    uint32_t packets_dropped;   // Rejected because the ring was full (backpressure)
+    uint32_t batches;           // write() calls made by the writer thread
+    uint64_t bytes_written;
+    size_t depth_bytes;         // Bytes queued now
+    size_t max_depth_bytes;     // High-water mark
+} SerialBusTxStats;
+
+// RX statistics
+typedef struct SerialBusRxStats {
+    uint32_t packets;           // Valid packets passed to a handler
+    uint32_t unhandled;         // Valid packets of a type without a handler
+    uint32_t bad_frames;        // COBS, length or CRC errors
+    uint32_t overruns;          // Ring filled without a frame delimiter (bytes dropped)
+} SerialBusRxStats;
+
+/**
+ * Packet handler, called on the bus reader thread
+ * @param type Packet type
+ * @param payload Payload bytes (points into the RX buffer; valid during the call only)
+ * @param len Payload length
+ * @param user_data Pointer given to serial_bus_set_handler()
+ */
+typedef void (*SerialBusPacketHandler)(uint8_t type, const uint8_t *payload, size_t len, void *user_data);
+
 // Serial bus configuration
 typedef struct {
     const char *device_path;  // e.g., "/dev/ttyACM0" or "/dev/ttyUSB0"
@@ -16,24 +57,27 @@ typedef struct {
 } SerialBusConfig;
 
 /**
- * Open a serial bus connection
+ * Open a serial bus connection. If the device is already open, the existing
+ * bus is returned (its settings are kept) and must be closed once more.
  * @param config Serial bus configuration
  * @return SerialBus handle, or NULL on error
  */
 SerialBus* serial_bus_open(const SerialBusConfig *config);
 
 /**
- * Close serial bus connection
+ * Close serial bus connection. The device is closed with the last reference;
+ * data still queued is sent first (for a short time if the device is stalled).
+ * Remove your packet handlers before closing a shared bus.
  * @param bus SerialBus handle
  */
 void serial_bus_close(SerialBus *bus);
 
 /**
- * Write data to serial bus
+ * Queue data for the writer thread. Never blocks on the device.
  * @param bus SerialBus handle
  * @param data Data buffer to write
  * @param len Length of data in bytes
- * @return Number of bytes written, or -1 on error
+ * @return Number of bytes queued, or -1 on error or if the TX queue lacks space (nothing queued)
  */
 int serial_bus_write(SerialBus *bus, const void *data, size_t len);
 
@@ -55,16 +99,47 @@ int serial_bus_write_string(SerialBus *bus, const char *str);
 int serial_bus_write_command(SerialBus *bus, const char *format, ...);
 
 /**
- * Read data from serial bus
+ * Get TX queue statistics
+ * @param bus SerialBus handle
+ * @param stats Out parameter
+ * @return 0 on success, -1 on invalid arguments
+ */
+int serial_bus_get_tx_stats(SerialBus *bus, SerialBusTxStats *stats);
+
+/**
+ * Register the handler for one packet type, replacing any previous one. The
+ * first registration starts the reader thread. Once this returns with a NULL
+ * handler, the old handler is not running and will not be called again.
+ * Must not be called from a handler.
+ * @param bus SerialBus handle
+ * @param type Packet type
+ * @param handler Handler, or NULL to remove it
+ * @param user_data Passed to the handler
+ * @return 0 on success, -1 on error (reader thread could not be started)
+ */
+int serial_bus_set_handler(SerialBus *bus, uint8_t type, SerialBusPacketHandler handler, void *user_data);
+
+/**
+ * Get RX statistics
+ * @param bus SerialBus handle
+ * @param stats Out parameter
+ * @return 0 on success, -1 on invalid arguments
+ */
+int serial_bus_get_rx_stats(SerialBus *bus, SerialBusRxStats *stats);
+
+/**
+ * Read data from serial bus. Fails on a bus with packet handlers
+ * (the reader thread consumes the data).
  * @param bus SerialBus handle
  * @param buffer Buffer to read into
  * @param max_len Maximum number of bytes to read
- * @return Number of bytes read, 0 on timeout, -1 on error
+ * @return Number of bytes read, 0 on timeout, -1 on error or once a handler is set
  */
 int serial_bus_read(SerialBus *bus, void *buffer, size_t max_len);
 
 /**
- * Read a line from serial bus (until newline or buffer full)
+ * Read a line from serial bus (until newline or buffer full); fails like
+ * serial_bus_read() on a bus with packet handlers
  * @param bus SerialBus handle
  * @param buffer Buffer to read into
  * @param max_len Maximum number of bytes to read (including null terminator)
@@ -95,16 +170,17 @@ size_t serial_bus_cobs_encode(const uint8_t *input, size_t length, uint8_t *outp
 size_t serial_bus_cobs_decode(const uint8_t *input, size_t length, uint8_t *output, size_t output_cap);
 
 // Send packet framed as: [type:u8][len:u8][payload...][crc] then COBS-encoded and terminated with 0x00
-// payload_len must fit in uint8_t; returns 0 on success, -1 on failure
+// payload_len must fit in uint8_t; returns 0 if queued, -1 on failure or when the TX queue is full
 int serial_bus_send_packet(SerialBus *bus, uint8_t type, const uint8_t *payload, size_t payload_len);
 
 // ---------------------- USB Device Detection ----------------------
 
 /**
- * Find and open a USB serial device by Vendor ID and Product ID
+ * Find and open a USB serial device (/dev/ttyACM*) by Vendor ID and Product ID
  * @param vendor_id USB Vendor ID (e.g., 0x2e8a for Raspberry Pi Foundation)
  * @param product_id USB Product ID (e.g., 0x0180 for gunfx_pico)
- * @param config Serial bus configuration (device_path will be updated with found device)
+ * @param config Serial bus configuration (device_path is ignored and set to the
+ *               opened device; the string is valid while the bus is open)
  * @return SerialBus handle on success, NULL on error or device not found
  */
 SerialBus* serial_bus_open_by_vid_pid(uint16_t vendor_id, uint16_t product_id, SerialBusConfig *config);
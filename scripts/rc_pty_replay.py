@@ -0,0 +1,250 @@
+#!/usr/bin/env python3
+"""Feed SBUS / iBUS / CRSF / Pico capture frames to sfxhub through a pseudo-terminal.
+
+Creates a pty, symlinks its slave end to --link (default /tmp/rc_rx) and
+streams either a recorded capture or synthetic frames at the protocol's frame
+rate. Point config.yaml at it with:
+
+    inputs:
+      source: sbus
+      device: /tmp/rc_rx
+
+Record a capture from a real receiver (raw UART bytes):
+
+    rc_pty_replay.py --record capture.bin --device /dev/ttyAMA0 --seconds 10
+
+Replay it in a loop:
+
+    rc_pty_replay.py sbus --capture capture.bin
+
+The pico mode emulates the GunFX Pico's USB link: it streams COBS framed
+capture packets only after sfxhub sends the capture enable packet, answers
+INIT with INIT_READY, and mixes in the Pico's periodic STATUS packet and a
+line of debug text.
+"""
+
+import argparse
+import math
+import os
+import pty
+import select
+import time
+import tty
+
+FRAME_PERIOD_S = {"sbus": 0.014, "ibus": 0.007, "crsf": 0.004, "pico": 0.020}
+FRAME_LEN = {"sbus": 25, "ibus": 32}
+
+PICO_PKT_CAPTURE_CTRL = 0x30
+PICO_PKT_CAPTURE_FRAME = 0x31
+PICO_PKT_INIT = 0xF0
+PICO_PKT_INIT_READY = 0xF3
+PICO_PKT_STATUS = 0xF4
+PICO_CAPTURE_INPUTS = 5
+
+
+def us_to_11bit(us):
+    return max(0, min(2047, round((us - 1500) * 8 / 5 + 992)))
+
+
+def pack_11bit(values_us):
+    bits, nbits, out = 0, 0, bytearray()
+    for us in values_us:
+        bits |= us_to_11bit(us) << nbits
+        nbits += 11
+        while nbits >= 8:
+            out.append(bits & 0xFF)
+            bits >>= 8
+            nbits -= 8
+    return bytes(out)
+
+
+def crc8_dvb_s2(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0xD5) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def crc8_poly_07(data):
+    crc = 0
+    for byte in data:
+        crc ^= byte
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def cobs_encode(data):
+    out, block = bytearray(), bytearray()
+    for byte in data:
+        if byte == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 254:
+                out += bytes([255]) + block
+                block = bytearray()
+    return bytes(out + bytes([len(block) + 1]) + block)
+
+
+def cobs_decode(data):
+    out, i = bytearray(), 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+def pico_packet(ptype, payload):
+    packet = bytes([ptype, len(payload)]) + payload
+    return cobs_encode(packet + bytes([crc8_poly_07(packet)])) + b"\x00"
+
+
+def pico_status(channels_us):
+    # Heater on, servos 1-3 following inputs 3-5, not firing
+    payload = bytes([0x08]) + (0).to_bytes(2, "little")
+    for us in channels_us[2:5]:
+        payload += int(us).to_bytes(2, "little")
+    return pico_packet(PICO_PKT_STATUS, payload + (0).to_bytes(2, "little"))
+
+
+def build_frame(protocol, channels_us):
+    if protocol == "pico":
+        # Every input fresh, captured 1 ms before the frame is sent
+        payload = bytes([(1 << PICO_CAPTURE_INPUTS) - 1]) + (1000).to_bytes(2, "little")
+        for us in channels_us[:PICO_CAPTURE_INPUTS]:
+            payload += int(us).to_bytes(2, "little")
+        return pico_packet(PICO_PKT_CAPTURE_FRAME, payload)
+    if protocol == "sbus":
+        return bytes([0x0F]) + pack_11bit(channels_us[:16]) + bytes([0x00, 0x00])
+    if protocol == "ibus":
+        frame = bytearray([0x20, 0x40])
+        for us in channels_us[:14]:
+            frame += int(us).to_bytes(2, "little")
+        checksum = (0xFFFF - sum(frame)) & 0xFFFF
+        return bytes(frame) + checksum.to_bytes(2, "little")
+    payload = bytes([0x16]) + pack_11bit(channels_us[:16])
+    return bytes([0xC8, len(payload) + 1]) + payload + bytes([crc8_dvb_s2(payload)])
+
+
+def synthetic_channels(t):
+    # Channel 1 sweeps 1000-2000 µs over 4 s, channel 2 toggles every 2 s, rest centred
+    channels = [1500] * 16
+    channels[0] = 1500 + 500 * math.sin(2 * math.pi * t / 4)
+    channels[1] = 2000 if int(t / 2) % 2 else 1000
+    return channels
+
+
+def split_capture(protocol, data):
+    # Fixed-size protocols are replayed frame by frame; CRSF by its length byte, Pico by delimiter
+    if protocol == "pico":
+        return [frame + b"\x00" for frame in data.split(b"\x00") if frame]
+    if protocol in FRAME_LEN:
+        n = FRAME_LEN[protocol]
+        return [data[i:i + n] for i in range(0, len(data), n)]
+    frames, i = [], 0
+    while i + 2 <= len(data):
+        n = data[i + 1] + 2
+        frames.append(data[i:i + n])
+        i += n
+    return frames
+
+
+def record(args):
+    fd = os.open(args.device, os.O_RDONLY | os.O_NOCTTY)
+    deadline = time.monotonic() + args.seconds
+    with open(args.record, "wb") as out:
+        while time.monotonic() < deadline:
+            out.write(os.read(fd, 256))
+    os.close(fd)
+
+
+def pico_capture_requested(master, rx, enabled):
+    # Consume packets from sfxhub (answering INIT); returns the latest capture enable state
+    while select.select([master], [], [], 0)[0]:
+        try:
+            rx += os.read(master, 256)
+        except OSError:
+            break
+    while b"\x00" in rx:
+        frame, _, rest = bytes(rx).partition(b"\x00")
+        rx[:] = rest
+        packet = cobs_decode(frame)
+        if packet and packet[0] == PICO_PKT_INIT:
+            os.write(master, pico_packet(PICO_PKT_INIT_READY, b"MSB GunFX"))
+        if packet and len(packet) == 4 and packet[0] == PICO_PKT_CAPTURE_CTRL and crc8_poly_07(packet[:3]) == packet[3]:
+            enabled = packet[2] != 0
+            print(f"capture {'enabled' if enabled else 'disabled'} by host")
+    return enabled
+
+
+def replay(args):
+    master, slave = pty.openpty()
+    tty.setraw(slave)  # No echo or line editing before sfxhub configures the port
+    if os.path.lexists(args.link):
+        os.unlink(args.link)
+    os.symlink(os.ttyname(slave), args.link)
+    print(f"{args.protocol} frames on {args.link} -> {os.ttyname(slave)} (Ctrl+C to stop)")
+
+    period = FRAME_PERIOD_S[args.protocol]
+    frames = None
+    if args.capture:
+        with open(args.capture, "rb") as f:
+            frames = split_capture(args.protocol, f.read())
+
+    start = time.monotonic()
+    index = 0
+    pico_rx = bytearray()
+    pico_enabled = False
+    try:
+        while True:
+            streaming = True
+            if args.protocol == "pico":
+                # The Pico sends STATUS once a second and capture frames only on request
+                pico_enabled = pico_capture_requested(master, pico_rx, pico_enabled)
+                if index % 50 == 0:
+                    channels = synthetic_channels(time.monotonic() - start)
+                    os.write(master, b"Heater: ON\r\n" + pico_status(channels))
+                streaming = pico_enabled
+            if streaming:
+                if frames:
+                    frame = frames[index % len(frames)]
+                else:
+                    frame = build_frame(args.protocol, synthetic_channels(time.monotonic() - start))
+                os.write(master, frame)
+            index += 1
+            time.sleep(max(0.0, start + index * period - time.monotonic()))
+    except KeyboardInterrupt:
+        pass
+    finally:
+        os.unlink(args.link)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("protocol", nargs="?", choices=sorted(FRAME_PERIOD_S), default="sbus")
+    parser.add_argument("--link", default="/tmp/rc_rx", help="symlink created for the pty slave")
+    parser.add_argument("--capture", help="raw capture to replay in a loop (default: synthetic frames)")
+    parser.add_argument("--record", help="record raw bytes from --device into this file")
+    parser.add_argument("--device", help="receiver UART to record from")
+    parser.add_argument("--seconds", type=float, default=10.0, help="recording duration")
+    args = parser.parse_args()
+
+    if args.record:
+        if not args.device:
+            parser.error("--record requires --device")
+        record(args)
+    else:
+        replay(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,81 @@
+/**
+ * @file alloc_check.c
+ * @brief Counting allocator (only linked with `make ALLOC_CHECK=1`)
+ * 
+ * Defining the allocator entry points in the executable interposes them for
+ * the whole process, so allocations made inside libgpiod or libc on behalf of
+ * a hot loop are seen too. Each call forwards to glibc's __libc_* allocator.
+ */
+
+#include <stddef.h>
+#include <errno.h>
+#include <threads.h>
+#include "alloc_check.h"
+
+extern void *__libc_malloc(size_t size);
+extern void *__libc_calloc(size_t nmemb, size_t size);
+extern void *__libc_realloc(void *ptr, size_t size);
+extern void *__libc_memalign(size_t alignment, size_t size);
+extern void __libc_free(void *ptr);
+
+// Per-thread state; initial-exec TLS never allocates on access
+static thread_local bool counting __attribute__((tls_model("initial-exec"))) = false;
+static thread_local uint64_t alloc_count __attribute__((tls_model("initial-exec"))) = 0;
+
+static inline void count_allocation(void) {
+    if (counting) {
+        alloc_count++;
+    }
+}
+
+void alloc_check_thread_enable(bool enable) {
+    counting = enable;
+    alloc_count = 0;
+}
+
+uint64_t alloc_check_thread_count(void) {
+    return alloc_count;
+}
+
+// ============================================================================
+// INTERPOSED ALLOCATOR
+// ============================================================================
+
+void *malloc(size_t size) {
+    count_allocation();
+    return __libc_malloc(size);
+}
+
+void *calloc(size_t nmemb, size_t size) {
+    count_allocation();
+    return __libc_calloc(nmemb, size);
+}
+
+void *realloc(void *ptr, size_t size) {
+    count_allocation();
+    return __libc_realloc(ptr, size);
+}
+
+void *aligned_alloc(size_t alignment, size_t size) {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+void *memalign(size_t alignment, size_t size) {
+    count_allocation();
+    return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void **memptr, size_t alignment, size_t size) {
+    count_allocation();
+    void *ptr = __libc_memalign(alignment, size);
+    if (!ptr) {
+        return ENOMEM;
+    }
+    *memptr = ptr;
+    return 0;
+}
+
+void free(void *ptr) {
+    __libc_free(ptr);
+}
@@ -2,10 +2,20 @@
 #include "miniaudio.h"
 #include "audio_player.h"
 #include "logging.h"
+#include "rt_sched.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #include <threads.h>  // C23 standard threads
+#include <stdatomic.h>
+#include <stdint.h>
+#include <time.h>     // Load-time decode benchmark
+#include <math.h>
+#include <sys/stat.h> // Loudness sidecar validation
+#include <poll.h>
+#include <libgen.h>    // For dirname/basename (hot reload watches)
+#include <sys/inotify.h>
 #include <unistd.h>   // For home directory expansion
 #include <pwd.h>      // For getpwnam (user lookup)
 
@@ -13,12 +23,46 @@
 // SOUND IMPLEMENTATION - For Loading Audio Files
 // ============================================================================
 
+// Decoded PCM shared by every voice playing a sound.
+// Replaced wholesale on hot reload; old buffers are retired (not freed) until
+// the last voice referencing them lets go.
+typedef struct SoundBuffer {
+    float *frames;                      // Interleaved f32 PCM (SOUND_STORAGE_PCM)
+    uint8_t *adpcm;                     // IMA-ADPCM blocks (SOUND_STORAGE_ADPCM)
+    size_t adpcm_block_bytes;           // Bytes per block (all channels)
+    SoundStorage storage;
+    float gain;                         // Normalisation gain (1.0 when disabled), applied as voices read
+    ma_uint64 frame_count;
+    ma_uint32 channels;
+    ma_uint32 sample_rate;
+    atomic_int refs;                    // Voices currently reading this buffer
+    struct SoundBuffer *next_retired;   // Link in owning sound's retired list
+} SoundBuffer;
+
 struct Sound {
-    ma_decoder decoder;
-    char *filename;
-    bool is_loaded;
+    _Atomic(SoundBuffer *) buffer;      // Current PCM (atomic pointer flip on reload)
+    atomic_int readers;                 // Voices between pointer load and ref increment
+    SoundBuffer *retired;               // Replaced buffers still referenced by voices
+    char *filename;                     // As given in config (for logging)
+    char *path;                         // Expanded path (decoded / watched)
+    SoundLoadOptions options;           // Storage/normalisation (kept across reloads)
+    int watch_wd;                       // inotify watch descriptor (-1 if not watched)
 };
 
+// Per-channel playback cursor over a sound's PCM (miniaudio data source).
+// Reads run on the audio thread and never lock or allocate.
+typedef struct {
+    ma_data_source_base base;
+    Sound *sound;
+    SoundBuffer *buffer;                // Buffer pinned by this voice (audio thread owned)
+    ma_uint32 channels;                 // Fixed at creation (reloads keep the format)
+    ma_uint32 sample_rate;
+    atomic_uint_least64_t cursor;       // Read position in frames
+    atomic_uint_least64_t length;       // Length of pinned buffer in frames
+    float *block_cache;                 // Decoded ADPCM block (nullptr for PCM storage)
+    ma_uint64 cached_block;             // Block index held in block_cache
+} SoundVoice;
+
 // Expand tilde (~) in path to home directory
 // Supports:
 //   ~ -> current user's home
@@ -86,7 +130,541 @@ static char* expand_path(const char *path) {
     return expanded;
 }
 
+// ----------------------------------------------------------------------------
+// IMA-ADPCM block codec
+// ----------------------------------------------------------------------------
+// Each block holds ADPCM_BLOCK_FRAMES frames and decodes independently, so a
+// voice can seek or loop anywhere at the cost of decoding one block.
+// Per channel (planar): [predictor:s16le][step_index:u8][pad:u8][nibbles...]
+// The header predictor is frame 0; nibbles encode frames 1..N-1, low nibble first.
+
+#define ADPCM_BLOCK_FRAMES      1024
+#define ADPCM_CHANNEL_BYTES     (4 + ADPCM_BLOCK_FRAMES / 2)
+#define ADPCM_NO_BLOCK          UINT64_MAX
+
+static const int16_t adpcm_step_table[89] = {
+    7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+    50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230,
+    253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963,
+    1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024, 3327,
+    3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442,
+    11487, 12635, 13899, 15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794,
+    32767
+};
+
+static const int8_t adpcm_index_table[16] = {
+    -1, -1, -1, -1, 2, 4, 6, 8,
+    -1, -1, -1, -1, 2, 4, 6, 8
+};
+
+typedef struct {
+    int predictor;
+    int step_index;
+} AdpcmState;
+
+static inline int adpcm_decode_nibble(AdpcmState *state, uint8_t nibble) {
+    int step = adpcm_step_table[state->step_index];
+    int diff = step >> 3;
+    if (nibble & 4) diff += step;
+    if (nibble & 2) diff += step >> 1;
+    if (nibble & 1) diff += step >> 2;
+    
+    state->predictor += (nibble & 8) ? -diff : diff;
+    if (state->predictor > 32767) state->predictor = 32767;
+    if (state->predictor < -32768) state->predictor = -32768;
+    
+    state->step_index += adpcm_index_table[nibble];
+    if (state->step_index < 0) state->step_index = 0;
+    if (state->step_index > 88) state->step_index = 88;
+    return state->predictor;
+}
+
+static inline uint8_t adpcm_encode_sample(AdpcmState *state, int sample) {
+    int step = adpcm_step_table[state->step_index];
+    int diff = sample - state->predictor;
+    uint8_t nibble = 0;
+    
+    if (diff < 0) {
+        nibble = 8;
+        diff = -diff;
+    }
+    if (diff >= step) { nibble |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { nibble |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) nibble |= 1;
+    
+    // Track the decoder's reconstruction so quantisation error doesn't accumulate
+    adpcm_decode_nibble(state, nibble);
+    return nibble;
+}
+
+static inline int adpcm_sample_from_float(float value) {
+    int sample = (int)(value * 32767.0f);
+    if (sample > 32767) return 32767;
+    if (sample < -32768) return -32768;
+    return sample;
+}
+
+// Decode one block to interleaved f32 (always ADPCM_BLOCK_FRAMES frames)
+static void adpcm_decode_block(const SoundBuffer *buffer, ma_uint64 block, float *out) {
+    const uint8_t *block_data = buffer->adpcm + block * buffer->adpcm_block_bytes;
+    const ma_uint32 channels = buffer->channels;
+    
+    for (ma_uint32 ch = 0; ch < channels; ch++) {
+        const uint8_t *in = block_data + ch * ADPCM_CHANNEL_BYTES;
+        AdpcmState state = {
+            .predictor = (int16_t)(in[0] | (in[1] << 8)),
+            .step_index = in[2] > 88 ? 88 : in[2]
+        };
+        const uint8_t *nibbles = in + 4;
+        
+        out[ch] = (float)state.predictor / 32768.0f;
+        for (int i = 1; i < ADPCM_BLOCK_FRAMES; i++) {
+            uint8_t nibble = (nibbles[(i - 1) >> 1] >> (((i - 1) & 1) * 4)) & 0x0F;
+            out[i * channels + ch] = (float)adpcm_decode_nibble(&state, nibble) / 32768.0f;
+        }
+    }
+}
+
+// Re-encode a decoded buffer's PCM as ADPCM blocks and drop the f32 copy
+static int sound_buffer_compress(SoundBuffer *buffer) {
+    const ma_uint32 channels = buffer->channels;
+    ma_uint64 block_count = (buffer->frame_count + ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES;
+    size_t block_bytes = (size_t)channels * ADPCM_CHANNEL_BYTES;
+    
+    uint8_t *adpcm = calloc(block_count, block_bytes);
+    AdpcmState *states = calloc(channels, sizeof(AdpcmState));
+    if (!adpcm || !states) {
+        free(adpcm);
+        free(states);
+        return -1;
+    }
+    
+    // Warm the step size up on the opening samples so the first block starts
+    // adapted instead of ramping up from the smallest step
+    for (ma_uint32 ch = 0; ch < channels; ch++) {
+        for (ma_uint64 frame = 0; frame < buffer->frame_count && frame < 64; frame++) {
+            adpcm_encode_sample(&states[ch], adpcm_sample_from_float(buffer->frames[frame * channels + ch]));
+        }
+    }
+    
+    for (ma_uint64 block = 0; block < block_count; block++) {
+        ma_uint64 first = block * ADPCM_BLOCK_FRAMES;
+        
+        for (ma_uint32 ch = 0; ch < channels; ch++) {
+            uint8_t *out = adpcm + block * block_bytes + ch * ADPCM_CHANNEL_BYTES;
+            AdpcmState *state = &states[ch];
+            
+            // Predictor restarts on the exact sample; step index carries over
+            int sample0 = adpcm_sample_from_float(buffer->frames[first * channels + ch]);
+            state->predictor = sample0;
+            out[0] = (uint8_t)(sample0 & 0xFF);
+            out[1] = (uint8_t)((sample0 >> 8) & 0xFF);
+            out[2] = (uint8_t)state->step_index;
+            
+            uint8_t *nibbles = out + 4;
+            for (int i = 1; i < ADPCM_BLOCK_FRAMES; i++) {
+                ma_uint64 frame = first + (ma_uint64)i;
+                int sample = (frame < buffer->frame_count)
+                           ? adpcm_sample_from_float(buffer->frames[frame * channels + ch])
+                           : state->predictor;   // Pad the tail block by holding the last sample
+                uint8_t nibble = adpcm_encode_sample(state, sample);
+                nibbles[(i - 1) >> 1] |= (uint8_t)(nibble << (((i - 1) & 1) * 4));
+            }
+        }
+    }
+    free(states);
+    
+    ma_free(buffer->frames, nullptr);
+    buffer->frames = nullptr;
+    buffer->adpcm = adpcm;
+    buffer->adpcm_block_bytes = block_bytes;
+    buffer->storage = SOUND_STORAGE_ADPCM;
+    return 0;
+}
+
+// Measure decode cost (the work a voice adds to the audio callback) and log
+// it next to the RAM saved versus plain f32 storage
+static void sound_buffer_log_adpcm_benchmark(const SoundBuffer *buffer, const char *filename) {
+    ma_uint64 block_count = (buffer->frame_count + ADPCM_BLOCK_FRAMES - 1) / ADPCM_BLOCK_FRAMES;
+    float *scratch = malloc((size_t)ADPCM_BLOCK_FRAMES * buffer->channels * sizeof(float));
+    if (!scratch) return;
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    for (ma_uint64 block = 0; block < block_count; block++) {
+        adpcm_decode_block(buffer, block, scratch);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    free(scratch);
+    
+    double elapsed_ns = (double)(end.tv_sec - start.tv_sec) * 1e9 + (double)(end.tv_nsec - start.tv_nsec);
+    double ns_per_frame = elapsed_ns / (double)(block_count * ADPCM_BLOCK_FRAMES);
+    double cpu_percent = ns_per_frame * buffer->sample_rate / 1e7;   // Share of one core per voice
+    double pcm_kib = (double)buffer->frame_count * buffer->channels * sizeof(float) / 1024.0;
+    double adpcm_kib = (double)block_count * buffer->adpcm_block_bytes / 1024.0;
+    
+    LOG_INFO(LOG_AUDIO, "ADPCM %s: %.0f KiB -> %.0f KiB (saved %.0f KiB), decode %.1f ns/frame (%.2f%% CPU per voice)",
+             filename, pcm_kib, adpcm_kib, pcm_kib - adpcm_kib, ns_per_frame, cpu_percent);
+}
+
+// ----------------------------------------------------------------------------
+// Loudness analysis (BS.1770-style gated loudness, unweighted)
+// ----------------------------------------------------------------------------
+// Mean square is measured over 100 ms sub-blocks with a vectorised pass, then
+// combined into 400 ms blocks (75% overlap) with the -70 LUFS absolute and
+// -10 LU relative gates. Results are cached in "<asset>.loudness" next to the
+// file, keyed on its size and mtime, so later boots skip the analysis.
+
+#define LOUDNESS_SIDECAR_SUFFIX     ".loudness"
+#define LOUDNESS_SIDECAR_VERSION    1
+#define LOUDNESS_PEAK_CEILING_DB    -1.0f   // Never normalise a peak above -1 dBFS
+#define LOUDNESS_MAX_GAIN_DB        24.0f
+#define LOUDNESS_MIN_GAIN_DB        -30.0f
+
+typedef struct {
+    float loudness_lufs;        // -INFINITY for silence
+    float peak;                 // Sample peak (linear, 0..1+)
+} SoundLoudness;
+
+// 4-wide float vectors: NEON on ARM, SSE on x86, scalar fallback elsewhere
+typedef float loudness_v4f __attribute__((vector_size(16)));
+typedef int32_t loudness_v4i __attribute__((vector_size(16)));
+
+// Sum of squares and absolute peak over interleaved samples
+static double loudness_accumulate(const float *samples, size_t count, float *peak) {
+    loudness_v4f sum = {0};
+    loudness_v4f vmax = {0};
+    size_t i = 0;
+    
+    for (; i + 4 <= count; i += 4) {
+        loudness_v4f x;
+        memcpy(&x, samples + i, sizeof(x));   // Unaligned load
+        sum += x * x;
+        
+        loudness_v4i bits;
+        memcpy(&bits, &x, sizeof(bits));
+        bits &= 0x7FFFFFFF;                   // |x|
+        loudness_v4f ax;
+        memcpy(&ax, &bits, sizeof(ax));
+        loudness_v4i greater = ax > vmax;
+        loudness_v4i blended = ((loudness_v4i)ax & greater) | ((loudness_v4i)vmax & ~greater);
+        memcpy(&vmax, &blended, sizeof(vmax));
+    }
+    
+    double total = (double)sum[0] + sum[1] + sum[2] + sum[3];
+    float block_peak = fmaxf(fmaxf(vmax[0], vmax[1]), fmaxf(vmax[2], vmax[3]));
+    for (; i < count; i++) {
+        total += (double)samples[i] * samples[i];
+        block_peak = fmaxf(block_peak, fabsf(samples[i]));
+    }
+    
+    if (block_peak > *peak) *peak = block_peak;
+    return total;
+}
+
+static float loudness_from_mean_square(double mean_square) {
+    return (mean_square > 0.0) ? (float)(-0.691 + 10.0 * log10(mean_square)) : -INFINITY;
+}
+
+static int sound_buffer_analyze_loudness(const SoundBuffer *buffer, SoundLoudness *result) {
+    const ma_uint64 sub_frames = buffer->sample_rate / 10;
+    const size_t sub_samples = (size_t)sub_frames * buffer->channels;
+    ma_uint64 sub_count = buffer->frame_count / sub_frames;
+    
+    result->peak = 0.0f;
+    
+    // Clips shorter than one gating block are measured as a whole
+    if (sub_count < 4) {
+        size_t samples = (size_t)buffer->frame_count * buffer->channels;
+        double energy = loudness_accumulate(buffer->frames, samples, &result->peak);
+        result->loudness_lufs = loudness_from_mean_square(energy / (double)buffer->frame_count);
+        return 0;
+    }
+    
+    double *sub_energy = malloc(sub_count * sizeof(double));
+    if (!sub_energy) return -1;
+    for (ma_uint64 i = 0; i < sub_count; i++) {
+        sub_energy[i] = loudness_accumulate(buffer->frames + i * sub_samples, sub_samples, &result->peak);
+    }
+    // Trailing partial sub-block only contributes to the peak
+    ma_uint64 tail_frames = buffer->frame_count - sub_count * sub_frames;
+    loudness_accumulate(buffer->frames + sub_count * sub_samples, (size_t)tail_frames * buffer->channels, &result->peak);
+    
+    // 400 ms blocks, channel mean squares summed (equal weights)
+    ma_uint64 block_count = sub_count - 3;
+    const double block_frames = 4.0 * (double)sub_frames;
+    double abs_sum = 0.0;
+    ma_uint64 abs_count = 0;
+    for (ma_uint64 i = 0; i < block_count; i++) {
+        double z = (sub_energy[i] + sub_energy[i + 1] + sub_energy[i + 2] + sub_energy[i + 3]) / block_frames;
+        sub_energy[i] = z;   // Reuse storage for block mean squares
+        if (loudness_from_mean_square(z) > -70.0f) {
+            abs_sum += z;
+            abs_count++;
+        }
+    }
+    
+    double rel_sum = 0.0;
+    ma_uint64 rel_count = 0;
+    if (abs_count > 0) {
+        float relative_gate = loudness_from_mean_square(abs_sum / (double)abs_count) - 10.0f;
+        for (ma_uint64 i = 0; i < block_count; i++) {
+            float l = loudness_from_mean_square(sub_energy[i]);
+            if (l > -70.0f && l > relative_gate) {
+                rel_sum += sub_energy[i];
+                rel_count++;
+            }
+        }
+    }
+    free(sub_energy);
+    
+    result->loudness_lufs = (rel_count > 0) ? loudness_from_mean_square(rel_sum / (double)rel_count) : -INFINITY;
+    return 0;
+}
+
+static char* loudness_sidecar_path(const char *path) {
+    size_t len = strlen(path) + sizeof(LOUDNESS_SIDECAR_SUFFIX);
+    char *sidecar = malloc(len);
+    if (sidecar) {
+        snprintf(sidecar, len, "%s" LOUDNESS_SIDECAR_SUFFIX, path);
+    }
+    return sidecar;
+}
+
+// Load cached analysis if the sidecar matches the asset's current size/mtime
+static bool loudness_read_sidecar(const char *sidecar, const struct stat *st, SoundLoudness *result) {
+    FILE *fp = fopen(sidecar, "r");
+    if (!fp) return false;
+    
+    int version = 0;
+    long long size = 0, mtime_ns = 0;
+    float lufs = 0.0f, peak = 0.0f;
+    char lufs_text[32] = {0};
+    int fields = fscanf(fp, "version=%d\nsize=%lld\nmtime_ns=%lld\nloudness_lufs=%31s\npeak=%f",
+                        &version, &size, &mtime_ns, lufs_text, &peak);
+    fclose(fp);
+    
+    long long current_mtime_ns = (long long)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+    if (fields != 5 || version != LOUDNESS_SIDECAR_VERSION ||
+        size != (long long)st->st_size || mtime_ns != current_mtime_ns) {
+        return false;
+    }
+    
+    lufs = (strcmp(lufs_text, "silent") == 0) ? -INFINITY : strtof(lufs_text, nullptr);
+    result->loudness_lufs = lufs;
+    result->peak = peak;
+    return true;
+}
+
+// Write via a temp file + rename so a crash never leaves a torn sidecar
+static void loudness_write_sidecar(const char *sidecar, const struct stat *st, const SoundLoudness *result) {
+    size_t len = strlen(sidecar) + 5;
+    char *tmp = malloc(len);
+    if (!tmp) return;
+    snprintf(tmp, len, "%s.tmp", sidecar);
+    
+    FILE *fp = fopen(tmp, "w");
+    if (!fp) {
+        LOG_DEBUG(LOG_AUDIO, "Cannot write loudness cache %s: %s", sidecar, strerror(errno));
+        free(tmp);
+        return;
+    }
+    
+    long long mtime_ns = (long long)st->st_mtim.tv_sec * 1000000000LL + st->st_mtim.tv_nsec;
+    fprintf(fp, "version=%d\nsize=%lld\nmtime_ns=%lld\n", LOUDNESS_SIDECAR_VERSION, (long long)st->st_size, mtime_ns);
+    if (isinf(result->loudness_lufs)) {
+        fprintf(fp, "loudness_lufs=silent\n");
+    } else {
+        fprintf(fp, "loudness_lufs=%.2f\n", result->loudness_lufs);
+    }
+    fprintf(fp, "peak=%.6f\n", result->peak);
+    
+    if (fclose(fp) != 0 || rename(tmp, sidecar) != 0) {
+        unlink(tmp);
+    }
+    free(tmp);
+}
+
+// Analyse (or load cached loudness for) a freshly decoded buffer and set its gain
+static void sound_buffer_normalize(SoundBuffer *buffer, const char *path, float target_lufs) {
+    SoundLoudness loudness;
+    struct stat st;
+    bool have_stat = (stat(path, &st) == 0);
+    char *sidecar = loudness_sidecar_path(path);
+    bool cached = have_stat && sidecar && loudness_read_sidecar(sidecar, &st, &loudness);
+    
+    if (!cached) {
+        struct timespec start, end;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        if (sound_buffer_analyze_loudness(buffer, &loudness) != 0) {
+            LOG_WARN(LOG_AUDIO, "Loudness analysis failed, not normalising: %s", path);
+            free(sidecar);
+            return;
+        }
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        LOG_DEBUG(LOG_AUDIO, "Loudness analysis of %s took %.1f ms", path,
+                  (double)(end.tv_sec - start.tv_sec) * 1e3 + (double)(end.tv_nsec - start.tv_nsec) / 1e6);
+        if (have_stat && sidecar) {
+            loudness_write_sidecar(sidecar, &st, &loudness);
+        }
+    }
+    free(sidecar);
+    
+    if (isinf(loudness.loudness_lufs) || loudness.peak <= 0.0f) {
+        LOG_INFO(LOG_AUDIO, "Loudness %s: silent, gain unchanged", path);
+        return;
+    }
+    
+    // Target gain, limited so the normalised peak stays under the ceiling
+    float gain_db = target_lufs - loudness.loudness_lufs;
+    float headroom_db = LOUDNESS_PEAK_CEILING_DB - 20.0f * log10f(loudness.peak);
+    if (gain_db > headroom_db) gain_db = headroom_db;
+    if (gain_db > LOUDNESS_MAX_GAIN_DB) gain_db = LOUDNESS_MAX_GAIN_DB;
+    if (gain_db < LOUDNESS_MIN_GAIN_DB) gain_db = LOUDNESS_MIN_GAIN_DB;
+    buffer->gain = powf(10.0f, gain_db / 20.0f);
+    
+    LOG_INFO(LOG_AUDIO, "Loudness %s: %.1f LUFS, peak %.1f dBFS -> gain %+.1f dB%s", path,
+             loudness.loudness_lufs, 20.0f * log10f(loudness.peak), gain_db, cached ? " (cached)" : "");
+}
+
+// Decode a whole file into the requested in-memory storage.
+// channels/sample_rate of 0 keep the file's native format; non-zero values
+// force conversion (used on reload so voices see an unchanged data format).
+static SoundBuffer* sound_buffer_decode(const char *path, ma_uint32 channels, ma_uint32 sample_rate,
+                                        const SoundLoadOptions *options) {
+    SoundBuffer *buffer = calloc(1, sizeof(SoundBuffer));
+    if (!buffer) {
+        LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for sound buffer");
+        return nullptr;
+    }
+    
+    ma_decoder_config decoder_config = ma_decoder_config_init(ma_format_f32, channels, sample_rate);
+    void *frames = nullptr;
+    ma_result result = ma_decode_file(path, &decoder_config, &buffer->frame_count, &frames);
+    if (result != MA_SUCCESS || buffer->frame_count == 0) {
+        ma_free(frames, nullptr);
+        free(buffer);
+        return nullptr;
+    }
+    
+    buffer->frames = frames;
+    buffer->storage = SOUND_STORAGE_PCM;
+    buffer->gain = 1.0f;
+    buffer->channels = decoder_config.channels;
+    buffer->sample_rate = decoder_config.sampleRate;
+    atomic_init(&buffer->refs, 0);
+    buffer->next_retired = nullptr;
+    
+    // Analysis needs the f32 PCM, so it runs before any compression
+    if (options->normalize) {
+        sound_buffer_normalize(buffer, path, options->target_lufs);
+    }
+    
+    if (options->storage == SOUND_STORAGE_ADPCM && sound_buffer_compress(buffer) != 0) {
+        LOG_WARN(LOG_AUDIO, "ADPCM encode failed, keeping PCM: %s", path);
+    }
+    return buffer;
+}
+
+static void sound_buffer_free(SoundBuffer *buffer) {
+    if (!buffer) return;
+    ma_free(buffer->frames, nullptr);
+    free(buffer->adpcm);
+    free(buffer);
+}
+
+// Copy frames [cursor, cursor + count) of a buffer to interleaved f32 output.
+// ADPCM blocks are decoded into the voice's cache on demand (audio thread).
+static void sound_voice_copy_frames(SoundVoice *voice, SoundBuffer *buffer, ma_uint64 cursor,
+                                    float *out, ma_uint64 count) {
+    const ma_uint32 channels = buffer->channels;
+    
+    if (buffer->storage == SOUND_STORAGE_PCM) {
+        memcpy(out, buffer->frames + cursor * channels, (size_t)(count * channels * sizeof(float)));
+        return;
+    }
+    
+    while (count > 0) {
+        ma_uint64 block = cursor / ADPCM_BLOCK_FRAMES;
+        ma_uint64 offset = cursor % ADPCM_BLOCK_FRAMES;
+        ma_uint64 chunk = ADPCM_BLOCK_FRAMES - offset;
+        if (chunk > count) chunk = count;
+        
+        if (block != voice->cached_block) {
+            adpcm_decode_block(buffer, block, voice->block_cache);
+            voice->cached_block = block;
+        }
+        memcpy(out, voice->block_cache + offset * channels, (size_t)(chunk * channels * sizeof(float)));
+        
+        out += chunk * channels;
+        cursor += chunk;
+        count -= chunk;
+    }
+}
+
+// Pin the current buffer for a voice (lock-free, safe on the audio thread).
+// The readers counter marks the window between loading the pointer and taking
+// a reference, so the reclaimer never frees a buffer a voice is about to pin.
+static SoundBuffer* sound_acquire_buffer(Sound *sound) {
+    atomic_fetch_add(&sound->readers, 1);
+    SoundBuffer *buffer = atomic_load(&sound->buffer);
+    atomic_fetch_add(&buffer->refs, 1);
+    atomic_fetch_sub(&sound->readers, 1);
+    return buffer;
+}
+
+// Unpin a buffer. Never frees: retired buffers are reclaimed by the reload thread.
+static void sound_release_buffer(SoundBuffer *buffer) {
+    if (buffer) {
+        atomic_fetch_sub(&buffer->refs, 1);
+    }
+}
+
+// Free retired buffers that no voice references any more
+static void sound_reap_retired(Sound *sound) {
+    // A voice still inside sound_acquire_buffer() may hold a stale pointer
+    if (atomic_load(&sound->readers) != 0) return;
+    
+    SoundBuffer **link = &sound->retired;
+    while (*link) {
+        SoundBuffer *buffer = *link;
+        if (atomic_load(&buffer->refs) == 0) {
+            *link = buffer->next_retired;
+            sound_buffer_free(buffer);
+        } else {
+            link = &buffer->next_retired;
+        }
+    }
+}
+
+// Re-decode the sound's file and swap the new PCM in.
+// Playing voices keep their pinned buffer and pick the new one up on their
+// next loop/restart, so playback never glitches mid-buffer.
+static int sound_reload(Sound *sound) {
+    SoundBuffer *old = atomic_load(&sound->buffer);
+    SoundBuffer *fresh = sound_buffer_decode(sound->path, old->channels, old->sample_rate, &sound->options);
+    if (!fresh) {
+        LOG_WARN(LOG_AUDIO, "Hot reload failed, keeping previous audio: %s", sound->filename);
+        return -1;
+    }
+    
+    old = atomic_exchange(&sound->buffer, fresh);
+    old->next_retired = sound->retired;
+    sound->retired = old;
+    sound_reap_retired(sound);
+    
+    LOG_INFO(LOG_AUDIO, "Hot reloaded sound: %s (%llu frames)", 
+             sound->filename, (unsigned long long)fresh->frame_count);
+    return 0;
+}
+
 Sound* sound_load(const char *filename) {
+    return sound_load_with_options(filename, nullptr);
+}
+
+Sound* sound_load_with_options(const char *filename, const SoundLoadOptions *options) {
     if (!filename) {
         LOG_ERROR(LOG_AUDIO, "Filename is nullptr");
         return nullptr;
@@ -97,60 +675,213 @@ Sound* sound_load(const char *filename) {
         LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for sound");
         return nullptr;
     }
+    sound->watch_wd = -1;
+    sound->options = options ? *options : SOUND_LOAD_DEFAULTS;
     
     // Expand path if it contains tilde
-    char *expanded_path = expand_path(filename);
-    if (!expanded_path) {
+    sound->path = expand_path(filename);
+    if (!sound->path) {
         LOG_ERROR(LOG_AUDIO, "Cannot expand path: %s", filename);
         free(sound);
         return nullptr;
     }
     
-    // Initialize decoder
-    ma_result result = ma_decoder_init_file(expanded_path, nullptr, &sound->decoder);
-    if (result != MA_SUCCESS) {
-        LOG_ERROR(LOG_AUDIO, "Failed to load audio file: %s (expanded: %s)", filename, expanded_path);
-        free(expanded_path);
+    // Decode whole file up front; voices read PCM straight from memory
+    SoundBuffer *buffer = sound_buffer_decode(sound->path, 0, 0, &sound->options);
+    if (!buffer) {
+        LOG_ERROR(LOG_AUDIO, "Failed to load audio file: %s (expanded: %s)", filename, sound->path);
+        free(sound->path);
         free(sound);
         return nullptr;
     }
+    atomic_init(&sound->buffer, buffer);
+    atomic_init(&sound->readers, 0);
     
     sound->filename = strdup(filename);
     if (!sound->filename) {
         LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for filename");
-        ma_decoder_uninit(&sound->decoder);
-        free(expanded_path);
+        sound_buffer_free(buffer);
+        free(sound->path);
         free(sound);
         return nullptr;
     }
     
-    sound->is_loaded = true;
-    
     LOG_INFO(LOG_AUDIO, "Loaded sound: %s", filename);
-    free(expanded_path);  // Clean up expanded path after loading
+    if (buffer->storage == SOUND_STORAGE_ADPCM) {
+        sound_buffer_log_adpcm_benchmark(buffer, filename);
+    }
     return sound;
 }
 
+int sound_get_length_ms(Sound *sound) {
+    if (!sound) return -1;
+    SoundBuffer *buffer = atomic_load(&sound->buffer);
+    return (int)(buffer->frame_count * 1000 / buffer->sample_rate);
+}
+
 void sound_destroy(Sound *sound) {
     if (!sound) return;
     
-    if (sound->is_loaded) {
-        ma_decoder_uninit(&sound->decoder);
+    // Caller guarantees no voice still plays this sound
+    sound_buffer_free(atomic_load(&sound->buffer));
+    while (sound->retired) {
+        SoundBuffer *next = sound->retired->next_retired;
+        sound_buffer_free(sound->retired);
+        sound->retired = next;
     }
     
     free(sound->filename);
+    free(sound->path);
     free(sound);
 }
 
+// ============================================================================
+// SOUND VOICE - miniaudio data source over a Sound's PCM
+// ============================================================================
+
+static ma_result sound_voice_on_read(ma_data_source *data_source, void *frames_out, ma_uint64 frame_count, ma_uint64 *frames_read) {
+    SoundVoice *voice = (SoundVoice *)data_source;
+    SoundBuffer *buffer = voice->buffer;
+    
+    ma_uint64 cursor = atomic_load_explicit(&voice->cursor, memory_order_relaxed);
+    ma_uint64 available = (cursor < buffer->frame_count) ? buffer->frame_count - cursor : 0;
+    ma_uint64 to_read = (frame_count < available) ? frame_count : available;
+    
+    if (frames_out && to_read > 0) {
+        sound_voice_copy_frames(voice, buffer, cursor, (float *)frames_out, to_read);
+        // Gain travels with the PCM, so a reloaded buffer brings its own
+        if (buffer->gain != 1.0f) {
+            float *out = (float *)frames_out;
+            for (ma_uint64 i = 0; i < to_read * buffer->channels; i++) {
+                out[i] *= buffer->gain;
+            }
+        }
+    }
+    atomic_store_explicit(&voice->cursor, cursor + to_read, memory_order_relaxed);
+    
+    if (frames_read) *frames_read = to_read;
+    return (to_read < frame_count || to_read == 0) ? MA_AT_END : MA_SUCCESS;
+}
+
+static ma_result sound_voice_on_seek(ma_data_source *data_source, ma_uint64 frame_index) {
+    SoundVoice *voice = (SoundVoice *)data_source;
+    
+    // Rewinding (loop wrap or restart) is the glitch-free point to adopt reloaded PCM
+    if (frame_index == 0 && atomic_load(&voice->sound->buffer) != voice->buffer) {
+        SoundBuffer *previous = voice->buffer;
+        voice->buffer = sound_acquire_buffer(voice->sound);
+        voice->cached_block = ADPCM_NO_BLOCK;
+        atomic_store(&voice->length, voice->buffer->frame_count);
+        sound_release_buffer(previous);
+    }
+    
+    if (frame_index > voice->buffer->frame_count) {
+        frame_index = voice->buffer->frame_count;
+    }
+    atomic_store_explicit(&voice->cursor, frame_index, memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+static ma_result sound_voice_on_get_data_format(ma_data_source *data_source, ma_format *format, ma_uint32 *channels,
+                                                ma_uint32 *sample_rate, ma_channel *channel_map, size_t channel_map_cap) {
+    SoundVoice *voice = (SoundVoice *)data_source;
+    
+    // Format is fixed for the voice's lifetime (reloads decode to the same format)
+    if (format) *format = ma_format_f32;
+    if (channels) *channels = voice->channels;
+    if (sample_rate) *sample_rate = voice->sample_rate;
+    if (channel_map) ma_channel_map_init_standard(ma_standard_channel_map_default, channel_map, channel_map_cap, voice->channels);
+    return MA_SUCCESS;
+}
+
+static ma_result sound_voice_on_get_cursor(ma_data_source *data_source, ma_uint64 *cursor) {
+    SoundVoice *voice = (SoundVoice *)data_source;
+    *cursor = atomic_load_explicit(&voice->cursor, memory_order_relaxed);
+    return MA_SUCCESS;
+}
+
+static ma_result sound_voice_on_get_length(ma_data_source *data_source, ma_uint64 *length) {
+    SoundVoice *voice = (SoundVoice *)data_source;
+    *length = atomic_load(&voice->length);
+    return MA_SUCCESS;
+}
+
+static const ma_data_source_vtable sound_voice_vtable = {
+    .onRead = sound_voice_on_read,
+    .onSeek = sound_voice_on_seek,
+    .onGetDataFormat = sound_voice_on_get_data_format,
+    .onGetCursor = sound_voice_on_get_cursor,
+    .onGetLength = sound_voice_on_get_length,
+    .onSetLooping = nullptr,
+    .flags = 0
+};
+
+static void sound_voice_destroy(SoundVoice *voice);
+
+static SoundVoice* sound_voice_create(Sound *sound, ma_uint64 start_frame) {
+    SoundVoice *voice = calloc(1, sizeof(SoundVoice));
+    if (!voice) return nullptr;
+    
+    ma_data_source_config config = ma_data_source_config_init();
+    config.vtable = &sound_voice_vtable;
+    if (ma_data_source_init(&config, &voice->base) != MA_SUCCESS) {
+        free(voice);
+        return nullptr;
+    }
+    
+    voice->sound = sound;
+    voice->buffer = sound_acquire_buffer(sound);
+    voice->channels = voice->buffer->channels;
+    voice->sample_rate = voice->buffer->sample_rate;
+    if (start_frame > voice->buffer->frame_count) {
+        start_frame = voice->buffer->frame_count;
+    }
+    atomic_init(&voice->cursor, start_frame);
+    atomic_init(&voice->length, voice->buffer->frame_count);
+    
+    // Compressed sounds decode one block at a time into a per-voice cache.
+    // Sized from the load options, not the current buffer: a sound whose
+    // first encode failed is PCM now but may be ADPCM after a hot reload.
+    voice->cached_block = ADPCM_NO_BLOCK;
+    if (sound->options.storage == SOUND_STORAGE_ADPCM || voice->buffer->storage == SOUND_STORAGE_ADPCM) {
+        voice->block_cache = malloc((size_t)ADPCM_BLOCK_FRAMES * voice->channels * sizeof(float));
+        if (!voice->block_cache) {
+            sound_voice_destroy(voice);
+            return nullptr;
+        }
+    }
+    return voice;
+}
+
+static void sound_voice_destroy(SoundVoice *voice) {
+    if (!voice) return;
+    free(voice->block_cache);
+    sound_release_buffer(voice->buffer);
+    ma_data_source_uninit(&voice->base);
+    free(voice);
+}
+
 // ============================================================================
 // AUDIO MIXER IMPLEMENTATION - For Parallel Playback
 // ============================================================================
 
 #define MAX_MIXER_CHANNELS 8
+#define MAX_QUEUED_SOUNDS  8    // Earlier sequence events waiting/playing on a channel
+#define MAX_FADING_SOUNDS  4    // Replaced sounds still fading out under a channel's new one
 
 struct AudioMixer {
     ma_engine engine;
+    atomic_flag rt_applied;                    // Audio thread scheduling applied
     ma_sound *sounds[MAX_MIXER_CHANNELS];
+    SoundVoice *voices[MAX_MIXER_CHANNELS];    // Data source feeding each channel's ma_sound
+    ma_sound *tail_sounds[MAX_MIXER_CHANNELS]; // Release tail scheduled after a fade-out
+    SoundVoice *tail_voices[MAX_MIXER_CHANNELS];
+    ma_sound *fading_sounds[MAX_MIXER_CHANNELS][MAX_FADING_SOUNDS];  // Crossfaded out by a new sound
+    SoundVoice *fading_voices[MAX_MIXER_CHANNELS][MAX_FADING_SOUNDS];
+    int fading_next[MAX_MIXER_CHANNELS];  // Slot reused when none has finished
+    ma_sound *queued_sounds[MAX_MIXER_CHANNELS][MAX_QUEUED_SOUNDS];  // Sequence events handed over to a later one
+    SoundVoice *queued_voices[MAX_MIXER_CHANNELS][MAX_QUEUED_SOUNDS];
+    int queued_count[MAX_MIXER_CHANNELS];
     
     mtx_t mixer_mutex;  // C23 standard mutex
     int max_channels;
@@ -158,11 +889,226 @@ struct AudioMixer {
     bool active[MAX_MIXER_CHANNELS];
     bool loop[MAX_MIXER_CHANNELS];
     float volume[MAX_MIXER_CHANNELS];
+    float pitch[MAX_MIXER_CHANNELS];
+    bool pitch_enabled[MAX_MIXER_CHANNELS];  // Sounds get the resampling stage (audio_mixer_set_pitch called)
+    ChannelEnvelope envelope[MAX_MIXER_CHANNELS];
     
     bool engine_initialized;
     float master_volume;
 };
 
+static ma_uint64 mixer_ms_to_frames(AudioMixer *mixer, int ms) {
+    if (ms <= 0) return 0;
+    return (ma_uint64)ms * ma_engine_get_sample_rate(&mixer->engine) / 1000;
+}
+
+// Create a voice over a sound plus the ma_sound that plays it (not started).
+// Volume changes on the ma_sound are smoothed per sample by the audio thread
+// over the channel's volume_ramp_ms. Channels without pitch control skip the
+// engine's resampling stage.
+static int mixer_create_sound(AudioMixer *mixer, int channel_id, Sound *sound, ma_uint64 start_frame,
+                              SoundVoice **voice_out, ma_sound **sound_out) {
+    // Each channel gets its own voice so several channels can play one sound
+    SoundVoice *voice = sound_voice_create(sound, start_frame);
+    ma_sound *ma = malloc(sizeof(ma_sound));
+    if (!voice || !ma) {
+        LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for sound on channel %d", channel_id);
+        free(ma);
+        sound_voice_destroy(voice);
+        return -1;
+    }
+    
+    ma_sound_config config = ma_sound_config_init_2(&mixer->engine);
+    config.pDataSource = voice;
+    config.flags = MA_SOUND_FLAG_NO_SPATIALIZATION;
+    if (!mixer->pitch_enabled[channel_id]) {
+        config.flags |= MA_SOUND_FLAG_NO_PITCH;
+    }
+    config.volumeSmoothTimeInPCMFrames = (ma_uint32)mixer_ms_to_frames(mixer, mixer->envelope[channel_id].volume_ramp_ms);
+    
+    if (ma_sound_init_ex(&mixer->engine, &config, ma) != MA_SUCCESS) {
+        LOG_ERROR(LOG_AUDIO, "Failed to initialize sound on channel %d", channel_id);
+        free(ma);
+        sound_voice_destroy(voice);
+        return -1;
+    }
+    if (mixer->pitch_enabled[channel_id]) {
+        ma_sound_set_pitch(ma, mixer->pitch[channel_id]);
+    }
+    
+    *voice_out = voice;
+    *sound_out = ma;
+    return 0;
+}
+
+static void mixer_destroy_sound(SoundVoice **voice, ma_sound **sound) {
+    if (*sound) {
+        ma_sound_uninit(*sound);
+        free(*sound);
+        *sound = nullptr;
+    }
+    if (*voice) {
+        sound_voice_destroy(*voice);
+        *voice = nullptr;
+    }
+}
+
+// Tear down a channel's sound, voice and queued sequence events (caller holds mixer_mutex)
+static void mixer_release_channel(AudioMixer *mixer, int channel_id) {
+    mixer_destroy_sound(&mixer->voices[channel_id], &mixer->sounds[channel_id]);
+    for (int i = 0; i < mixer->queued_count[channel_id]; i++) {
+        mixer_destroy_sound(&mixer->queued_voices[channel_id][i], &mixer->queued_sounds[channel_id][i]);
+    }
+    mixer->queued_count[channel_id] = 0;
+}
+
+// Tear down a channel's release tail (caller holds mixer_mutex)
+static void mixer_release_tail(AudioMixer *mixer, int channel_id) {
+    mixer_destroy_sound(&mixer->tail_voices[channel_id], &mixer->tail_sounds[channel_id]);
+}
+
+// Tear down a channel's crossfaded-out sounds (caller holds mixer_mutex)
+static void mixer_release_fading(AudioMixer *mixer, int channel_id) {
+    for (int i = 0; i < MAX_FADING_SOUNDS; i++) {
+        mixer_destroy_sound(&mixer->fading_voices[channel_id][i], &mixer->fading_sounds[channel_id][i]);
+    }
+}
+
+// Make way for a new sound on a channel without a click (caller holds mixer_mutex).
+// A sound still playing fades out in a fading slot, over the envelope's
+// fade_out_ms or, without one, across the new sound's fade-in. A ringing
+// release tail ramps down over the fade-in, and a tail that has not started
+// yet is cancelled. Queued sequence events are released.
+static void mixer_retire_channel(AudioMixer *mixer, int channel_id, int fade_in_ms) {
+    ma_sound *outgoing = mixer->sounds[channel_id];
+    int fade_out_ms = mixer->envelope[channel_id].fade_out_ms > 0 ? mixer->envelope[channel_id].fade_out_ms : fade_in_ms;
+    ma_uint64 fade_out_frames = mixer_ms_to_frames(mixer, fade_out_ms);
+    if (outgoing && fade_out_frames > 0 && ma_sound_is_playing(outgoing)) {
+        // Reuse a slot whose sound has finished, else the one replaced longest ago
+        int slot = mixer->fading_next[channel_id];
+        for (int i = 0; i < MAX_FADING_SOUNDS; i++) {
+            ma_sound *fading = mixer->fading_sounds[channel_id][i];
+            if (!fading || !ma_sound_is_playing(fading)) {
+                slot = i;
+                break;
+            }
+        }
+        mixer->fading_next[channel_id] = (slot + 1) % MAX_FADING_SOUNDS;
+        mixer_destroy_sound(&mixer->fading_voices[channel_id][slot], &mixer->fading_sounds[channel_id][slot]);
+        
+        ma_sound_stop_with_fade_in_pcm_frames(outgoing, fade_out_frames);
+        mixer->fading_sounds[channel_id][slot] = outgoing;
+        mixer->fading_voices[channel_id][slot] = mixer->voices[channel_id];
+        mixer->sounds[channel_id] = nullptr;
+        mixer->voices[channel_id] = nullptr;
+    }
+    
+    ma_sound *tail = mixer->tail_sounds[channel_id];
+    if (tail && ma_sound_is_playing(tail)) {
+        ma_sound_stop_with_fade_in_pcm_frames(tail, mixer_ms_to_frames(mixer, fade_in_ms));
+    } else if (tail) {
+        ma_sound_stop(tail);   // Scheduled after a fade-out but not audible yet
+    }
+    
+    mixer_release_channel(mixer, channel_id);
+}
+
+// Replace whatever is on a channel with a new voice and start it (caller holds mixer_mutex)
+static int mixer_play_voice(AudioMixer *mixer, int channel_id, Sound *sound, ma_uint64 start_frame,
+                            const PlaybackOptions *options) {
+    const ChannelEnvelope *envelope = &mixer->envelope[channel_id];
+    int fade_in_ms = (options && options->fade_in_ms >= 0) ? options->fade_in_ms : envelope->fade_in_ms;
+    
+    // Whatever is still audible is crossfaded under the new sound instead of cut
+    mixer_retire_channel(mixer, channel_id, fade_in_ms);
+    
+    if (mixer_create_sound(mixer, channel_id, sound, start_frame,
+                           &mixer->voices[channel_id], &mixer->sounds[channel_id]) != 0) {
+        return -1;
+    }
+    
+    // Set channel properties
+    mixer->active[channel_id] = true;
+    mixer->loop[channel_id] = options ? options->loop : false;
+    mixer->volume[channel_id] = options ? options->volume : 1.0f;
+    ma_sound_set_looping(mixer->sounds[channel_id], mixer->loop[channel_id] ? MA_TRUE : MA_FALSE);
+    ma_sound_set_volume(mixer->sounds[channel_id], mixer->volume[channel_id]);
+    
+    // Fade-in ramp runs on the audio thread from the first rendered frame
+    if (fade_in_ms > 0) {
+        ma_sound_set_fade_in_pcm_frames(mixer->sounds[channel_id], 0.0f, 1.0f, mixer_ms_to_frames(mixer, fade_in_ms));
+    }
+    
+    // Start playing immediately
+    ma_sound_start(mixer->sounds[channel_id]);
+    return 0;
+}
+
+// Fade a channel out and, if configured, schedule its release tail to start
+// exactly when the fade ends. Never blocks: the audio thread runs the ramp
+// and stops the sound itself (caller holds mixer_mutex).
+static void mixer_fade_out_channel(AudioMixer *mixer, int channel_id) {
+    const ChannelEnvelope *envelope = &mixer->envelope[channel_id];
+    ma_sound *sound = mixer->sounds[channel_id];
+    if (!sound || !ma_sound_is_playing(sound)) return;
+    
+    ma_uint64 fade_frames = mixer_ms_to_frames(mixer, envelope->fade_out_ms);
+    if (fade_frames > 0) {
+        ma_sound_stop_with_fade_in_pcm_frames(sound, fade_frames);
+    } else {
+        ma_sound_stop(sound);
+    }
+    
+    if (!envelope->release_tail) return;
+    
+    mixer_release_tail(mixer, channel_id);
+    if (mixer_create_sound(mixer, channel_id, envelope->release_tail, 0,
+                           &mixer->tail_voices[channel_id], &mixer->tail_sounds[channel_id]) != 0) {
+        return;
+    }
+    
+    ma_sound *tail = mixer->tail_sounds[channel_id];
+    ma_sound_set_volume(tail, mixer->volume[channel_id]);
+    ma_sound_set_start_time_in_pcm_frames(tail, ma_engine_get_time_in_pcm_frames(&mixer->engine) + fade_frames);
+    ma_sound_start(tail);
+}
+
+// Silence a channel's release tail and crossfaded-out sounds now (caller holds mixer_mutex)
+static void mixer_stop_tails(AudioMixer *mixer, int channel_id) {
+    if (mixer->tail_sounds[channel_id]) {
+        ma_sound_stop(mixer->tail_sounds[channel_id]);
+    }
+    for (int i = 0; i < MAX_FADING_SOUNDS; i++) {
+        if (mixer->fading_sounds[channel_id][i]) {
+            ma_sound_stop(mixer->fading_sounds[channel_id][i]);
+        }
+    }
+}
+
+// Stop sequence events that have not handed over yet (caller holds mixer_mutex)
+static void mixer_stop_queued(AudioMixer *mixer, int channel_id, StopMode mode) {
+    if (mode == STOP_AFTER_FINISH) return;   // Let the sequence play out
+    
+    for (int i = 0; i < mixer->queued_count[channel_id]; i++) {
+        ma_sound *queued = mixer->queued_sounds[channel_id][i];
+        if (mode == STOP_FADE_OUT) {
+            ma_sound_stop_with_fade_in_pcm_frames(queued, mixer_ms_to_frames(mixer, mixer->envelope[channel_id].fade_out_ms));
+        } else {
+            ma_sound_stop(queued);
+        }
+    }
+}
+
+// Runs on the audio device thread; the first call gives it the audio role's scheduling
+static void mixer_process_callback(void *user_data, float *frames_out, ma_uint64 frame_count) {
+    (void)frames_out;
+    (void)frame_count;
+    atomic_flag *rt_applied = user_data;
+    if (!atomic_flag_test_and_set(rt_applied)) {
+        rt_sched_apply(RT_ROLE_AUDIO, "sfx-audio");
+    }
+}
+
 AudioMixer* audio_mixer_create(int max_channels) {
     if (max_channels <= 0 || max_channels > MAX_MIXER_CHANNELS) {
         LOG_ERROR(LOG_AUDIO, "Invalid channel count (max: %d)", MAX_MIXER_CHANNELS);
@@ -178,6 +1124,8 @@ AudioMixer* audio_mixer_create(int max_channels) {
     // Initialize miniaudio engine with proper channel configuration (C23 designated initializer)
     ma_engine_config engineConfig = ma_engine_config_init();
     engineConfig.channels = 2;  // Force stereo output for WM8960
+    engineConfig.onProcess = mixer_process_callback;
+    engineConfig.pProcessUserData = &mixer->rt_applied;
     
     ma_result result = ma_engine_init(&engineConfig, &mixer->engine);
     if (result != MA_SUCCESS) {
@@ -195,7 +1143,14 @@ AudioMixer* audio_mixer_create(int max_channels) {
     for (int i = 0; i < MAX_MIXER_CHANNELS; i++) {
         mixer->active[i] = false;
         mixer->volume[i] = 1.0f;
+        mixer->pitch[i] = 1.0f;
+        mixer->pitch_enabled[i] = false;
         mixer->sounds[i] = nullptr;
+        mixer->voices[i] = nullptr;
+        mixer->tail_sounds[i] = nullptr;
+        mixer->tail_voices[i] = nullptr;
+        mixer->fading_next[i] = 0;
+        mixer->envelope[i] = CHANNEL_ENVELOPE_DEFAULTS;
     }
     
     // Set master volume on engine
@@ -215,11 +1170,9 @@ void audio_mixer_destroy(AudioMixer *mixer) {
     
     // Uninit all sounds
     for (int i = 0; i < MAX_MIXER_CHANNELS; i++) {
-        if (mixer->sounds[i]) {
-            ma_sound_uninit(mixer->sounds[i]);
-            free(mixer->sounds[i]);
-            mixer->sounds[i] = nullptr;
-        }
+        mixer_release_channel(mixer, i);
+        mixer_release_tail(mixer, i);
+        mixer_release_fading(mixer, i);
     }
     
     // Uninit engine
@@ -239,123 +1192,164 @@ int audio_mixer_play(AudioMixer *mixer, int channel_id, Sound *sound, const Play
     }
     
     mtx_lock(&mixer->mixer_mutex);
-    
-    // Uninit existing sound if any
-    if (mixer->sounds[channel_id]) {
-        ma_sound_uninit(mixer->sounds[channel_id]);
-        free(mixer->sounds[channel_id]);
-        mixer->sounds[channel_id] = nullptr;
-    }
-    
-    // Allocate and initialize new sound
-    mixer->sounds[channel_id] = malloc(sizeof(ma_sound));
-    if (!mixer->sounds[channel_id]) {
-        LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for sound on channel %d", channel_id);
-        mtx_unlock(&mixer->mixer_mutex);
-        return -1;
+    int result = mixer_play_voice(mixer, channel_id, sound, 0, options);
+    if (result == 0) {
+        LOG_INFO(LOG_AUDIO, "Channel %d: Playing %s", channel_id, sound->filename);
     }
-    
-    // Seek decoder back to start for reusability
-    ma_decoder_seek_to_pcm_frame(&sound->decoder, 0);
-    
-    ma_result result = ma_sound_init_from_data_source(&mixer->engine, &sound->decoder,
-                                                       MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION,
-                                                       nullptr, mixer->sounds[channel_id]);
-    if (result != MA_SUCCESS) {
-        LOG_ERROR(LOG_AUDIO, "Failed to initialize sound on channel %d", channel_id);
-        free(mixer->sounds[channel_id]);
-        mixer->sounds[channel_id] = nullptr;
-        mtx_unlock(&mixer->mixer_mutex);
+    mtx_unlock(&mixer->mixer_mutex);
+    return result;
+}
+
+int audio_mixer_play_from(AudioMixer *mixer, int channel_id, Sound *sound, int start_ms, const PlaybackOptions *options) {
+    if (!mixer || !sound || channel_id < 0 || channel_id >= mixer->max_channels) {
         return -1;
     }
     
-    // Set channel properties
-    mixer->active[channel_id] = true;
+    // Convert milliseconds to frames at the sound's native sample rate
+    ma_uint32 sample_rate = atomic_load(&sound->buffer)->sample_rate;
+    ma_uint64 start_frame = (ma_uint64)((start_ms / 1000.0) * sample_rate);
     
-    if (options) {
-        mixer->loop[channel_id] = options->loop;
-        mixer->volume[channel_id] = options->volume;
-        ma_sound_set_looping(mixer->sounds[channel_id], options->loop);
-        ma_sound_set_volume(mixer->sounds[channel_id], options->volume);
-    } else {
-        mixer->loop[channel_id] = false;
-        mixer->volume[channel_id] = 1.0f;
-        ma_sound_set_looping(mixer->sounds[channel_id], MA_FALSE);
-        ma_sound_set_volume(mixer->sounds[channel_id], 1.0f);
+    mtx_lock(&mixer->mixer_mutex);
+    int result = mixer_play_voice(mixer, channel_id, sound, start_frame, options);
+    if (result == 0) {
+        LOG_INFO(LOG_AUDIO, "Channel %d: Playing %s from %dms", channel_id, sound->filename, start_ms);
     }
-    
-    // Start playing immediately
-    ma_sound_start(mixer->sounds[channel_id]);
-    LOG_INFO(LOG_AUDIO, "Channel %d: Playing %s", channel_id, sound->filename);
-    
     mtx_unlock(&mixer->mixer_mutex);
-    return 0;
+    return result;
 }
 
-int audio_mixer_play_from(AudioMixer *mixer, int channel_id, Sound *sound, int start_ms, const PlaybackOptions *options) {
-    if (!mixer || !sound || channel_id < 0 || channel_id >= mixer->max_channels) {
+int audio_mixer_play_sequence(AudioMixer *mixer, const SequenceEvent *events, int count) {
+    if (!mixer || !events || count <= 0 || count > MAX_SEQUENCE_EVENTS) {
         return -1;
     }
+    for (int i = 0; i < count; i++) {
+        if (!events[i].sound || events[i].channel < 0 || events[i].channel >= mixer->max_channels ||
+            events[i].start_frame_offset < 0) {
+            LOG_ERROR(LOG_AUDIO, "Invalid sequence event %d", i);
+            return -1;
+        }
+    }
     
-    mtx_lock(&mixer->mixer_mutex);
-    
-    // Uninit existing sound if any
-    if (mixer->sounds[channel_id]) {
-        ma_sound_uninit(mixer->sounds[channel_id]);
-        free(mixer->sounds[channel_id]);
-        mixer->sounds[channel_id] = nullptr;
+    // Order by channel, then start time (stable; count is tiny)
+    int order[MAX_SEQUENCE_EVENTS];
+    for (int i = 0; i < count; i++) {
+        int j = i;
+        while (j > 0 && (events[order[j - 1]].channel > events[i].channel ||
+                         (events[order[j - 1]].channel == events[i].channel &&
+                          events[order[j - 1]].start_frame_offset > events[i].start_frame_offset))) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
     }
     
-    // Allocate and initialize new sound
-    mixer->sounds[channel_id] = malloc(sizeof(ma_sound));
-    if (!mixer->sounds[channel_id]) {
-        LOG_ERROR(LOG_AUDIO, "Cannot allocate memory for sound on channel %d", channel_id);
-        mtx_unlock(&mixer->mixer_mutex);
-        return -1;
+    // All but the last event of a channel wait in its queue
+    for (int k = 0, run = 1; k < count; k++, run++) {
+        if (k + 1 < count && events[order[k + 1]].channel == events[order[k]].channel) continue;
+        if (run - 1 > MAX_QUEUED_SOUNDS) {
+            LOG_ERROR(LOG_AUDIO, "Too many sequence events on channel %d", events[order[k]].channel);
+            return -1;
+        }
+        run = 0;
     }
     
-    // Get sample rate to convert milliseconds to frames
-    ma_uint32 sample_rate;
-    ma_data_source_get_data_format(&sound->decoder, nullptr, nullptr, &sample_rate, nullptr, 0);
+    mtx_lock(&mixer->mixer_mutex);
     
-    // Calculate frame position from milliseconds
-    ma_uint64 start_frame = (ma_uint64)((start_ms / 1000.0) * sample_rate);
+    // Create every voice before touching the channels, so a failure leaves
+    // whatever is playing untouched and nothing half scheduled
+    SoundVoice *voices[MAX_SEQUENCE_EVENTS] = {0};
+    ma_sound *sounds[MAX_SEQUENCE_EVENTS] = {0};
+    for (int k = 0; k < count; k++) {
+        const SequenceEvent *event = &events[order[k]];
+        ma_uint64 start_frame = (ma_uint64)event->sound_start_ms * atomic_load(&event->sound->buffer)->sample_rate / 1000;
+        if (mixer_create_sound(mixer, event->channel, event->sound, start_frame, &voices[k], &sounds[k]) != 0) {
+            for (int i = 0; i < k; i++) {
+                mixer_destroy_sound(&voices[i], &sounds[i]);
+            }
+            mtx_unlock(&mixer->mixer_mutex);
+            return -1;
+        }
+    }
+    
+    // Every event is pinned to an absolute engine frame, so the audio thread
+    // starts, crossfades and stops them without further control-thread timing
+    ma_uint64 origin = ma_engine_get_time_in_pcm_frames(&mixer->engine);
+    
+    for (int k = 0; k < count; k++) {
+        const SequenceEvent *event = &events[order[k]];
+        const SequenceEvent *next = (k + 1 < count && events[order[k + 1]].channel == event->channel)
+                                  ? &events[order[k + 1]] : nullptr;
+        int channel_id = event->channel;
+        SoundVoice *voice = voices[k];
+        ma_sound *sound = sounds[k];
+        
+        // What the channel was playing fades out instead of being cut
+        if (k == 0 || events[order[k - 1]].channel != channel_id) {
+            mixer_retire_channel(mixer, channel_id, event->fade_in_ms);
+        }
+        
+        ma_sound_set_looping(sound, event->loop ? MA_TRUE : MA_FALSE);
+        ma_sound_set_volume(sound, event->gain);
+        if (event->fade_in_ms > 0) {
+            ma_sound_set_fade_in_pcm_frames(sound, 0.0f, 1.0f, mixer_ms_to_frames(mixer, event->fade_in_ms));
+        }
+        ma_sound_set_start_time_in_pcm_frames(sound, origin + (ma_uint64)event->start_frame_offset);
+        
+        if (next) {
+            // Hand over to the next event: fade out across its fade-in
+            ma_uint64 fade_frames = mixer_ms_to_frames(mixer, next->fade_in_ms);
+            ma_sound_set_stop_time_with_fade_in_pcm_frames(sound, origin + (ma_uint64)next->start_frame_offset + fade_frames,
+                                                           fade_frames);
+            int slot = mixer->queued_count[channel_id]++;
+            mixer->queued_sounds[channel_id][slot] = sound;
+            mixer->queued_voices[channel_id][slot] = voice;
+        } else {
+            // Last event owns the channel (volume, stop, remaining time apply to it)
+            mixer->sounds[channel_id] = sound;
+            mixer->voices[channel_id] = voice;
+            mixer->active[channel_id] = true;
+            mixer->loop[channel_id] = event->loop;
+            mixer->volume[channel_id] = event->gain;
+        }
+        ma_sound_start(sound);
+        
+        LOG_DEBUG(LOG_AUDIO, "Channel %d: %s scheduled at +%lld frames",
+                  channel_id, event->sound->filename, (long long)event->start_frame_offset);
+    }
     
-    // Seek decoder to start position
-    ma_decoder_seek_to_pcm_frame(&sound->decoder, start_frame);
+    mtx_unlock(&mixer->mixer_mutex);
     
-    ma_result result = ma_sound_init_from_data_source(&mixer->engine, &sound->decoder,
-                                                       MA_SOUND_FLAG_NO_PITCH | MA_SOUND_FLAG_NO_SPATIALIZATION,
-                                                       nullptr, mixer->sounds[channel_id]);
-    if (result != MA_SUCCESS) {
-        LOG_ERROR(LOG_AUDIO, "Failed to initialize sound on channel %d", channel_id);
-        free(mixer->sounds[channel_id]);
-        mixer->sounds[channel_id] = nullptr;
-        mtx_unlock(&mixer->mixer_mutex);
+    LOG_INFO(LOG_AUDIO, "Sequence of %d events scheduled", count);
+    return 0;
+}
+
+int audio_mixer_get_channel_start_delay_ms(AudioMixer *mixer, int channel_id) {
+    if (!mixer || channel_id < 0 || channel_id >= mixer->max_channels) {
         return -1;
     }
     
-    // Set channel properties
-    mixer->active[channel_id] = true;
+    mtx_lock(&mixer->mixer_mutex);
     
-    if (options) {
-        mixer->loop[channel_id] = options->loop;
-        mixer->volume[channel_id] = options->volume;
-        ma_sound_set_looping(mixer->sounds[channel_id], options->loop);
-        ma_sound_set_volume(mixer->sounds[channel_id], options->volume);
-    } else {
-        mixer->loop[channel_id] = false;
-        mixer->volume[channel_id] = 1.0f;
-        ma_sound_set_looping(mixer->sounds[channel_id], MA_FALSE);
-        ma_sound_set_volume(mixer->sounds[channel_id], 1.0f);
+    // ma_sound_is_playing() is false until the scheduled start time, so a
+    // pending sound is recognised by its node state and stop time instead
+    int delay_ms = -1;
+    ma_sound *sound = mixer->sounds[channel_id];
+    if (sound && ma_node_get_state(sound) == ma_node_state_started && !ma_sound_at_end(sound)) {
+        ma_uint64 now = ma_engine_get_time_in_pcm_frames(&mixer->engine);
+        ma_uint64 start = ma_node_get_state_time(sound, ma_node_state_started);
+        ma_uint64 stop = ma_node_get_state_time(sound, ma_node_state_stopped);
+        if (stop > now) {
+            delay_ms = (start > now) ? (int)((start - now) * 1000 / ma_engine_get_sample_rate(&mixer->engine)) : 0;
+        }
     }
     
-    // Start playing immediately
-    ma_sound_start(mixer->sounds[channel_id]);
-    LOG_INFO(LOG_AUDIO, "Channel %d: Playing %s from %dms", channel_id, sound->filename, start_ms);
-    
     mtx_unlock(&mixer->mixer_mutex);
-    return 0;
+    return delay_ms;
+}
+
+int64_t audio_mixer_ms_to_frames(AudioMixer *mixer, int ms) {
+    if (!mixer) return 0;
+    return (int64_t)mixer_ms_to_frames(mixer, ms);
 }
 
 int audio_mixer_start_channel(AudioMixer *mixer, int channel_id) {
@@ -394,20 +1388,32 @@ int audio_mixer_stop_channel(AudioMixer *mixer, int channel_id, StopMode mode) {
                     // Disable looping so it stops after finish
                     mixer->loop[i] = false;
                     ma_sound_set_looping(mixer->sounds[i], MA_FALSE);
+                } else if (mode == STOP_FADE_OUT) {
+                    mixer_fade_out_channel(mixer, i);
                 } else {
                     ma_sound_stop(mixer->sounds[i]);
                 }
             }
+            if (mode == STOP_IMMEDIATE) {
+                mixer_stop_tails(mixer, i);
+            }
+            mixer_stop_queued(mixer, i, mode);
         }
     } else if (channel_id >= 0 && channel_id < mixer->max_channels) {
         if (mixer->sounds[channel_id]) {
             if (mode == STOP_AFTER_FINISH) {
                 mixer->loop[channel_id] = false;
                 ma_sound_set_looping(mixer->sounds[channel_id], MA_FALSE);
+            } else if (mode == STOP_FADE_OUT) {
+                mixer_fade_out_channel(mixer, channel_id);
             } else {
                 ma_sound_stop(mixer->sounds[channel_id]);
             }
         }
+        if (mode == STOP_IMMEDIATE) {
+            mixer_stop_tails(mixer, channel_id);
+        }
+        mixer_stop_queued(mixer, channel_id, mode);
     }
     
     mtx_unlock(&mixer->mixer_mutex);
@@ -430,6 +1436,22 @@ int audio_mixer_stop_channel(AudioMixer *mixer, int channel_id, StopMode mode) {
     return 0;
 }
 
+int audio_mixer_set_channel_envelope(AudioMixer *mixer, int channel_id, const ChannelEnvelope *envelope) {
+    if (!mixer || channel_id < 0 || channel_id >= mixer->max_channels) {
+        return -1;
+    }
+    
+    mtx_lock(&mixer->mixer_mutex);
+    mixer->envelope[channel_id] = envelope ? *envelope : CHANNEL_ENVELOPE_DEFAULTS;
+    mtx_unlock(&mixer->mixer_mutex);
+    
+    LOG_INFO(LOG_AUDIO, "Channel %d envelope: fade in %d ms, fade out %d ms, volume ramp %d ms%s",
+             channel_id, mixer->envelope[channel_id].fade_in_ms, mixer->envelope[channel_id].fade_out_ms,
+             mixer->envelope[channel_id].volume_ramp_ms,
+             mixer->envelope[channel_id].release_tail ? ", release tail" : "");
+    return 0;
+}
+
 int audio_mixer_set_volume(AudioMixer *mixer, int channel_id, float volume) {
     if (!mixer) return -1;
     
@@ -452,6 +1474,34 @@ int audio_mixer_set_volume(AudioMixer *mixer, int channel_id, float volume) {
     return 0;
 }
 
+int audio_mixer_set_pitch(AudioMixer *mixer, int channel_id, float pitch) {
+    if (!mixer || channel_id < 0 || channel_id >= mixer->max_channels || pitch <= 0.0f) return -1;
+    
+    mtx_lock(&mixer->mixer_mutex);
+    
+    mixer->pitch[channel_id] = pitch;
+    mixer->pitch_enabled[channel_id] = true;
+    
+    // Sounds created before pitch was enabled ignore this (no resampling stage)
+    if (mixer->sounds[channel_id]) {
+        ma_sound_set_pitch(mixer->sounds[channel_id], pitch);
+    }
+    if (mixer->tail_sounds[channel_id]) {
+        ma_sound_set_pitch(mixer->tail_sounds[channel_id], pitch);
+    }
+    for (int i = 0; i < MAX_FADING_SOUNDS; i++) {
+        if (mixer->fading_sounds[channel_id][i]) {
+            ma_sound_set_pitch(mixer->fading_sounds[channel_id][i], pitch);
+        }
+    }
+    for (int i = 0; i < mixer->queued_count[channel_id]; i++) {
+        ma_sound_set_pitch(mixer->queued_sounds[channel_id][i], pitch);
+    }
+    
+    mtx_unlock(&mixer->mixer_mutex);
+    return 0;
+}
+
 bool audio_mixer_is_playing(AudioMixer *mixer) {
     if (!mixer) return false;
     
@@ -480,6 +1530,9 @@ bool audio_mixer_is_channel_playing(AudioMixer *mixer, int channel_id) {
     if (mixer->sounds[channel_id]) {
         playing = ma_sound_is_playing(mixer->sounds[channel_id]);
     }
+    for (int i = 0; i < mixer->queued_count[channel_id] && !playing; i++) {
+        playing = ma_sound_is_playing(mixer->queued_sounds[channel_id][i]);
+    }
     
     mtx_unlock(&mixer->mixer_mutex);
     return playing;
@@ -554,8 +1607,80 @@ int audio_mixer_stop_looping(AudioMixer *mixer, int channel_id) {
 
 struct SoundManager {
     Sound *sounds[SOUND_ID_COUNT];
+    mtx_t sounds_mutex;         // Guards sounds[] against the reload thread
+    SoundLoadOptions load_options;  // Applied to newly loaded sounds
+    
+    // Hot reload (inotify watch on asset directories)
+    int inotify_fd;
+    thrd_t reload_thread;
+    atomic_bool reload_running;
 };
 
+// Watch the directory holding a sound's file. Directories (not files) are
+// watched so editors that save via rename-over-original are picked up too.
+static void sound_manager_watch(SoundManager *manager, Sound *sound) {
+    char *dir = strdup(sound->path);
+    if (!dir) return;
+    
+    sound->watch_wd = inotify_add_watch(manager->inotify_fd, dirname(dir), IN_CLOSE_WRITE | IN_MOVED_TO);
+    if (sound->watch_wd < 0) {
+        LOG_WARN(LOG_AUDIO, "Cannot watch %s for hot reload: %s", sound->filename, strerror(errno));
+    }
+    free(dir);
+}
+
+static bool sound_matches_event(const Sound *sound, const struct inotify_event *event) {
+    if (sound->watch_wd != event->wd || event->len == 0) return false;
+    const char *name = strrchr(sound->path, '/');
+    name = name ? name + 1 : sound->path;
+    return strcmp(name, event->name) == 0;
+}
+
+// Background thread: decode changed files and reclaim retired buffers
+static int sound_manager_reload_thread(void *arg) {
+    SoundManager *manager = (SoundManager *)arg;
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    struct pollfd pfd = { .fd = manager->inotify_fd, .events = POLLIN };
+    
+    LOG_INFO(LOG_AUDIO, "Hot reload thread started");
+    
+    while (atomic_load(&manager->reload_running)) {
+        int ret = poll(&pfd, 1, 500);  // Timeout doubles as the reclaim interval
+        if (ret < 0 && errno != EINTR) {
+            LOG_ERROR(LOG_AUDIO, "Hot reload poll() error: %s", strerror(errno));
+            break;
+        }
+        
+        if (ret > 0 && (pfd.revents & POLLIN)) {
+            ssize_t len = read(manager->inotify_fd, events, sizeof(events));
+            for (ssize_t off = 0; off < len; ) {
+                const struct inotify_event *event = (const struct inotify_event *)(events + off);
+                off += (ssize_t)(sizeof(struct inotify_event) + event->len);
+                
+                mtx_lock(&manager->sounds_mutex);
+                for (int i = 0; i < SOUND_ID_COUNT; i++) {
+                    if (manager->sounds[i] && sound_matches_event(manager->sounds[i], event)) {
+                        sound_reload(manager->sounds[i]);
+                    }
+                }
+                mtx_unlock(&manager->sounds_mutex);
+            }
+        }
+        
+        // Free buffers whose last voice has moved on to the new PCM
+        mtx_lock(&manager->sounds_mutex);
+        for (int i = 0; i < SOUND_ID_COUNT; i++) {
+            if (manager->sounds[i]) {
+                sound_reap_retired(manager->sounds[i]);
+            }
+        }
+        mtx_unlock(&manager->sounds_mutex);
+    }
+    
+    LOG_INFO(LOG_AUDIO, "Hot reload thread stopped");
+    return thrd_success;
+}
+
 SoundManager* sound_manager_create(void) {
     SoundManager *manager = calloc(1, sizeof(SoundManager));
     if (!manager) {
@@ -563,6 +1688,11 @@ SoundManager* sound_manager_create(void) {
         return nullptr;
     }
     
+    mtx_init(&manager->sounds_mutex, mtx_plain);
+    manager->load_options = SOUND_LOAD_DEFAULTS;
+    manager->inotify_fd = -1;
+    atomic_init(&manager->reload_running, false);
+    
     LOG_INFO(LOG_AUDIO, "Sound manager created");
     return manager;
 }
@@ -570,6 +1700,8 @@ SoundManager* sound_manager_create(void) {
 void sound_manager_destroy(SoundManager *manager) {
     if (!manager) return;
     
+    sound_manager_disable_hot_reload(manager);
+    
     // Destroy all sounds
     for (int i = 0; i < SOUND_ID_COUNT; i++) {
         if (manager->sounds[i]) {
@@ -578,6 +1710,7 @@ void sound_manager_destroy(SoundManager *manager) {
         }
     }
     
+    mtx_destroy(&manager->sounds_mutex);
     free(manager);
     LOG_INFO(LOG_AUDIO, "Sound manager destroyed");
 }
@@ -589,6 +1722,8 @@ int sound_manager_load_sound(SoundManager *manager, SoundID id, const char *file
     // Skip if filename is nullptr
     if (!filename) return 0;
     
+    mtx_lock(&manager->sounds_mutex);
+    
     // Destroy existing sound if any
     if (manager->sounds[id]) {
         sound_destroy(manager->sounds[id]);
@@ -596,17 +1731,76 @@ int sound_manager_load_sound(SoundManager *manager, SoundID id, const char *file
     }
     
     // Load new sound
-    manager->sounds[id] = sound_load(filename);
+    manager->sounds[id] = sound_load_with_options(filename, &manager->load_options);
     if (!manager->sounds[id]) {
+        mtx_unlock(&manager->sounds_mutex);
         LOG_ERROR(LOG_AUDIO, "Failed to load sound %d from %s", id, filename);
         return -1;
     }
     
+    if (manager->inotify_fd >= 0) {
+        sound_manager_watch(manager, manager->sounds[id]);
+    }
+    
+    mtx_unlock(&manager->sounds_mutex);
     return 0;
 }
 
+void sound_manager_set_load_options(SoundManager *manager, const SoundLoadOptions *options) {
+    if (!manager) return;
+    manager->load_options = options ? *options : SOUND_LOAD_DEFAULTS;
+}
+
 Sound* sound_manager_get_sound(SoundManager *manager, SoundID id) {
     if (!manager) return nullptr;
     if (id < 0 || id >= SOUND_ID_COUNT) return nullptr;
     return manager->sounds[id];
 }
+
+int sound_manager_enable_hot_reload(SoundManager *manager) {
+    if (!manager) return -1;
+    if (atomic_load(&manager->reload_running)) return 0;
+    
+    manager->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (manager->inotify_fd < 0) {
+        LOG_ERROR(LOG_AUDIO, "inotify_init1() failed: %s", strerror(errno));
+        return -1;
+    }
+    
+    mtx_lock(&manager->sounds_mutex);
+    for (int i = 0; i < SOUND_ID_COUNT; i++) {
+        if (manager->sounds[i]) {
+            sound_manager_watch(manager, manager->sounds[i]);
+        }
+    }
+    mtx_unlock(&manager->sounds_mutex);
+    
+    atomic_store(&manager->reload_running, true);
+    if (thrd_create(&manager->reload_thread, sound_manager_reload_thread, manager) != thrd_success) {
+        LOG_ERROR(LOG_AUDIO, "Failed to create hot reload thread");
+        atomic_store(&manager->reload_running, false);
+        close(manager->inotify_fd);
+        manager->inotify_fd = -1;
+        return -1;
+    }
+    
+    LOG_INFO(LOG_AUDIO, "Hot reload enabled for sound assets");
+    return 0;
+}
+
+void sound_manager_disable_hot_reload(SoundManager *manager) {
+    if (!manager || !atomic_load(&manager->reload_running)) return;
+    
+    atomic_store(&manager->reload_running, false);
+    thrd_join(manager->reload_thread, nullptr);
+    
+    close(manager->inotify_fd);
+    manager->inotify_fd = -1;
+    for (int i = 0; i < SOUND_ID_COUNT; i++) {
+        if (manager->sounds[i]) {
+            manager->sounds[i]->watch_wd = -1;
+        }
+    }
+    
+    LOG_INFO(LOG_AUDIO, "Hot reload disabled");
+}
@@ -0,0 +1,301 @@
+/**
+ * @file calibration.c
+ * @brief Per-channel input calibration profiles and precomputed mapping tables
+ */
+
+#include "calibration.h"
+#include "channel_decoder.h"
+#include "config_loader.h"
+#include "gpio.h"
+#include "input.h"
+#include "logging.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define CALIBRATION_VERSION        1
+#define CALIBRATION_SAMPLE_MS      20    // Average sampling period while learning
+#define CALIBRATION_DISPLAY_MS     200   // Live readout refresh
+#define CALIBRATION_MAX_INPUTS     (5 + INPUT_MAX_DECODERS)  // FX inputs and decoder inputs
+
+// Loaded profile (written once at startup, read-only afterwards)
+static ChannelCalibration profile[CALIBRATION_MAX_CHANNELS + 1];
+static bool profile_valid[CALIBRATION_MAX_CHANNELS + 1];
+
+// ============================================================================
+// PROFILE FILE
+// ============================================================================
+
+int calibration_load(const char *path) {
+    memset(profile_valid, 0, sizeof(profile_valid));
+    if (!path) return -1;
+
+    FILE *fp = fopen(path, "r");
+    if (!fp) {
+        LOG_INFO(LOG_CALIB, "No calibration profile at %s; using configured input ranges", path);
+        return -1;
+    }
+
+    char line[128];
+    int version = 0;
+    int loaded = 0;
+    while (fgets(line, sizeof(line), fp)) {
+        int channel;
+        ChannelCalibration cal;
+        if (line[0] == '#' || line[0] == '\n') continue;
+        if (sscanf(line, "version=%d", &version) == 1) continue;
+        if (sscanf(line, "channel=%d min=%d center=%d max=%d",
+                   &channel, &cal.min_us, &cal.center_us, &cal.max_us) != 4) {
+            LOG_WARN(LOG_CALIB, "Ignoring malformed calibration line: %s", line);
+            continue;
+        }
+        if (channel < 1 || channel > CALIBRATION_MAX_CHANNELS ||
+            cal.min_us < INPUT_MAP_MIN_US || cal.max_us > INPUT_MAP_MAX_US ||
+            cal.max_us - cal.min_us < CALIBRATION_MIN_TRAVEL_US ||
+            cal.center_us <= cal.min_us || cal.center_us >= cal.max_us) {
+            LOG_WARN(LOG_CALIB, "Ignoring invalid calibration for channel %d", channel);
+            continue;
+        }
+        profile[channel] = cal;
+        profile_valid[channel] = true;
+        loaded++;
+    }
+    fclose(fp);
+
+    if (version != CALIBRATION_VERSION) {
+        LOG_WARN(LOG_CALIB, "Calibration profile %s has unsupported version %d", path, version);
+        memset(profile_valid, 0, sizeof(profile_valid));
+        return -1;
+    }
+
+    LOG_INFO(LOG_CALIB, "Loaded calibration for %d channel(s) from %s", loaded, path);
+    return 0;
+}
+
+bool calibration_get(int channel, ChannelCalibration *cal) {
+    if (channel < 1 || channel > CALIBRATION_MAX_CHANNELS || !profile_valid[channel]) {
+        return false;
+    }
+    if (cal) *cal = profile[channel];
+    return true;
+}
+
+// Write via a temp file + rename so an interrupted save never leaves a torn profile
+static int calibration_save(const char *path, const int *channels, const ChannelCalibration *cals,
+                            const bool *valid, int count) {
+    size_t len = strlen(path) + 5;
+    char *tmp = malloc(len);
+    if (!tmp) return -1;
+    snprintf(tmp, len, "%s.tmp", path);
+
+    FILE *fp = fopen(tmp, "w");
+    if (!fp) {
+        LOG_ERROR(LOG_CALIB, "Cannot write %s: %s", tmp, strerror(errno));
+        free(tmp);
+        return -1;
+    }
+
+    fprintf(fp, "# sfxhub input calibration (written by --calibrate)\nversion=%d\n", CALIBRATION_VERSION);
+    for (int i = 0; i < count; i++) {
+        if (valid[i]) {
+            fprintf(fp, "channel=%d min=%d center=%d max=%d\n",
+                    channels[i], cals[i].min_us, cals[i].center_us, cals[i].max_us);
+        }
+    }
+
+    int result = 0;
+    if (fclose(fp) != 0 || rename(tmp, path) != 0) {
+        LOG_ERROR(LOG_CALIB, "Cannot save calibration profile %s: %s", path, strerror(errno));
+        unlink(tmp);
+        result = -1;
+    }
+    free(tmp);
+    return result;
+}
+
+// ============================================================================
+// MAPPING TABLES
+// ============================================================================
+
+void input_map_build(InputMap *map, int channel, int in_min, int in_max, int out_min, int out_max) {
+    ChannelCalibration cal;
+    if (calibration_get(channel, &cal)) {
+        in_min = cal.min_us;
+        in_max = cal.max_us;
+    } else {
+        cal.center_us = (in_min + in_max) / 2;
+    }
+    if (in_max <= in_min) {
+        in_max = in_min + 1;
+        cal.center_us = in_min;
+    }
+
+    // Piecewise linear through the centre: each half of the stick travel gets
+    // half of the output range, so neutral maps to the output midpoint
+    float out_mid = (float)(out_min + out_max) / 2.0f;
+    for (int in = INPUT_MAP_MIN_US; in <= INPUT_MAP_MAX_US; in++) {
+        int x = in < in_min ? in_min : in > in_max ? in_max : in;
+        float out;
+        if (x <= cal.center_us) {
+            int span = cal.center_us - in_min;
+            out = span > 0 ? (float)out_min + (out_mid - (float)out_min) * (float)(x - in_min) / (float)span : out_mid;
+        } else {
+            int span = in_max - cal.center_us;
+            out = out_mid + ((float)out_max - out_mid) * (float)(x - cal.center_us) / (float)span;
+        }
+        map->out_us[in - INPUT_MAP_MIN_US] = (int16_t)(out + 0.5f);
+    }
+    map->center_in_us = cal.center_us;
+}
+
+// ============================================================================
+// LEARNING MODE
+// ============================================================================
+
+typedef struct {
+    int channel;
+    const char *name;
+    PWMMonitor *monitor;
+    ChannelCalibration cal;
+    int last_us;                         // -1 = no signal yet
+} LearnInput;
+
+// Virtual channels (decoder outputs) are skipped; their decoder input is calibrated instead
+static int add_input(LearnInput *inputs, int count, int channel, const char *name) {
+    if (channel <= 0 || channel > CALIBRATION_MAX_CHANNELS) return count;
+    for (int i = 0; i < count; i++) {
+        if (inputs[i].channel == channel) return count;  // Shared by two features
+    }
+    inputs[count] = (LearnInput){ .channel = channel, .name = name, .last_us = -1,
+                                  .cal = { .min_us = INPUT_MAP_MAX_US, .max_us = INPUT_MAP_MIN_US } };
+    return count + 1;
+}
+
+static int64_t now_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+static void print_progress(const LearnInput *inputs, int count) {
+    printf("\r\033[K");
+    for (int i = 0; i < count; i++) {
+        if (inputs[i].last_us < 0) {
+            printf("CH%d --  ", inputs[i].channel);
+        } else {
+            printf("CH%d %d..%d [%d]  ", inputs[i].channel, inputs[i].cal.min_us,
+                   inputs[i].cal.max_us, inputs[i].last_us);
+        }
+    }
+    fflush(stdout);
+}
+
+int calibration_run(const ScaleFXConfig *config, const char *path, volatile bool *running) {
+    if (!isatty(STDIN_FILENO)) {
+        LOG_ERROR(LOG_CALIB, "Calibration is interactive; run it from a terminal");
+        return -1;
+    }
+
+    LearnInput inputs[CALIBRATION_MAX_INPUTS];
+    int count = 0;
+    count = add_input(inputs, count, config->engine.engine_toggle.input_channel, "Engine Toggle");
+    count = add_input(inputs, count, config->gun.trigger.input_channel, "Trigger");
+    count = add_input(inputs, count, config->gun.smoke.heater_toggle_channel, "Smoke Heater");
+    count = add_input(inputs, count, config->gun.turret_control.pitch.input_channel, "Turret Pitch");
+    count = add_input(inputs, count, config->gun.turret_control.yaw.input_channel, "Turret Yaw");
+    for (int i = 0; i < config->inputs.decoder_count; i++) {
+        count = add_input(inputs, count, config->inputs.decoders[i].input_channel, "Channel Decoder");
+    }
+    if (count == 0) {
+        LOG_ERROR(LOG_CALIB, "No input channels configured; nothing to calibrate");
+        return -1;
+    }
+
+    int result = -1;
+    for (int i = 0; i < count; i++) {
+        inputs[i].monitor = input_monitor_create(inputs[i].channel, inputs[i].name);
+        if (!inputs[i].monitor || pwm_monitor_start(inputs[i].monitor) != 0) {
+            LOG_ERROR(LOG_CALIB, "Cannot monitor channel %d (%s)", inputs[i].channel, inputs[i].name);
+            goto out;
+        }
+    }
+
+    printf("\nInput calibration - writing %s\n", path);
+    for (int i = 0; i < count; i++) {
+        printf("  CH%d  %s\n", inputs[i].channel, inputs[i].name);
+    }
+    printf("Move every stick and switch through its full travel, then leave the\n"
+           "sticks centred and press Enter to save (Ctrl+C aborts).\n\n");
+
+    struct pollfd pfd = { .fd = STDIN_FILENO, .events = POLLIN };
+    int64_t next_display = 0;
+    bool done = false;
+    while (*running && !done) {
+        if (poll(&pfd, 1, CALIBRATION_SAMPLE_MS) > 0) {
+            char buf[64];
+            ssize_t n = read(STDIN_FILENO, buf, sizeof(buf));
+            done = n > 0 && memchr(buf, '\n', (size_t)n) != NULL;
+        }
+
+        for (int i = 0; i < count; i++) {
+            int avg_us;
+            if (!pwm_monitor_get_average(inputs[i].monitor, &avg_us)) continue;
+            LearnInput *in = &inputs[i];
+            in->last_us = avg_us;
+            if (avg_us < in->cal.min_us) in->cal.min_us = avg_us;
+            if (avg_us > in->cal.max_us) in->cal.max_us = avg_us;
+        }
+
+        if (now_ms() >= next_display) {
+            print_progress(inputs, count);
+            next_display = now_ms() + CALIBRATION_DISPLAY_MS;
+        }
+    }
+    printf("\n");
+
+    if (!done) {
+        LOG_WARN(LOG_CALIB, "Calibration aborted; profile not written");
+        goto out;
+    }
+
+    // The centre is wherever each input rests when Enter is pressed
+    int channels[CALIBRATION_MAX_INPUTS];
+    ChannelCalibration cals[CALIBRATION_MAX_INPUTS];
+    bool valid[CALIBRATION_MAX_INPUTS];
+    int saved = 0;
+    for (int i = 0; i < count; i++) {
+        LearnInput *in = &inputs[i];
+        in->cal.center_us = in->last_us;
+        channels[i] = in->channel;
+        cals[i] = in->cal;
+        valid[i] = in->last_us >= 0 && in->cal.max_us - in->cal.min_us >= CALIBRATION_MIN_TRAVEL_US;
+
+        if (!valid[i]) {
+            LOG_WARN(LOG_CALIB, "CH%d (%s): travel %d µs is too small, not calibrated",
+                     in->channel, in->name, in->last_us >= 0 ? in->cal.max_us - in->cal.min_us : 0);
+            continue;
+        }
+        // A switch rests at an end; keep its centre strictly inside the travel
+        if (cals[i].center_us <= cals[i].min_us || cals[i].center_us >= cals[i].max_us) {
+            cals[i].center_us = (cals[i].min_us + cals[i].max_us) / 2;
+        }
+        LOG_INFO(LOG_CALIB, "CH%d (%s): min %d, centre %d, max %d µs",
+                 in->channel, in->name, cals[i].min_us, cals[i].center_us, cals[i].max_us);
+        saved++;
+    }
+
+    if (saved > 0 && calibration_save(path, channels, cals, valid, count) == 0) {
+        LOG_INFO(LOG_CALIB, "Calibration for %d channel(s) saved to %s", saved, path);
+        result = 0;
+    }
+
+out:
+    for (int i = 0; i < count; i++) {
+        input_monitor_destroy(inputs[i].monitor);
+    }
+    return result;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file channel_decoder.c
+ * @brief Multi-position switch and multiplexed channel decoding
+ */
+
+#include "channel_decoder.h"
+#include <stdlib.h>
+#include <string.h>
+
+int channel_decoder_type_from_string(const char *name, ChannelDecoderType *type) {
+    if (!name || !type) return -1;
+    if (strcmp(name, "switch") == 0) { *type = CHANNEL_DECODER_SWITCH; return 0; }
+    if (strcmp(name, "mux") == 0) { *type = CHANNEL_DECODER_MUX; return 0; }
+    return -1;
+}
+
+int channel_decoder_init(ChannelDecoder *dec, ChannelDecoderType type, int size,
+                         int in_min_us, int in_max_us, int hysteresis_us, int debounce_pulses) {
+    if (!dec || in_max_us <= in_min_us || hysteresis_us < 0 || debounce_pulses < 1) {
+        return -1;
+    }
+
+    if (type == CHANNEL_DECODER_SWITCH) {
+        if (size < 2 || size > CHANNEL_DECODER_MAX_POSITIONS) return -1;
+        dec->levels = size;
+        dec->outputs = 1;
+    } else {
+        if (size < 1 || size > CHANNEL_DECODER_MAX_BITS) return -1;
+        dec->levels = 1 << size;
+        dec->outputs = size;
+    }
+
+    dec->type = type;
+    dec->in_min_us = in_min_us;
+    dec->in_max_us = in_max_us;
+    dec->hysteresis_us = hysteresis_us;
+    dec->debounce_pulses = debounce_pulses;
+    dec->level = -1;
+    dec->pending_level = -1;
+    dec->pending_count = 0;
+    return 0;
+}
+
+// Input width at the centre of a level
+static int level_centre_us(const ChannelDecoder *dec, int level) {
+    return dec->in_min_us + level * (dec->in_max_us - dec->in_min_us) / (dec->levels - 1);
+}
+
+bool channel_decoder_feed(ChannelDecoder *dec, int pulse_us) {
+    int range = dec->in_max_us - dec->in_min_us;
+    int steps = dec->levels - 1;
+
+    // Nearest level, rounded and clamped to the ends
+    int offset = pulse_us - dec->in_min_us;
+    int level = offset <= 0 ? 0 : (2 * offset * steps + range) / (2 * range);
+    if (level > steps) level = steps;
+
+    // Hysteresis: the accepted level holds until the pulse is past its
+    // boundary by the margin, so noise on a boundary cannot toggle it
+    if (dec->level >= 0 && level != dec->level) {
+        int half_step = range / (2 * steps);
+        if (abs(pulse_us - level_centre_us(dec, dec->level)) <= half_step + dec->hysteresis_us) {
+            level = dec->level;
+        }
+    }
+
+    if (level == dec->level) {
+        dec->pending_count = 0;
+        return true;
+    }
+
+    // Debounce: a new level must be seen on consecutive pulses
+    if (level != dec->pending_level) {
+        dec->pending_level = level;
+        dec->pending_count = 0;
+    }
+    if (++dec->pending_count >= dec->debounce_pulses) {
+        dec->level = level;
+        dec->pending_count = 0;
+    }
+    return dec->level >= 0;
+}
+
+int channel_decoder_output_us(const ChannelDecoder *dec, int output) {
+    int level = dec->level < 0 ? 0 : dec->level;
+    if (dec->type == CHANNEL_DECODER_SWITCH) {
+        return CHANNEL_DECODER_OUTPUT_MIN_US +
+               level * (CHANNEL_DECODER_OUTPUT_MAX_US - CHANNEL_DECODER_OUTPUT_MIN_US) / (dec->levels - 1);
+    }
+    return (level >> output) & 1 ? CHANNEL_DECODER_OUTPUT_MAX_US : CHANNEL_DECODER_OUTPUT_MIN_US;
+}
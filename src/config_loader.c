@@ -8,6 +8,8 @@
 #include "config_loader.h"
 #include "logging.h"
 #include "gpio.h"
+#include "rc_receiver.h"
+#include "channel_decoder.h"
 #include <cyaml/cyaml.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -22,15 +24,43 @@
 #define DEFAULT_ENGINE_STARTING_OFFSET_MS   60000   // 60 seconds
 #define DEFAULT_ENGINE_STOPPING_OFFSET_MS   25000   // 25 seconds
 #define DEFAULT_ENGINE_THRESHOLD_US         1500    // PWM threshold
+#define DEFAULT_ROTOR_PULSES_PER_REV        1
+#define DEFAULT_ROTOR_MIN_PITCH             0.5f
+#define DEFAULT_ROTOR_MAX_PITCH             1.5f
+#define DEFAULT_ROTOR_WINDOW_MS             TACH_WINDOW_DEFAULT_MS
+
+// Audio Defaults
+#define DEFAULT_AUDIO_TARGET_LUFS           -16.0f  // Integrated loudness target
 
 // Gun FX - Smoke Defaults
 #define DEFAULT_SMOKE_FAN_OFF_DELAY_MS      2000    // 2 seconds
 #define DEFAULT_SMOKE_HEATER_THRESHOLD_US   1500    // PWM threshold
 
+// Gun FX - Sound Envelope Defaults
+#define DEFAULT_GUN_FADE_IN_MS              5       // Soft attack on trigger pull
+#define DEFAULT_GUN_FADE_OUT_MS             40      // Click-free trigger release
+#define DEFAULT_GUN_VOLUME_RAMP_MS          20
+
 // Gun FX - Serial Bus Defaults
 #define DEFAULT_SERIAL_BAUD_RATE            115200
 #define DEFAULT_SERIAL_TIMEOUT_MS           100
 
+// Input Failsafe Defaults
+#define DEFAULT_FAILSAFE_TIMEOUT_MS         500     // Receiver silence before failsafe
+
+// Input Source Defaults
+#define DEFAULT_PPM_CHANNEL                 1       // PPM signal on input channel 1
+
+// Channel Decoder Defaults
+#define DEFAULT_DECODER_POSITIONS           3       // 3-position switch
+#define DEFAULT_DECODER_BITS                2       // Two binary switches
+#define DEFAULT_DECODER_HYSTERESIS_US       20
+#define DEFAULT_DECODER_DEBOUNCE_PULSES     3
+
+// Input Filter Defaults
+#define DEFAULT_INPUT_AVG_WINDOW_PULSES     PWM_AVG_WINDOW_DEFAULT_PULSES  // 200 ms at 50 Hz
+#define LEGACY_AVG_WINDOW_FRAME_MS          20      // avg_window_ms was sized for 50 Hz frames
+
 // Servo Defaults
 #define DEFAULT_SERVO_INPUT_MIN_US          1000    // Standard RC PWM min
 #define DEFAULT_SERVO_INPUT_MAX_US          2000    // Standard RC PWM max
@@ -44,6 +74,24 @@
  * CYAML Schema Definitions
  * ============================================================================ */
 
+// InputFilterConfig schema (every stage optional)
+static const cyaml_schema_field_t input_filter_fields[] = {
+    CYAML_FIELD_INT("glitch_us", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, glitch_us),
+    CYAML_FIELD_INT("median_samples", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, median_samples),
+    CYAML_FIELD_FLOAT("ema_alpha", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, ema_alpha),
+    CYAML_FIELD_INT("rate_limit_us_per_s", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, rate_limit_us_per_s),
+    CYAML_FIELD_INT("avg_window_pulses", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, avg_window_pulses),
+    CYAML_FIELD_INT("avg_window_ms", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputFilterConfig, avg_window_ms),
+    CYAML_FIELD_END
+};
+
+// FailsafeConfig schema
+static const cyaml_schema_field_t failsafe_config_fields[] = {
+    CYAML_FIELD_INT("timeout_ms", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, FailsafeConfig, timeout_ms),
+    CYAML_FIELD_STRING_PTR("action", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, FailsafeConfig, action, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_END
+};
+
 // ServoConfig schema with defaults
 static const cyaml_schema_field_t servo_fields[] = {
     CYAML_FIELD_INT("servo_id", CYAML_FLAG_DEFAULT, ServoConfig, servo_id),
@@ -57,6 +105,7 @@ static const cyaml_schema_field_t servo_fields[] = {
     CYAML_FIELD_FLOAT("max_decel_us_per_sec2", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ServoConfig, max_decel_us_per_sec2),
     CYAML_FIELD_INT("recoil_jerk_us", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ServoConfig, recoil_jerk_us),
     CYAML_FIELD_INT("recoil_jerk_variance_us", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ServoConfig, recoil_jerk_variance_us),
+    CYAML_FIELD_MAPPING("filter", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ServoConfig, filter, input_filter_fields),
     CYAML_FIELD_END
 };
 
@@ -68,6 +117,7 @@ static const cyaml_schema_value_t servo_schema __attribute__((unused)) = {
 static const cyaml_schema_field_t engine_toggle_config_fields[] = {
     CYAML_FIELD_INT("input_channel", CYAML_FLAG_DEFAULT, EngineToggleConfig, input_channel),
     CYAML_FIELD_INT("threshold_us", CYAML_FLAG_DEFAULT, EngineToggleConfig, threshold_us),
+    CYAML_FIELD_MAPPING("filter", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, EngineToggleConfig, filter, input_filter_fields),
     CYAML_FIELD_END
 };
 
@@ -75,6 +125,17 @@ static const cyaml_schema_value_t engine_toggle_config_schema __attribute__((unu
     CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, EngineToggleConfig, engine_toggle_config_fields),
 };
 
+// RotorTachConfig schema
+static const cyaml_schema_field_t rotor_tach_config_fields[] = {
+    CYAML_FIELD_INT("input_channel", CYAML_FLAG_DEFAULT, RotorTachConfig, input_channel),
+    CYAML_FIELD_INT("pulses_per_rev", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RotorTachConfig, pulses_per_rev),
+    CYAML_FIELD_INT("nominal_rpm", CYAML_FLAG_DEFAULT, RotorTachConfig, nominal_rpm),
+    CYAML_FIELD_FLOAT("min_pitch", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RotorTachConfig, min_pitch),
+    CYAML_FIELD_FLOAT("max_pitch", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RotorTachConfig, max_pitch),
+    CYAML_FIELD_INT("window_ms", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RotorTachConfig, window_ms),
+    CYAML_FIELD_END
+};
+
 // EngineSoundsTransitionsConfig schema
 static const cyaml_schema_field_t engine_sounds_transitions_config_fields[] = {
     CYAML_FIELD_INT("starting_offset_ms", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, EngineSoundsTransitionsConfig, starting_offset_ms),
@@ -115,6 +176,7 @@ static const cyaml_schema_value_t rate_of_fire_schema = {
 // Trigger configuration schema
 static const cyaml_schema_field_t trigger_config_fields[] = {
     CYAML_FIELD_INT("input_channel", CYAML_FLAG_DEFAULT, TriggerConfig, input_channel),
+    CYAML_FIELD_MAPPING("filter", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, TriggerConfig, filter, input_filter_fields),
     CYAML_FIELD_END
 };
 
@@ -127,6 +189,7 @@ static const cyaml_schema_field_t smoke_config_fields[] = {
     CYAML_FIELD_INT("heater_toggle_channel", CYAML_FLAG_DEFAULT, SmokeConfig, heater_toggle_channel),
     CYAML_FIELD_INT("heater_pwm_threshold_us", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, SmokeConfig, heater_pwm_threshold_us),
     CYAML_FIELD_INT("fan_off_delay_ms", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, SmokeConfig, fan_off_delay_ms),
+    CYAML_FIELD_MAPPING("filter", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, SmokeConfig, filter, input_filter_fields),
     CYAML_FIELD_END
 };
 
@@ -150,6 +213,8 @@ static const cyaml_schema_field_t engine_fx_fields[] = {
     CYAML_FIELD_STRING_PTR("type", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, EngineFXConfig, type, 0, CYAML_UNLIMITED),
     CYAML_FIELD_MAPPING("engine_toggle", CYAML_FLAG_DEFAULT, EngineFXConfig, engine_toggle, engine_toggle_config_fields),
     CYAML_FIELD_MAPPING("sounds", CYAML_FLAG_DEFAULT, EngineFXConfig, sounds, engine_sounds_config_fields),
+    CYAML_FIELD_MAPPING("failsafe", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, EngineFXConfig, failsafe, failsafe_config_fields),
+    CYAML_FIELD_MAPPING("rotor_tach", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, EngineFXConfig, rotor_tach, rotor_tach_config_fields),
     CYAML_FIELD_END
 };
 
@@ -157,11 +222,23 @@ static const cyaml_schema_value_t engine_fx_schema __attribute__((unused)) = {
     CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, EngineFXConfig, engine_fx_fields),
 };
 
+// SoundEnvelopeConfig schema
+static const cyaml_schema_field_t sound_envelope_config_fields[] = {
+    // Parsed as pointers so an explicit 0 (hard start / stop) is told apart from a missing key
+    CYAML_FIELD_INT_PTR("fade_in_ms", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, SoundEnvelopeConfig, fade_in_ms_set),
+    CYAML_FIELD_INT_PTR("fade_out_ms", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, SoundEnvelopeConfig, fade_out_ms_set),
+    CYAML_FIELD_INT_PTR("volume_ramp_ms", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, SoundEnvelopeConfig, volume_ramp_ms_set),
+    CYAML_FIELD_STRING_PTR("release_tail", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, SoundEnvelopeConfig, release_tail, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_END
+};
+
 // GunFXConfig schema
 static const cyaml_schema_field_t gun_fx_fields[] = {
     CYAML_FIELD_MAPPING("trigger", CYAML_FLAG_DEFAULT, GunFXConfig, trigger, trigger_config_fields),
     CYAML_FIELD_MAPPING("smoke", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, GunFXConfig, smoke, smoke_config_fields),
     CYAML_FIELD_MAPPING("turret_control", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, GunFXConfig, turret_control, turret_control_config_fields),
+    CYAML_FIELD_MAPPING("envelope", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, GunFXConfig, envelope, sound_envelope_config_fields),
+    CYAML_FIELD_MAPPING("failsafe", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, GunFXConfig, failsafe, failsafe_config_fields),
     CYAML_FIELD_SEQUENCE_COUNT("rates_of_fire", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, GunFXConfig, rates, rate_count, &rate_of_fire_schema, 0, CYAML_UNLIMITED),
     CYAML_FIELD_END
 };
@@ -170,10 +247,62 @@ static const cyaml_schema_value_t gun_fx_schema __attribute__((unused)) = {
     CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, GunFXConfig, gun_fx_fields),
 };
 
+// AudioConfig schema
+static const cyaml_schema_field_t audio_config_fields[] = {
+    CYAML_FIELD_STRING_PTR("asset_storage", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, AudioConfig, asset_storage, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_BOOL("normalize", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, AudioConfig, normalize),
+    CYAML_FIELD_FLOAT("target_lufs", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, AudioConfig, target_lufs),
+    CYAML_FIELD_END
+};
+
+// ChannelDecoderConfig schema
+static const cyaml_schema_field_t channel_decoder_fields[] = {
+    CYAML_FIELD_INT("input_channel", CYAML_FLAG_DEFAULT, ChannelDecoderConfig, input_channel),
+    CYAML_FIELD_STRING_PTR("type", CYAML_FLAG_POINTER, ChannelDecoderConfig, type, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_INT("positions", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ChannelDecoderConfig, positions),
+    CYAML_FIELD_INT("bits", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ChannelDecoderConfig, bits),
+    CYAML_FIELD_INT("output_channel", CYAML_FLAG_DEFAULT, ChannelDecoderConfig, output_channel),
+    CYAML_FIELD_INT("hysteresis_us", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ChannelDecoderConfig, hysteresis_us),
+    CYAML_FIELD_INT("debounce_pulses", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ChannelDecoderConfig, debounce_pulses),
+    CYAML_FIELD_END
+};
+
+static const cyaml_schema_value_t channel_decoder_schema = {
+    CYAML_VALUE_MAPPING(CYAML_FLAG_DEFAULT, ChannelDecoderConfig, channel_decoder_fields),
+};
 
+// InputConfig schema
+static const cyaml_schema_field_t input_config_fields[] = {
+    CYAML_FIELD_STRING_PTR("source", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, InputConfig, source, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_STRING_PTR("device", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, InputConfig, device, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_INT("ppm_channel", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, InputConfig, ppm_channel),
+    CYAML_FIELD_STRING_PTR("calibration", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, InputConfig, calibration, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_SEQUENCE_COUNT("decoders", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, InputConfig, decoders, decoder_count, &channel_decoder_schema, 0, INPUT_MAX_DECODERS),
+    CYAML_FIELD_END
+};
+
+// RealtimeConfig schema
+static const cyaml_schema_field_t realtime_thread_config_fields[] = {
+    CYAML_FIELD_STRING_PTR("policy", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, RealtimeThreadConfig, policy, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_INT("priority", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeThreadConfig, priority),
+    CYAML_FIELD_STRING_PTR("cpus", CYAML_FLAG_POINTER | CYAML_FLAG_OPTIONAL, RealtimeThreadConfig, cpus, 0, CYAML_UNLIMITED),
+    CYAML_FIELD_END
+};
+
+static const cyaml_schema_field_t realtime_config_fields[] = {
+    CYAML_FIELD_BOOL("lock_memory", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeConfig, lock_memory),
+    CYAML_FIELD_MAPPING("input", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeConfig, input, realtime_thread_config_fields),
+    CYAML_FIELD_MAPPING("audio", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeConfig, audio, realtime_thread_config_fields),
+    CYAML_FIELD_MAPPING("engine", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeConfig, engine, realtime_thread_config_fields),
+    CYAML_FIELD_MAPPING("gun", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, RealtimeConfig, gun, realtime_thread_config_fields),
+    CYAML_FIELD_END
+};
 
 // Root ScaleFXConfig schema
 static const cyaml_schema_field_t scalefx_config_fields[] = {
+    CYAML_FIELD_MAPPING("audio", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ScaleFXConfig, audio, audio_config_fields),
+    CYAML_FIELD_MAPPING("inputs", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ScaleFXConfig, inputs, input_config_fields),
+    CYAML_FIELD_MAPPING("realtime", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ScaleFXConfig, realtime, realtime_config_fields),
     // Make both modules optional; missing sections imply disabled
     CYAML_FIELD_MAPPING("engine_fx", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ScaleFXConfig, engine, engine_fx_fields),
     CYAML_FIELD_MAPPING("gun_fx", CYAML_FLAG_DEFAULT | CYAML_FLAG_OPTIONAL, ScaleFXConfig, gun, gun_fx_fields),
@@ -202,16 +331,63 @@ static const cyaml_config_t cyaml_config = {
 #define APPLY_DEFAULT_IF_ZERO(field, default_value) \
     if ((field) == 0) (field) = (default_value)
 
+// Resolve a field parsed as an optional pointer, where 0 is a valid setting
+#define APPLY_DEFAULT_IF_UNSET(field, parsed, default_value) \
+    (field) = (parsed) ? *(parsed) : (default_value)
+
+static void apply_filter_defaults(InputFilterConfig *filter) {
+    // Older configs give the window in ms; keep their length at the 50 Hz frame it was tuned for
+    if (filter->avg_window_pulses == 0 && filter->avg_window_ms > 0) {
+        filter->avg_window_pulses = (filter->avg_window_ms + LEGACY_AVG_WINDOW_FRAME_MS - 1) / LEGACY_AVG_WINDOW_FRAME_MS;
+    }
+    APPLY_DEFAULT_IF_ZERO(filter->avg_window_pulses, DEFAULT_INPUT_AVG_WINDOW_PULSES);
+}
+
 static inline void apply_defaults_inline(ScaleFXConfig *config) {
+    // Audio defaults
+    if (config->audio.target_lufs == 0.0f)
+        config->audio.target_lufs = DEFAULT_AUDIO_TARGET_LUFS;
+    
+    // Input source defaults
+    APPLY_DEFAULT_IF_ZERO(config->inputs.ppm_channel, DEFAULT_PPM_CHANNEL);
+    for (int i = 0; i < config->inputs.decoder_count; i++) {
+        ChannelDecoderConfig *dec = &config->inputs.decoders[i];
+        APPLY_DEFAULT_IF_ZERO(dec->positions, DEFAULT_DECODER_POSITIONS);
+        APPLY_DEFAULT_IF_ZERO(dec->bits, DEFAULT_DECODER_BITS);
+        APPLY_DEFAULT_IF_ZERO(dec->hysteresis_us, DEFAULT_DECODER_HYSTERESIS_US);
+        APPLY_DEFAULT_IF_ZERO(dec->debounce_pulses, DEFAULT_DECODER_DEBOUNCE_PULSES);
+    }
+    
+    // Input filter defaults
+    apply_filter_defaults(&config->engine.engine_toggle.filter);
+    apply_filter_defaults(&config->gun.trigger.filter);
+    apply_filter_defaults(&config->gun.smoke.filter);
+    apply_filter_defaults(&config->gun.turret_control.pitch.filter);
+    apply_filter_defaults(&config->gun.turret_control.yaw.filter);
+    
+    // Failsafe defaults
+    APPLY_DEFAULT_IF_ZERO(config->engine.failsafe.timeout_ms, DEFAULT_FAILSAFE_TIMEOUT_MS);
+    APPLY_DEFAULT_IF_ZERO(config->gun.failsafe.timeout_ms, DEFAULT_FAILSAFE_TIMEOUT_MS);
+    
     // Engine defaults
     APPLY_DEFAULT_IF_ZERO(config->engine.engine_toggle.threshold_us, DEFAULT_ENGINE_THRESHOLD_US);
     APPLY_DEFAULT_IF_ZERO(config->engine.sounds.transitions.starting_offset_ms, DEFAULT_ENGINE_STARTING_OFFSET_MS);
     APPLY_DEFAULT_IF_ZERO(config->engine.sounds.transitions.stopping_offset_ms, DEFAULT_ENGINE_STOPPING_OFFSET_MS);
+    APPLY_DEFAULT_IF_ZERO(config->engine.rotor_tach.pulses_per_rev, DEFAULT_ROTOR_PULSES_PER_REV);
+    APPLY_DEFAULT_IF_ZERO(config->engine.rotor_tach.min_pitch, DEFAULT_ROTOR_MIN_PITCH);
+    APPLY_DEFAULT_IF_ZERO(config->engine.rotor_tach.max_pitch, DEFAULT_ROTOR_MAX_PITCH);
+    APPLY_DEFAULT_IF_ZERO(config->engine.rotor_tach.window_ms, DEFAULT_ROTOR_WINDOW_MS);
     
     // Gun - Smoke defaults
     APPLY_DEFAULT_IF_ZERO(config->gun.smoke.heater_pwm_threshold_us, DEFAULT_SMOKE_HEATER_THRESHOLD_US);
     APPLY_DEFAULT_IF_ZERO(config->gun.smoke.fan_off_delay_ms, DEFAULT_SMOKE_FAN_OFF_DELAY_MS);
     
+    // Gun - Sound envelope defaults
+    SoundEnvelopeConfig *envelope = &config->gun.envelope;
+    APPLY_DEFAULT_IF_UNSET(envelope->fade_in_ms, envelope->fade_in_ms_set, DEFAULT_GUN_FADE_IN_MS);
+    APPLY_DEFAULT_IF_UNSET(envelope->fade_out_ms, envelope->fade_out_ms_set, DEFAULT_GUN_FADE_OUT_MS);
+    APPLY_DEFAULT_IF_UNSET(envelope->volume_ramp_ms, envelope->volume_ramp_ms_set, DEFAULT_GUN_VOLUME_RAMP_MS);
+    
     // Gun - Pitch servo defaults
     APPLY_DEFAULT_IF_ZERO(config->gun.turret_control.pitch.input_min_us, DEFAULT_SERVO_INPUT_MIN_US);
     APPLY_DEFAULT_IF_ZERO(config->gun.turret_control.pitch.input_max_us, DEFAULT_SERVO_INPUT_MAX_US);
@@ -285,12 +461,225 @@ void config_free(ScaleFXConfig *config) {
     }
 }
 
+static bool is_valid_input_channel(int channel, int max_channel) {
+    return channel >= INPUT_CHANNEL_MIN && channel <= max_channel;
+}
+
+static int decoder_output_count(const ChannelDecoderConfig *dec) {
+    return dec->type && strcmp(dec->type, "mux") == 0 ? dec->bits : 1;
+}
+
+// FX inputs may also use the virtual channels published by a decoder
+static bool is_valid_fx_channel(const InputConfig *inputs, int channel, int max_channel) {
+    for (int i = 0; i < inputs->decoder_count; i++) {
+        if (channel == inputs->decoders[i].input_channel) {
+            LOG_ERROR(LOG_CONFIG, "Input channel %d is decoded; use the decoder output channels", channel);
+            return false;
+        }
+    }
+    if (is_valid_input_channel(channel, max_channel)) return true;
+    for (int i = 0; i < inputs->decoder_count; i++) {
+        const ChannelDecoderConfig *dec = &inputs->decoders[i];
+        if (channel >= dec->output_channel && channel < dec->output_channel + decoder_output_count(dec)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int validate_decoders(const InputConfig *inputs, int max_channel) {
+    for (int i = 0; i < inputs->decoder_count; i++) {
+        const ChannelDecoderConfig *dec = &inputs->decoders[i];
+        ChannelDecoderType type;
+        if (!is_valid_input_channel(dec->input_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid decoder input_channel: %d (must be 1-%d)", dec->input_channel, max_channel);
+            return -1;
+        }
+        if (channel_decoder_type_from_string(dec->type, &type) != 0) {
+            LOG_ERROR(LOG_CONFIG, "Invalid decoder type on channel %d: %s (must be switch or mux)",
+                      dec->input_channel, dec->type ? dec->type : "(none)");
+            return -1;
+        }
+
+        int levels;
+        if (type == CHANNEL_DECODER_SWITCH) {
+            if (dec->positions < 2 || dec->positions > CHANNEL_DECODER_MAX_POSITIONS) {
+                LOG_ERROR(LOG_CONFIG, "Invalid decoder positions on channel %d: %d (must be 2-%d)",
+                          dec->input_channel, dec->positions, CHANNEL_DECODER_MAX_POSITIONS);
+                return -1;
+            }
+            levels = dec->positions;
+        } else {
+            if (dec->bits < 1 || dec->bits > CHANNEL_DECODER_MAX_BITS) {
+                LOG_ERROR(LOG_CONFIG, "Invalid decoder bits on channel %d: %d (must be 1-%d)",
+                          dec->input_channel, dec->bits, CHANNEL_DECODER_MAX_BITS);
+                return -1;
+            }
+            levels = 1 << dec->bits;
+        }
+
+        int first = dec->output_channel;
+        int last = first + decoder_output_count(dec) - 1;
+        if (first < VIRTUAL_CHANNEL_MIN || last > VIRTUAL_CHANNEL_MAX) {
+            LOG_ERROR(LOG_CONFIG, "Invalid decoder output_channel on channel %d: %d-%d (must be within %d-%d)",
+                      dec->input_channel, first, last, VIRTUAL_CHANNEL_MIN, VIRTUAL_CHANNEL_MAX);
+            return -1;
+        }
+        for (int j = 0; j < i; j++) {
+            const ChannelDecoderConfig *other = &inputs->decoders[j];
+            if (first < other->output_channel + decoder_output_count(other) && other->output_channel <= last) {
+                LOG_ERROR(LOG_CONFIG, "Decoder outputs %d-%d overlap another decoder", first, last);
+                return -1;
+            }
+        }
+
+        // Levels are at least this far apart over the nominal 1000 µs travel
+        int half_step_us = (CHANNEL_DECODER_OUTPUT_MAX_US - CHANNEL_DECODER_OUTPUT_MIN_US) / (2 * (levels - 1));
+        if (dec->hysteresis_us < 0 || dec->hysteresis_us >= half_step_us) {
+            LOG_ERROR(LOG_CONFIG, "Invalid decoder hysteresis_us on channel %d: %d (must be 0-%d for %d levels)",
+                      dec->input_channel, dec->hysteresis_us, half_step_us - 1, levels);
+            return -1;
+        }
+        if (dec->debounce_pulses < 1) {
+            LOG_ERROR(LOG_CONFIG, "Invalid decoder debounce_pulses on channel %d: %d (must be >= 1)",
+                      dec->input_channel, dec->debounce_pulses);
+            return -1;
+        }
+    }
+    return 0;
+}
+
+// The tachometer is a dedicated GPIO pin whatever the input source
+static int validate_rotor_tach(const ScaleFXConfig *config) {
+    const RotorTachConfig *tach = &config->engine.rotor_tach;
+    if (tach->input_channel == 0) return 0;
+
+    if (!is_valid_channel(tach->input_channel)) {
+        LOG_ERROR(LOG_CONFIG, "Invalid rotor_tach input_channel: %d (must be 1-%d)",
+                  tach->input_channel, INPUT_CHANNEL_MAX);
+        return -1;
+    }
+    bool gpio_inputs = !config->inputs.source || strcmp(config->inputs.source, "pwm") == 0;
+    bool ppm = config->inputs.source && strcmp(config->inputs.source, "ppm") == 0;
+    if (ppm && tach->input_channel == config->inputs.ppm_channel) {
+        LOG_ERROR(LOG_CONFIG, "rotor_tach input_channel %d is already used as the PPM input", tach->input_channel);
+        return -1;
+    }
+    if (gpio_inputs) {
+        // Every RC input owns a GPIO pin in PWM mode (decoder outputs are virtual)
+        const struct { const char *name; int channel; } rc_inputs[] = {
+            { "engine_toggle", config->engine.engine_toggle.input_channel },
+            { "gun trigger", config->gun.trigger.input_channel },
+            { "smoke heater_toggle_channel", config->gun.smoke.heater_toggle_channel },
+            { "turret pitch", config->gun.turret_control.pitch.input_channel },
+            { "turret yaw", config->gun.turret_control.yaw.input_channel },
+        };
+        for (size_t i = 0; i < sizeof(rc_inputs) / sizeof(rc_inputs[0]); i++) {
+            if (tach->input_channel == rc_inputs[i].channel) {
+                LOG_ERROR(LOG_CONFIG, "rotor_tach input_channel %d is already used by %s",
+                          tach->input_channel, rc_inputs[i].name);
+                return -1;
+            }
+        }
+        for (int i = 0; i < config->inputs.decoder_count; i++) {
+            if (tach->input_channel == config->inputs.decoders[i].input_channel) {
+                LOG_ERROR(LOG_CONFIG, "rotor_tach input_channel %d is already used as a decoder input",
+                          tach->input_channel);
+                return -1;
+            }
+        }
+    }
+    if (tach->pulses_per_rev < 1) {
+        LOG_ERROR(LOG_CONFIG, "Invalid rotor_tach pulses_per_rev: %d (must be >= 1)", tach->pulses_per_rev);
+        return -1;
+    }
+    if (tach->nominal_rpm <= 0 ||
+        (long)tach->nominal_rpm * tach->pulses_per_rev > (long)TACH_MAX_HZ * 60) {
+        LOG_ERROR(LOG_CONFIG, "Invalid rotor_tach nominal_rpm: %d (must be > 0 and within %d Hz of sensor pulses)",
+                  tach->nominal_rpm, TACH_MAX_HZ);
+        return -1;
+    }
+    if (tach->min_pitch <= 0.0f || tach->max_pitch < tach->min_pitch) {
+        LOG_ERROR(LOG_CONFIG, "Invalid rotor_tach pitch range: %.2f-%.2f", tach->min_pitch, tach->max_pitch);
+        return -1;
+    }
+    if (tach->window_ms < 1 || tach->window_ms > TACH_WINDOW_MAX_MS) {
+        LOG_ERROR(LOG_CONFIG, "Invalid rotor_tach window_ms: %d (must be 1-%d)", tach->window_ms, TACH_WINDOW_MAX_MS);
+        return -1;
+    }
+    return 0;
+}
+
+static int validate_realtime_thread(const char *role, const RealtimeThreadConfig *cfg) {
+    if (!cfg->policy || strcmp(cfg->policy, "other") == 0) {
+        return 0;
+    }
+    if (strcmp(cfg->policy, "fifo") != 0 && strcmp(cfg->policy, "rr") != 0) {
+        LOG_ERROR(LOG_CONFIG, "Invalid realtime.%s policy: %s (must be fifo, rr or other)", role, cfg->policy);
+        return -1;
+    }
+    if (cfg->priority < 1 || cfg->priority > 99) {
+        LOG_ERROR(LOG_CONFIG, "Invalid realtime.%s priority: %d (must be 1-99)", role, cfg->priority);
+        return -1;
+    }
+    return 0;
+}
+
 int config_validate(const ScaleFXConfig *config) {
     if (!config) {
         LOG_ERROR(LOG_CONFIG, "Validation failed: nullptr config");
         return -1;
     }
 
+    // Audio asset storage (optional)
+    if (config->audio.asset_storage &&
+        strcmp(config->audio.asset_storage, "pcm") != 0 &&
+        strcmp(config->audio.asset_storage, "adpcm") != 0) {
+        LOG_ERROR(LOG_CONFIG, "Invalid audio asset_storage: %s (must be pcm or adpcm)",
+                  config->audio.asset_storage);
+        return -1;
+    }
+
+    // Real-time scheduling (optional)
+    if (validate_realtime_thread("input", &config->realtime.input) != 0 ||
+        validate_realtime_thread("audio", &config->realtime.audio) != 0 ||
+        validate_realtime_thread("engine", &config->realtime.engine) != 0 ||
+        validate_realtime_thread("gun", &config->realtime.gun) != 0) {
+        return -1;
+    }
+
+    // Input source (optional, defaults to GPIO PWM)
+    int max_channel = INPUT_CHANNEL_MAX;
+    if (config->inputs.source && strcmp(config->inputs.source, "ppm") == 0) {
+        if (!is_valid_channel(config->inputs.ppm_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid inputs ppm_channel: %d (must be 1-%d)",
+                      config->inputs.ppm_channel, INPUT_CHANNEL_MAX);
+            return -1;
+        }
+        // Channels now refer to PPM frame slots
+        max_channel = PPM_MAX_CHANNELS;
+    } else if (config->inputs.source && strcmp(config->inputs.source, "pwm") != 0) {
+        bool pico = strcmp(config->inputs.source, "pico") == 0;
+        if (!pico &&
+            strcmp(config->inputs.source, "sbus") != 0 &&
+            strcmp(config->inputs.source, "ibus") != 0 &&
+            strcmp(config->inputs.source, "crsf") != 0) {
+            LOG_ERROR(LOG_CONFIG, "Invalid inputs source: %s (must be pwm, ppm, sbus, ibus, crsf or pico)",
+                      config->inputs.source);
+            return -1;
+        }
+        if (!config->inputs.device || config->inputs.device[0] == '\0') {
+            LOG_ERROR(LOG_CONFIG, "inputs.device is required for %s input", config->inputs.source);
+            return -1;
+        }
+        // Serial receivers carry up to 16 channels, Pico capture frames up to 8
+        max_channel = pico ? RC_PICO_MAX_CHANNELS : RC_RECEIVER_MAX_CHANNELS;
+    }
+
+    if (validate_decoders(&config->inputs, max_channel) != 0) {
+        return -1;
+    }
+
     // Detect if engine section is present (optional)
     bool engine_present = (config->engine.engine_toggle.input_channel != 0) ||
                           (config->engine.sounds.starting != NULL) ||
@@ -299,12 +688,15 @@ int config_validate(const ScaleFXConfig *config) {
 
     // Engine validation (only if present)
     if (engine_present) {
-        if (!is_valid_channel(config->engine.engine_toggle.input_channel)) {
-            LOG_ERROR(LOG_CONFIG, "Invalid engine input_channel: %d (must be 1-10)", 
-                      config->engine.engine_toggle.input_channel);
+        if (!is_valid_fx_channel(&config->inputs, config->engine.engine_toggle.input_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid engine input_channel: %d (must be 1-%d or a decoder output)", 
+                      config->engine.engine_toggle.input_channel, max_channel);
             return -1;
         }
         // Engine sounds are optional; no strict validation
+        if (validate_rotor_tach(config) != 0) {
+            return -1;
+        }
     }
 
     // Detect if gun section is present (optional)
@@ -316,17 +708,17 @@ int config_validate(const ScaleFXConfig *config) {
 
     // Gun validation (only if present)
     if (gun_present) {
-        if (!is_valid_channel(config->gun.trigger.input_channel)) {
-            LOG_ERROR(LOG_CONFIG, "Invalid gun trigger input_channel: %d (must be 1-10)", 
-                      config->gun.trigger.input_channel);
+        if (!is_valid_fx_channel(&config->inputs, config->gun.trigger.input_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid gun trigger input_channel: %d (must be 1-%d or a decoder output)", 
+                      config->gun.trigger.input_channel, max_channel);
             return -1;
         }
         
         // Validate smoke heater channel if present
         if (config->gun.smoke.heater_toggle_channel != 0 && 
-            !is_valid_channel(config->gun.smoke.heater_toggle_channel)) {
-            LOG_ERROR(LOG_CONFIG, "Invalid smoke heater_toggle_channel: %d (must be 1-10)", 
-                      config->gun.smoke.heater_toggle_channel);
+            !is_valid_fx_channel(&config->inputs, config->gun.smoke.heater_toggle_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid smoke heater_toggle_channel: %d (must be 1-%d or a decoder output)", 
+                      config->gun.smoke.heater_toggle_channel, max_channel);
             return -1;
         }
         // Serial bus is auto-detected over USB; no config validation needed
@@ -334,9 +726,9 @@ int config_validate(const ScaleFXConfig *config) {
 
     // Validate servo inputs and servo_id (outputs handled by Pico)
     if (config->gun.turret_control.pitch.input_channel > 0) {
-        if (!is_valid_channel(config->gun.turret_control.pitch.input_channel)) {
-            LOG_ERROR(LOG_CONFIG, "Invalid pitch input_channel: %d (must be 1-10)",
-                      config->gun.turret_control.pitch.input_channel);
+        if (!is_valid_fx_channel(&config->inputs, config->gun.turret_control.pitch.input_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid pitch input_channel: %d (must be 1-%d or a decoder output)",
+                      config->gun.turret_control.pitch.input_channel, max_channel);
             return -1;
         }
         if (config->gun.turret_control.pitch.servo_id <= 0) {
@@ -345,9 +737,9 @@ int config_validate(const ScaleFXConfig *config) {
         }
     }
     if (config->gun.turret_control.yaw.input_channel > 0) {
-        if (!is_valid_channel(config->gun.turret_control.yaw.input_channel)) {
-            LOG_ERROR(LOG_CONFIG, "Invalid yaw input_channel: %d (must be 1-10)",
-                      config->gun.turret_control.yaw.input_channel);
+        if (!is_valid_fx_channel(&config->inputs, config->gun.turret_control.yaw.input_channel, max_channel)) {
+            LOG_ERROR(LOG_CONFIG, "Invalid yaw input_channel: %d (must be 1-%d or a decoder output)",
+                      config->gun.turret_control.yaw.input_channel, max_channel);
             return -1;
         }
         if (config->gun.turret_control.yaw.servo_id <= 0) {
@@ -356,6 +748,61 @@ int config_validate(const ScaleFXConfig *config) {
         }
     }
     
+    // Validate input filters
+    const struct { const char *name; const InputFilterConfig *filter; } filters[] = {
+        { "engine_toggle", &config->engine.engine_toggle.filter },
+        { "trigger", &config->gun.trigger.filter },
+        { "smoke", &config->gun.smoke.filter },
+        { "pitch", &config->gun.turret_control.pitch.filter },
+        { "yaw", &config->gun.turret_control.yaw.filter },
+    };
+    for (size_t i = 0; i < sizeof(filters) / sizeof(filters[0]); i++) {
+        const InputFilterConfig *f = filters[i].filter;
+        if (f->median_samples < 0 || f->median_samples > PWM_FILTER_MAX_MEDIAN) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s filter median_samples: %d (must be 0-%d)",
+                      filters[i].name, f->median_samples, PWM_FILTER_MAX_MEDIAN);
+            return -1;
+        }
+        if (f->ema_alpha < 0.0f || f->ema_alpha >= 1.0f) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s filter ema_alpha: %.2f (must be 0 to <1)",
+                      filters[i].name, f->ema_alpha);
+            return -1;
+        }
+        if (f->glitch_us < 0 || f->rate_limit_us_per_s < 0) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s filter: glitch_us/rate_limit_us_per_s must be >= 0", filters[i].name);
+            return -1;
+        }
+        if (f->avg_window_pulses < 1 || f->avg_window_pulses > PWM_AVG_MAX_SAMPLES) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s filter avg_window_pulses: %d (must be 1-%d)",
+                      filters[i].name, f->avg_window_pulses, PWM_AVG_MAX_SAMPLES);
+            return -1;
+        }
+    }
+    
+    // Validate gun sound envelope (0 = hard start / stop / no smoothing)
+    const SoundEnvelopeConfig *envelope = &config->gun.envelope;
+    if (envelope->fade_in_ms < 0 || envelope->fade_out_ms < 0 || envelope->volume_ramp_ms < 0) {
+        LOG_ERROR(LOG_CONFIG, "Invalid gun envelope: fade_in_ms/fade_out_ms/volume_ramp_ms must be >= 0");
+        return -1;
+    }
+    
+    // Validate failsafe actions
+    const FailsafeConfig *failsafes[] = { &config->engine.failsafe, &config->gun.failsafe };
+    for (size_t i = 0; i < 2; i++) {
+        const char *action = failsafes[i]->action;
+        if (action && strcmp(action, "hold") != 0 && strcmp(action, "neutral") != 0 &&
+            strcmp(action, "stop") != 0) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s failsafe action: %s (must be hold, neutral or stop)",
+                      i == 0 ? "engine" : "gun", action);
+            return -1;
+        }
+        if (failsafes[i]->timeout_ms < 50) {
+            LOG_ERROR(LOG_CONFIG, "Invalid %s failsafe timeout_ms: %d (must be >= 50)",
+                      i == 0 ? "engine" : "gun", failsafes[i]->timeout_ms);
+            return -1;
+        }
+    }
+    
     // Validate rates of fire
     if (config->gun.rate_count > 0 && !config->gun.rates) {
         LOG_ERROR(LOG_CONFIG, "Invalid rates of fire configuration");
@@ -366,6 +813,38 @@ int config_validate(const ScaleFXConfig *config) {
     return 0;
 }
 
+int config_monitor_count(const ScaleFXConfig *config) {
+    const int fx_channels[] = {
+        config->engine.engine_toggle.input_channel,
+        config->gun.trigger.input_channel,
+        config->gun.smoke.heater_toggle_channel,
+        config->gun.turret_control.pitch.input_channel,
+        config->gun.turret_control.yaw.input_channel,
+    };
+    int count = 0;
+    for (size_t i = 0; i < sizeof(fx_channels) / sizeof(fx_channels[0]); i++) {
+        if (fx_channels[i] > 0) count++;
+    }
+    if (config->inputs.source && strcmp(config->inputs.source, "ppm") == 0) {
+        count++;
+    }
+    for (int i = 0; i < config->inputs.decoder_count; i++) {
+        count += 1 + decoder_output_count(&config->inputs.decoders[i]);
+    }
+    if (config->engine.rotor_tach.input_channel > 0) {
+        count++;
+    }
+    return count;
+}
+
+FailsafeAction config_failsafe_action(const FailsafeConfig *config, FailsafeAction default_action) {
+    if (!config || !config->action) return default_action;
+    if (strcmp(config->action, "hold") == 0) return FAILSAFE_HOLD;
+    if (strcmp(config->action, "neutral") == 0) return FAILSAFE_NEUTRAL;
+    if (strcmp(config->action, "stop") == 0) return FAILSAFE_STOP;
+    return default_action;
+}
+
 void config_print(const ScaleFXConfig *config) {
     if (!config) {
         LOG_ERROR(LOG_CONFIG, "Cannot print nullptr config");
@@ -387,6 +866,61 @@ void config_print(const ScaleFXConfig *config) {
     printf(COLOR_CYAN COLOR_BOLD "╚════════════════════════════════════════════════════════════════╝\n" COLOR_RESET);
     printf("\n");
     
+    // Audio assets
+    printf(COLOR_GREEN "✓ Audio" COLOR_RESET " | Asset storage: %s",
+           config->audio.asset_storage ? config->audio.asset_storage : "pcm");
+    if (config->audio.normalize) {
+        printf(", Normalize: %.1f LUFS", config->audio.target_lufs);
+    }
+    printf("\n\n");
+
+    // Input source
+    if (config->inputs.source && strcmp(config->inputs.source, "ppm") == 0) {
+        printf(COLOR_GREEN "✓ Inputs" COLOR_RESET " | PPM on channel %d (GPIO %d)\n",
+               config->inputs.ppm_channel, channel_to_gpio(config->inputs.ppm_channel));
+    } else if (config->inputs.source && strcmp(config->inputs.source, "pwm") != 0) {
+        printf(COLOR_GREEN "✓ Inputs" COLOR_RESET " | Serial receiver: %s on %s\n",
+               config->inputs.source, config->inputs.device);
+    } else {
+        printf(COLOR_GREEN "✓ Inputs" COLOR_RESET " | GPIO PWM\n");
+    }
+    for (int i = 0; i < config->inputs.decoder_count; i++) {
+        const ChannelDecoderConfig *dec = &config->inputs.decoders[i];
+        if (strcmp(dec->type, "mux") == 0) {
+            printf("    • Channel %d: %d-switch mux -> channels %d-%d\n", dec->input_channel,
+                   dec->bits, dec->output_channel, dec->output_channel + dec->bits - 1);
+        } else {
+            printf("    • Channel %d: %d-position switch -> channel %d\n", dec->input_channel,
+                   dec->positions, dec->output_channel);
+        }
+    }
+    printf("\n");
+    
+    // Real-time scheduling (only shown when configured)
+    const RealtimeConfig *rt = &config->realtime;
+    const struct { const char *name; const RealtimeThreadConfig *cfg; } rt_roles[] = {
+        { "input", &rt->input }, { "audio", &rt->audio }, { "engine", &rt->engine }, { "gun", &rt->gun },
+    };
+    bool rt_present = rt->lock_memory;
+    for (size_t i = 0; i < sizeof(rt_roles) / sizeof(rt_roles[0]); i++) {
+        if ((rt_roles[i].cfg->policy && strcmp(rt_roles[i].cfg->policy, "other") != 0) || rt_roles[i].cfg->cpus) {
+            rt_present = true;
+        }
+    }
+    if (rt_present) {
+        printf(COLOR_GREEN "✓ Realtime" COLOR_RESET " | Memory lock: %s\n", rt->lock_memory ? "yes" : "no");
+        for (size_t i = 0; i < sizeof(rt_roles) / sizeof(rt_roles[0]); i++) {
+            const RealtimeThreadConfig *cfg = rt_roles[i].cfg;
+            if (!cfg->policy && !cfg->cpus) continue;
+            printf("  %-6s : %s", rt_roles[i].name, cfg->policy ? cfg->policy : "other");
+            if (cfg->policy && strcmp(cfg->policy, "other") != 0) {
+                printf(" %d", cfg->priority);
+            }
+            printf(", CPUs %s\n", cfg->cpus ? cfg->cpus : "any");
+        }
+        printf("\n");
+    }
+
     // Engine FX (optional)
     bool engine_present = (config->engine.engine_toggle.input_channel != 0) ||
                           (config->engine.sounds.starting != NULL) ||
@@ -410,6 +944,16 @@ void config_print(const ScaleFXConfig *config) {
         if (config->engine.sounds.stopping) printf("[STOP]");
         printf("\n");
     }
+    printf("    Failsafe: Timeout=%d ms, Action=%s\n",
+           config->engine.failsafe.timeout_ms,
+           config->engine.failsafe.action ? config->engine.failsafe.action : "hold");
+    if (config->engine.rotor_tach.input_channel > 0) {
+        printf("    Rotor tach: Channel %d (GPIO %d), %d pulse(s)/rev, nominal %d RPM, pitch %.2f-%.2f\n",
+               config->engine.rotor_tach.input_channel,
+               channel_to_gpio(config->engine.rotor_tach.input_channel),
+               config->engine.rotor_tach.pulses_per_rev, config->engine.rotor_tach.nominal_rpm,
+               config->engine.rotor_tach.min_pitch, config->engine.rotor_tach.max_pitch);
+    }
     printf("\n");
     } else {
         printf(COLOR_YELLOW "✗ Engine FX" COLOR_RESET " (disabled)\n\n");
@@ -471,6 +1015,18 @@ void config_print(const ScaleFXConfig *config) {
         }
     }
     
+    // Sound envelope
+    printf("    " COLOR_MAGENTA "Envelope" COLOR_RESET ": Fade_in=%d ms, Fade_out=%d ms, Volume_ramp=%d ms%s\n",
+           config->gun.envelope.fade_in_ms,
+           config->gun.envelope.fade_out_ms,
+           config->gun.envelope.volume_ramp_ms,
+           config->gun.envelope.release_tail ? ", Release tail" : "");
+    
+    // Failsafe
+    printf("    " COLOR_MAGENTA "Failsafe" COLOR_RESET ": Timeout=%d ms, Action=%s\n",
+           config->gun.failsafe.timeout_ms,
+           config->gun.failsafe.action ? config->gun.failsafe.action : "stop");
+    
     // Rates of Fire
     if (config->gun.rate_count > 0) {
         printf("    " COLOR_YELLOW "Rates of Fire" COLOR_RESET ":\n");
@@ -1,5 +1,7 @@
 #include "engine_fx.h"
 #include "gpio.h"
+#include "input.h"
+#include "rt_sched.h"
 #include "audio_player.h"
 #include "config_loader.h"
 #include "logging.h"
@@ -8,6 +10,17 @@
 #include <stdatomic.h>
 #include <threads.h>
 #include <unistd.h>
+#include <poll.h>
+
+// Processing thread wake-up bounds while no input change arrives:
+// short while audio transitions are in flight, long when the state is settled
+// (still bounded so a lost signal is noticed once its average expires)
+#define ENGINE_TRANSITION_POLL_MS   1
+#define ENGINE_IDLE_POLL_MS         100
+#define ENGINE_TACH_POLL_MS         20      // Rotor pitch update rate while running
+
+// Pitch changes smaller than this are not sent to the mixer
+#define ROTOR_PITCH_STEP            0.005f
 
 struct EngineFX {
     atomic_int state;  // EngineState enum as atomic
@@ -38,27 +51,139 @@ struct EngineFX {
     
     // Offset in milliseconds to play stopping track from when stopping from starting state
     int stopping_offset_from_starting_ms;
+    
+    // Input failsafe
+    FailsafeAction failsafe_action;
+    atomic_bool in_failsafe;
+    
+    // Rotor tachometer (optional): running sound pitch follows rotor speed
+    PWMMonitor *rotor_tach_monitor;
+    int rotor_nominal_rpm;
+    float rotor_min_pitch;
+    float rotor_max_pitch;
+    float rotor_pitch;      // Pitch last applied to the mixer
 };
 
+// Overlap between the end of the starting track and the running loop
+#define RUNNING_CROSSFADE_MS 500
+// Stopping track fading out under the starting track when the engine is switched back on
+#define RESTART_CROSSFADE_MS 100
+
+// Schedule starting → running as one sequence; the audio thread starts the
+// running loop (crossfaded) at the right frame without control-thread timing.
+// Whatever the channel still plays fades out across fade_in_ms.
+// Returns 0 on success, -1 if nothing could be scheduled.
+static int engine_play_startup(EngineFX *engine, int start_offset_ms, int fade_in_ms) {
+    SequenceEvent events[2];
+    int count = 0;
+    
+    events[count++] = (SequenceEvent){
+        .sound = engine->track_starting,
+        .channel = engine->audio_channel,
+        .start_frame_offset = 0,
+        .sound_start_ms = start_offset_ms,
+        .gain = 1.0f,
+        .fade_in_ms = fade_in_ms,
+    };
+    
+    if (engine->track_running) {
+        int lead_ms = sound_get_length_ms(engine->track_starting) - start_offset_ms - RUNNING_CROSSFADE_MS;
+        if (lead_ms < 0) lead_ms = 0;
+        events[count++] = (SequenceEvent){
+            .sound = engine->track_running,
+            .channel = engine->audio_channel,
+            .start_frame_offset = audio_mixer_ms_to_frames(engine->mixer, lead_ms),
+            .gain = 1.0f,
+            .fade_in_ms = RUNNING_CROSSFADE_MS,
+            .loop = true,
+        };
+    }
+    
+    if (audio_mixer_play_sequence(engine->mixer, events, count) != 0) {
+        LOG_ERROR(LOG_ENGINE, "Cannot schedule the starting sound");
+        return -1;
+    }
+    return 0;
+}
+
+// Block until the engine toggle average changes or the state needs re-checking
+static void engine_wait_for_input(EngineFX *engine) {
+    EngineState state = (EngineState)atomic_load(&engine->state);
+    bool transitioning = state == ENGINE_STARTING || state == ENGINE_STOPPING ||
+                         engine->pending_running_sound;
+    
+    struct pollfd pfd = {
+        .fd = pwm_monitor_get_event_fd(engine->engine_toggle_pwm_monitor),  // -1 just sleeps
+        .events = POLLIN,
+    };
+    int timeout_ms = transitioning ? ENGINE_TRANSITION_POLL_MS : ENGINE_IDLE_POLL_MS;
+    if (engine->rotor_tach_monitor && state == ENGINE_RUNNING && timeout_ms > ENGINE_TACH_POLL_MS) {
+        timeout_ms = ENGINE_TACH_POLL_MS;
+    }
+    if (poll(&pfd, 1, timeout_ms) > 0) {
+        pwm_monitor_clear_event(engine->engine_toggle_pwm_monitor);
+    }
+}
+
+// Track the toggle input's failsafe state, logging transitions
+static bool engine_check_failsafe(EngineFX *engine) {
+    bool failsafe = pwm_monitor_in_failsafe(engine->engine_toggle_pwm_monitor);
+    if (failsafe != atomic_load(&engine->in_failsafe)) {
+        atomic_store(&engine->in_failsafe, failsafe);
+        if (failsafe) {
+            LOG_WARN(LOG_ENGINE, "Engine toggle signal lost - failsafe (%s)",
+                     engine->failsafe_action == FAILSAFE_HOLD ? "hold" : "shut down");
+        } else {
+            LOG_INFO(LOG_ENGINE, "Engine toggle signal recovered");
+        }
+    }
+    return failsafe;
+}
+
+// Scale the running sound with rotor speed; other states (and a missing tach
+// signal) play at the recorded pitch
+static void engine_update_rotor_pitch(EngineFX *engine) {
+    if (!engine->rotor_tach_monitor || !engine->mixer) return;
+    
+    float pitch = 1.0f;
+    TachReading tach;
+    if (atomic_load(&engine->state) == ENGINE_RUNNING &&
+        pwm_monitor_get_tach(engine->rotor_tach_monitor, &tach) && tach.rpm > 0.0f) {
+        pitch = tach.rpm / (float)engine->rotor_nominal_rpm;
+        if (pitch < engine->rotor_min_pitch) pitch = engine->rotor_min_pitch;
+        if (pitch > engine->rotor_max_pitch) pitch = engine->rotor_max_pitch;
+    }
+    
+    float delta = pitch - engine->rotor_pitch;
+    if (delta > ROTOR_PITCH_STEP || delta < -ROTOR_PITCH_STEP || (pitch == 1.0f && delta != 0.0f)) {
+        audio_mixer_set_pitch(engine->mixer, engine->audio_channel, pitch);
+        engine->rotor_pitch = pitch;
+    }
+}
+
 // Processing thread to monitor PWM and manage engine state
 static int engine_fx_processing_thread(void *arg) {
     EngineFX *engine = (EngineFX *)arg;
     PWMReading reading;
     bool engine_switch_on = false;
     
+    rt_sched_apply(RT_ROLE_ENGINE, "sfx-engine");
     LOG_INFO(LOG_ENGINE, "Processing thread started");
     
     while (atomic_load(&engine->processing_running)) {
-        // Use averaged PWM reading only; if not available, skip this cycle
+        engine_update_rotor_pitch(engine);
+        
+        // Use averaged PWM reading only; if not available (and not in failsafe), skip this cycle
         int avg_us;
-        if (engine->engine_toggle_pwm_monitor && pwm_monitor_get_average(engine->engine_toggle_pwm_monitor, &avg_us)) {
+        if (engine_check_failsafe(engine)) {
+            // Hold keeps the last switch position; neutral and stop both mean engine off
+            if (engine->failsafe_action != FAILSAFE_HOLD) {
+                engine_switch_on = false;
+            }
+        } else if (engine->engine_toggle_pwm_monitor && pwm_monitor_get_average(engine->engine_toggle_pwm_monitor, &avg_us)) {
             reading.duration_us = avg_us;
             reading.pin = engine->engine_toggle_pwm_pin;
-        } else {
-            usleep(10000);
-            continue;
-        }
-        {
+            
             // Apply hysteresis/deadzone to prevent noise from causing rapid state changes
             // Deadzone: +/- 100us from threshold
             const int DEADZONE_US = 100;
@@ -82,6 +207,9 @@ static int engine_fx_processing_thread(void *arg) {
                 LOG_DEBUG(LOG_ENGINE, "PWM toggle changed: OFF (avg=%d us, threshold=%d us)",
                        reading.duration_us, engine->engine_toggle_pwm_threshold);
             }
+        } else {
+            engine_wait_for_input(engine);
+            continue;
         }
         
         EngineState current_state = (EngineState)atomic_load(&engine->state);
@@ -90,34 +218,26 @@ static int engine_fx_processing_thread(void *arg) {
         if (current_state == ENGINE_STOPPED && engine_switch_on) {
             engine->pending_running_sound = (engine->track_running != nullptr);
             
-            if (engine->mixer && engine->track_starting) {
+            if (engine->mixer && engine->track_starting && engine_play_startup(engine, 0, 0) == 0) {
                 atomic_store(&engine->state, ENGINE_STARTING);
                 LOG_STATE(LOG_ENGINE, "STOPPED", "STARTING");
                 LOG_INFO(LOG_ENGINE, "Transitioning to STARTING");
-                
-                PlaybackOptions opts = {.loop = false, .volume = 1.0f};
-                audio_mixer_play(engine->mixer, engine->audio_channel, engine->track_starting, &opts);
                 LOG_INFO(LOG_ENGINE, "Playing starting sound");
             } else {
+                // Without a starting sound the running loop plays once the channel is free
                 atomic_store(&engine->state, ENGINE_RUNNING);
-                LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING (no starting sound)");
+                LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING (%s)",
+                         engine->track_starting ? "starting sound failed" : "no starting sound");
             }
             
             continue;
         }
         
-        // STARTING + pending sound → play running sound 0.5s before starting finishes
+        // STARTING + pending sound → RUNNING once the scheduled running loop is audible
         if (current_state == ENGINE_STARTING && engine->pending_running_sound) {
-            int remaining_ms = audio_mixer_get_channel_remaining_ms(engine->mixer, engine->audio_channel);
-            
-            // Start running sound 500ms before starting sound finishes
-            if (remaining_ms >= 0 && remaining_ms <= 500) {
+            if (audio_mixer_get_channel_start_delay_ms(engine->mixer, engine->audio_channel) == 0) {
                 atomic_store(&engine->state, ENGINE_RUNNING);
-                LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING (%dms before start complete)", remaining_ms);
-                
-                PlaybackOptions opts = {.loop = true, .volume = 1.0f};
-                audio_mixer_play(engine->mixer, engine->audio_channel, engine->track_running, &opts);
-                LOG_INFO(LOG_ENGINE, "Playing running sound (looping)");
+                LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING (running loop started)");
                 engine->pending_running_sound = false;
                 continue;
             }
@@ -127,7 +247,7 @@ static int engine_fx_processing_thread(void *arg) {
                 atomic_store(&engine->state, ENGINE_RUNNING);
                 LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING (start complete)");
                 
-                PlaybackOptions opts = {.loop = true, .volume = 1.0f};
+                PlaybackOptions opts = {.loop = true, .volume = 1.0f, .fade_in_ms = PLAYBACK_FADE_IN_ENVELOPE};
                 audio_mixer_play(engine->mixer, engine->audio_channel, engine->track_running, &opts);
                 LOG_INFO(LOG_ENGINE, "Playing running sound (looping)");
                 engine->pending_running_sound = false;
@@ -142,7 +262,7 @@ static int engine_fx_processing_thread(void *arg) {
             atomic_store(&engine->state, ENGINE_RUNNING);
             LOG_INFO(LOG_ENGINE, "Transitioning to RUNNING");
             
-            PlaybackOptions opts = {.loop = true, .volume = 1.0f};
+            PlaybackOptions opts = {.loop = true, .volume = 1.0f, .fade_in_ms = PLAYBACK_FADE_IN_ENVELOPE};
             audio_mixer_play(engine->mixer, engine->audio_channel, engine->track_running, &opts);
             LOG_INFO(LOG_ENGINE, "Playing running sound (looping)");
             engine->pending_running_sound = false;
@@ -155,7 +275,7 @@ static int engine_fx_processing_thread(void *arg) {
                 atomic_store(&engine->state, ENGINE_STOPPING);
                 LOG_INFO(LOG_ENGINE, "Transitioning to STOPPING");
                 
-                PlaybackOptions opts = {.loop = false, .volume = 1.0f};
+                PlaybackOptions opts = {.loop = false, .volume = 1.0f, .fade_in_ms = PLAYBACK_FADE_IN_ENVELOPE};
                 
                 // Use stopping offset if transitioning from STARTING state
                 if (current_state == ENGINE_STARTING && engine->stopping_offset_from_starting_ms > 0) {
@@ -182,24 +302,21 @@ static int engine_fx_processing_thread(void *arg) {
         if (current_state == ENGINE_STOPPING && engine_switch_on) {
             engine->pending_running_sound = (engine->track_running != nullptr);
             
-            if (engine->mixer && engine->track_starting) {
+            // Use restart offset if specified; the stopping track fades out under it
+            if (engine->mixer && engine->track_starting &&
+                engine_play_startup(engine, engine->starting_offset_from_stopping_ms, RESTART_CROSSFADE_MS) == 0) {
                 atomic_store(&engine->state, ENGINE_STARTING);
                 LOG_INFO(LOG_ENGINE, "Pre-empting STOPPING, transitioning to STARTING");
                 
-                PlaybackOptions opts = {.loop = false, .volume = 1.0f};
-                
-                // Use restart offset if specified
                 if (engine->starting_offset_from_stopping_ms > 0) {
-                    audio_mixer_play_from(engine->mixer, engine->audio_channel, engine->track_starting, 
-                                         engine->starting_offset_from_stopping_ms, &opts);
                     LOG_INFO(LOG_ENGINE, "Playing starting sound from %dms", engine->starting_offset_from_stopping_ms);
                 } else {
-                    audio_mixer_play(engine->mixer, engine->audio_channel, engine->track_starting, &opts);
                     LOG_INFO(LOG_ENGINE, "Playing starting sound");
                 }
             } else {
                 atomic_store(&engine->state, ENGINE_RUNNING);
-                LOG_INFO(LOG_ENGINE, "Pre-empting STOPPING, transitioning to RUNNING (no starting sound)");
+                LOG_INFO(LOG_ENGINE, "Pre-empting STOPPING, transitioning to RUNNING (%s)",
+                         engine->track_starting ? "starting sound failed" : "no starting sound");
             }
             
             continue;
@@ -214,7 +331,7 @@ static int engine_fx_processing_thread(void *arg) {
             continue;
         }
         
-        usleep(1000); // 1ms loop delay for responsive audio transitions
+        engine_wait_for_input(engine);
     }
     
     LOG_INFO(LOG_ENGINE, "Processing thread stopped");
@@ -238,8 +355,8 @@ EngineFX* engine_fx_create(AudioMixer *mixer, int audio_channel,
     engine->mixer = mixer;
     engine->audio_channel = audio_channel;
     
-    // Convert input channel to GPIO pin
-    int gpio_pin = channel_to_gpio(config->engine_toggle.input_channel);
+    // Resolve input channel (GPIO pin is -1 for serial receiver inputs)
+    int gpio_pin = input_channel_pin(config->engine_toggle.input_channel);
     engine->engine_toggle_pwm_pin = gpio_pin;
     engine->engine_toggle_pwm_threshold = config->engine_toggle.threshold_us;
     engine->starting_offset_from_stopping_ms = config->sounds.transitions.starting_offset_ms;
@@ -248,30 +365,62 @@ EngineFX* engine_fx_create(AudioMixer *mixer, int audio_channel,
     engine->track_running = nullptr;
     engine->track_stopping = nullptr;
     engine->engine_toggle_pwm_monitor = nullptr;
+    engine->failsafe_action = config_failsafe_action(&config->failsafe, FAILSAFE_HOLD);
+    atomic_init(&engine->in_failsafe, false);
     atomic_init(&engine->processing_running, false);
     
     // Create PWM monitor if valid channel specified
-    if (gpio_pin >= 0) {
-        engine->engine_toggle_pwm_monitor = pwm_monitor_create_with_name(gpio_pin, "Engine Toggle", nullptr, nullptr);
+    if (config->engine_toggle.input_channel > 0) {
+        engine->engine_toggle_pwm_monitor = input_monitor_create(config->engine_toggle.input_channel, "Engine Toggle");
         if (!engine->engine_toggle_pwm_monitor) {
             LOG_ERROR(LOG_ENGINE, "Failed to create PWM monitor for channel %d (GPIO %d)", 
                      config->engine_toggle.input_channel, gpio_pin);
         } else {
+            const InputFilterConfig *fc = &config->engine_toggle.filter;
+            pwm_monitor_set_filter(engine->engine_toggle_pwm_monitor, &(PWMFilter){
+                .glitch_us = fc->glitch_us,
+                .median_samples = fc->median_samples,
+                .ema_alpha = fc->ema_alpha,
+                .rate_limit_us_per_s = fc->rate_limit_us_per_s,
+                .avg_window_pulses = fc->avg_window_pulses,
+            });
+            pwm_monitor_set_failsafe_timeout(engine->engine_toggle_pwm_monitor, config->failsafe.timeout_ms);
             pwm_monitor_start(engine->engine_toggle_pwm_monitor);
             LOG_DEBUG(LOG_ENGINE, "PWM monitoring started on channel %d (GPIO %d, threshold: %d us)",
                    config->engine_toggle.input_channel, gpio_pin, config->engine_toggle.threshold_us);
         }
     }
     
+    // Rotor tachometer on its own GPIO pin, whatever the RC input source
+    engine->rotor_pitch = 1.0f;
+    if (config->rotor_tach.input_channel > 0) {
+        int tach_pin = channel_to_gpio(config->rotor_tach.input_channel);
+        engine->rotor_nominal_rpm = config->rotor_tach.nominal_rpm;
+        engine->rotor_min_pitch = config->rotor_tach.min_pitch;
+        engine->rotor_max_pitch = config->rotor_tach.max_pitch;
+        engine->rotor_tach_monitor = pwm_monitor_create_tach(tach_pin, "Rotor Tach",
+                                                             config->rotor_tach.pulses_per_rev,
+                                                             config->rotor_tach.window_ms);
+        if (!engine->rotor_tach_monitor || pwm_monitor_start(engine->rotor_tach_monitor) != 0) {
+            LOG_ERROR(LOG_ENGINE, "Failed to start rotor tachometer on channel %d (GPIO %d)",
+                      config->rotor_tach.input_channel, tach_pin);
+            pwm_monitor_destroy(engine->rotor_tach_monitor);
+            engine->rotor_tach_monitor = nullptr;
+        } else if (mixer) {
+            // Engine sounds are created with pitch control from now on
+            audio_mixer_set_pitch(mixer, audio_channel, 1.0f);
+            LOG_INFO(LOG_ENGINE, "Rotor tachometer on channel %d (GPIO %d), nominal %d RPM",
+                     config->rotor_tach.input_channel, tach_pin, config->rotor_tach.nominal_rpm);
+        }
+    }
+    
     // Start processing thread
     atomic_store(&engine->processing_running, true);
     if (thrd_create(&engine->processing_thread, engine_fx_processing_thread, engine) != thrd_success) {
         LOG_ERROR(LOG_ENGINE, "Error: Failed to create processing thread");
         engine->processing_running = false;
-        if (engine->engine_toggle_pwm_monitor) {
-            pwm_monitor_stop(engine->engine_toggle_pwm_monitor);
-            pwm_monitor_destroy(engine->engine_toggle_pwm_monitor);
-        }
+        pwm_monitor_destroy(engine->rotor_tach_monitor);
+        input_monitor_destroy(engine->engine_toggle_pwm_monitor);
         free(engine);
         return nullptr;
     }
@@ -289,11 +438,9 @@ void engine_fx_destroy(EngineFX *engine) {
         thrd_join(engine->processing_thread, nullptr);
     }
     
-    // Stop and destroy PWM monitor
-    if (engine->engine_toggle_pwm_monitor) {
-        pwm_monitor_stop(engine->engine_toggle_pwm_monitor);
-        pwm_monitor_destroy(engine->engine_toggle_pwm_monitor);
-    }
+    // Stop and destroy PWM monitors
+    input_monitor_destroy(engine->engine_toggle_pwm_monitor);
+    pwm_monitor_destroy(engine->rotor_tach_monitor);
     
     free(engine);
     
@@ -347,3 +494,13 @@ int engine_fx_get_toggle_pwm(EngineFX *engine) {
 int engine_fx_get_toggle_pin(EngineFX *engine) {
     return engine ? engine->engine_toggle_pwm_pin : -1;
 }
+
+bool engine_fx_get_toggle_health(EngineFX *engine, PWMHealth *health) {
+    return engine && pwm_monitor_get_health(engine->engine_toggle_pwm_monitor, health);
+}
+
+float engine_fx_get_rotor_rpm(EngineFX *engine) {
+    TachReading tach;
+    if (!engine || !pwm_monitor_get_tach(engine->rotor_tach_monitor, &tach)) return -1.0f;
+    return tach.rpm;
+}
@@ -6,11 +6,16 @@
 #include <unistd.h>
 #include <errno.h>
 #include <time.h>
+#include <math.h>
 #include <sys/time.h>
 #include <threads.h>
 #include <stdatomic.h>
 #include <poll.h>
+#include <sys/eventfd.h>
 #include "logging.h"
+#include "alloc_check.h"
+#include "rt_sched.h"
+#include "channel_decoder.h"
 
 static bool initialized = false;
 static struct gpiod_chip *chip = NULL;
@@ -50,9 +55,72 @@ static thrd_t pwm_monitoring_thread;
 static atomic_bool pwm_thread_running = false;
 static mtx_t pwm_monitors_mutex;
 
-#define MAX_PWM_MONITORS 8
-static PWMMonitor *active_monitors[MAX_PWM_MONITORS] = {0};
-static int active_monitor_count = 0;
+// User PWMCallbacks raised while pwm_monitors_mutex is held are collected in a
+// batch and run after it is released, so a callback may start, stop or
+// configure monitors and a slow one does not hold up the registry.
+// pwm_callback_mutex (recursive) is taken before the registry lock is dropped
+// and held while the batch runs; pwm_monitor_stop() waits on it, so no
+// callback of a stopped monitor runs after stop returns.
+#define PWM_CALLBACK_BATCH      128
+#define PWM_CALLBACKS_PER_EDGE  (PPM_MAX_CHANNELS * (1 + CHANNEL_DECODER_MAX_OUTPUTS))  // Decoded PPM frame
+
+_Static_assert(PWM_CALLBACKS_PER_EDGE <= PWM_CALLBACK_BATCH, "PWM_CALLBACK_BATCH must hold one edge's callbacks");
+
+typedef struct {
+    int count;
+    struct {
+        PWMCallback callback;
+        void *user_data;
+        PWMReading reading;
+    } calls[PWM_CALLBACK_BATCH];
+} PWMCallbackBatch;
+
+static mtx_t pwm_callback_mutex;
+
+// Monitor registry: monitors are carved out of contiguous, cache-line aligned
+// blocks rather than individual heap objects, so the edge path walks adjacent
+// memory. The first block is sized before gpio_init() from the configuration;
+// another block is added only if more monitors are created than planned for.
+// Blocks are guarded by pwm_monitors_mutex and live until gpio_cleanup().
+#define PWM_MONITOR_ALIGN 64
+#define PWM_PERIOD_HISTORY 5               // Pulse intervals kept for frame period detection
+typedef struct MonitorBlock {
+    struct MonitorBlock *next;
+    int capacity;
+    PWMMonitor *monitors;
+} MonitorBlock;
+static MonitorBlock *monitor_blocks = NULL;
+static int monitor_capacity = GPIO_MONITOR_CAPACITY_DEFAULT;
+static int active_monitor_count = 0;           // Monitors in the shared edge request
+static void monitor_registry_free(void);
+
+// All active PWM inputs share one multi-line edge request (one fd).
+// It is rebuilt under pwm_monitors_mutex whenever a monitor starts or stops;
+// the generation counter plus an eventfd wake tell the monitoring thread that
+// the fd it is polling has been replaced.
+#define PWM_EDGE_EVENTS_PER_LINE 16        // Kernel edge queue depth per PWM line
+static struct gpiod_line_request *pwm_request = NULL;
+static struct gpiod_edge_event_buffer *pwm_edge_buffer = NULL;  // Allocated in gpio_init(), grown on rebuild
+static size_t pwm_edge_batch = 0;              // Capacity of pwm_edge_buffer
+static unsigned int pwm_request_generation = 0;
+static int pwm_wake_fd = -1;
+
+// Edge traces (format in gpio.h): recording happens in the monitoring thread
+// through a stdio buffer allocated up front; replay feeds the same edge path
+// from a file instead of the chip, so no hardware is needed.
+#define GPIO_TRACE_IO_BUFFER    (64 * 1024)
+#define GPIO_TRACE_READ_BATCH   256
+#define GPIO_TRACE_LOOP_GAP_NS  20000000LL     // Pause inserted between replay loops
+static FILE *trace_record_file = NULL;         // Guarded by pwm_monitors_mutex
+static char *trace_record_buffer = NULL;
+static uint64_t trace_record_edges = 0;
+static char *trace_replay_path = NULL;         // Set before gpio_init(); replaces the chip
+static bool trace_replay_realtime = true;
+static bool trace_replay_loop = false;
+
+#ifdef GPIO_BENCH
+static _Atomic(GPIOBenchEdgeHook) bench_edge_hook = nullptr;
+#endif
 
 // Single emitting thread for all PWM outputs
 // Per-emitter threading model (no global emitter thread)
@@ -76,29 +144,102 @@ static bool is_audio_hat_pin(int pin) {
             pin == AUDIO_SHUTDOWN);
 }
 
+// Per-offset tables, sized in gpio_init() from the chip's line count
+// (every offset a 16-bit trace record can hold when replaying)
+#define GPIO_REPLAY_LINES (UINT16_MAX + 1)
+static unsigned int gpio_num_lines = 0;
+
 // Track GPIO line requests we've made (libgpiod v2.x uses requests)
-#define MAX_LINES 32
-static struct gpiod_line_request *line_requests[MAX_LINES] = {0};
+static struct gpiod_line_request **line_requests = NULL;
+
+// Line offset -> monitor for demultiplexing the shared PWM request (guarded by pwm_monitors_mutex)
+static PWMMonitor **pwm_line_map = NULL;
+
+static bool is_chip_line(int pin) {
+    return pin >= 0 && (unsigned int)pin < gpio_num_lines;
+}
 
-int gpio_init(void) {
+int gpio_init(const char *chip_path) {
     if (initialized) {
         LOG_WARN(LOG_GPIO, "GPIO already initialized");
         return 0;
     }
     
-    // Open GPIO chip (gpiochip0 on Raspberry Pi)
-    chip = gpiod_chip_open("/dev/gpiochip0");
-    if (!chip) {
-        LOG_ERROR(LOG_GPIO, "Failed to open GPIO chip: %s", strerror(errno));
-        LOG_ERROR(LOG_GPIO, "Make sure you have permission to access /dev/gpiochip0");
+    if (trace_replay_path) {
+        // PWM edges come from a recorded trace; outputs are unavailable
+        LOG_INFO(LOG_GPIO, "Replaying GPIO edges from %s (%s%s), no GPIO chip opened",
+                 trace_replay_path, trace_replay_realtime ? "real time" : "as fast as possible",
+                 trace_replay_loop ? ", looped" : "");
+    } else {
+        // Open GPIO chip (gpiochip0 on Raspberry Pi unless overridden)
+        if (!chip_path) chip_path = GPIO_DEFAULT_CHIP;
+        chip = gpiod_chip_open(chip_path);
+        if (!chip) {
+            LOG_ERROR(LOG_GPIO, "Failed to open GPIO chip %s: %s", chip_path, strerror(errno));
+            LOG_ERROR(LOG_GPIO, "Make sure you have permission to access %s", chip_path);
+            return -1;
+        }
+    }
+    
+    gpio_num_lines = GPIO_REPLAY_LINES;
+    if (chip) {
+        struct gpiod_chip_info *info = gpiod_chip_get_info(chip);
+        if (info) {
+            gpio_num_lines = (unsigned int)gpiod_chip_info_get_num_lines(info);
+            gpiod_chip_info_free(info);
+        }
+    }
+    line_requests = calloc(gpio_num_lines, sizeof(*line_requests));
+    pwm_line_map = calloc(gpio_num_lines, sizeof(*pwm_line_map));
+    if (!line_requests || !pwm_line_map) {
+        LOG_ERROR(LOG_GPIO, "Cannot allocate line tables for %u lines", gpio_num_lines);
+        free(line_requests);
+        free(pwm_line_map);
+        line_requests = NULL;
+        pwm_line_map = NULL;
+        if (chip) gpiod_chip_close(chip);
+        chip = NULL;
         return -1;
     }
     
-    // Initialize PWM monitoring mutex
+    // Initialize PWM monitoring mutex and the thread's wake-up eventfd
     mtx_init(&pwm_monitors_mutex, mtx_plain);
+    mtx_init(&pwm_callback_mutex, mtx_plain | mtx_recursive);
+    pwm_wake_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pwm_wake_fd < 0) {
+        LOG_ERROR(LOG_GPIO, "Failed to create PWM wake eventfd: %s", strerror(errno));
+        mtx_destroy(&pwm_callback_mutex);
+        mtx_destroy(&pwm_monitors_mutex);
+        free(line_requests);
+        free(pwm_line_map);
+        line_requests = NULL;
+        pwm_line_map = NULL;
+        if (chip) gpiod_chip_close(chip);
+        chip = NULL;
+        return -1;
+    }
+    
+    // Edge buffer sized for a full kernel queue on every planned PWM line, reused for every read
+    pwm_edge_batch = (size_t)PWM_EDGE_EVENTS_PER_LINE * (size_t)monitor_capacity;
+    pwm_edge_buffer = gpiod_edge_event_buffer_new(pwm_edge_batch);
+    if (!pwm_edge_buffer) {
+        LOG_ERROR(LOG_GPIO, "Failed to allocate PWM edge event buffer");
+        close(pwm_wake_fd);
+        pwm_wake_fd = -1;
+        mtx_destroy(&pwm_callback_mutex);
+        mtx_destroy(&pwm_monitors_mutex);
+        free(line_requests);
+        free(pwm_line_map);
+        line_requests = NULL;
+        pwm_line_map = NULL;
+        if (chip) gpiod_chip_close(chip);
+        chip = NULL;
+        return -1;
+    }
     
     initialized = true;
-    LOG_INFO(LOG_GPIO, "GPIO subsystem initialized using libgpiod v2.x");
+    LOG_INFO(LOG_GPIO, "GPIO subsystem initialized using libgpiod v2.x (%s, %u lines, %d monitor slots)",
+             chip ? chip_path : "edge replay", gpio_num_lines, monitor_capacity);
     LOG_INFO(LOG_GPIO, "WM8960 Audio HAT pins (2,3,18-21) will not be used");
     return 0;
 }
@@ -111,18 +252,42 @@ void gpio_cleanup(void) {
     // Stop PWM monitoring thread if running
     if (atomic_load(&pwm_thread_running)) {
         atomic_store(&pwm_thread_running, false);
+        eventfd_write(pwm_wake_fd, 1);
         thrd_join(pwm_monitoring_thread, NULL);
     }
     
+    gpio_trace_record_stop();
+    free(trace_replay_path);
+    trace_replay_path = NULL;
+    
+    // Release the shared PWM edge request
+    if (pwm_request) {
+        gpiod_line_request_release(pwm_request);
+        pwm_request = NULL;
+    }
+    gpiod_edge_event_buffer_free(pwm_edge_buffer);
+    pwm_edge_buffer = NULL;
+    pwm_edge_batch = 0;
+    close(pwm_wake_fd);
+    pwm_wake_fd = -1;
+    
+    // Release the monitor registry; monitors must be destroyed before this point
+    monitor_registry_free();
+    
     // Release all GPIO line requests
-    for (int i = 0; i < MAX_LINES; i++) {
+    for (unsigned int i = 0; i < gpio_num_lines; i++) {
         if (line_requests[i]) {
             gpiod_line_request_release(line_requests[i]);
-            line_requests[i] = NULL;
         }
     }
-    
-    // Destroy PWM monitoring mutex
+    free(line_requests);
+    free(pwm_line_map);
+    line_requests = NULL;
+    pwm_line_map = NULL;
+    gpio_num_lines = 0;
+    
+    // Destroy PWM monitoring mutexes
+    mtx_destroy(&pwm_callback_mutex);
     mtx_destroy(&pwm_monitors_mutex);
     
     // Close GPIO chip
@@ -141,6 +306,11 @@ int gpio_set_mode(int pin, GPIOMode mode) {
         return -1;
     }
     
+    if (!is_chip_line(pin)) {
+        LOG_ERROR(LOG_GPIO, "Invalid GPIO %d (chip has %u lines)", pin, gpio_num_lines);
+        return -1;
+    }
+    
     // Prevent using audio HAT pins (WM8960 / DigiAMP+)
     if (is_audio_hat_pin(pin)) {
         LOG_ERROR(LOG_GPIO, "Cannot use GPIO %d - reserved for audio HAT (WM8960/DigiAMP+)!", pin);
@@ -250,8 +420,8 @@ int gpio_write(int pin, bool value) {
         return -1;
     }
     
-    if (is_audio_hat_pin(pin)) {
-        LOG_ERROR(LOG_GPIO, "Cannot use GPIO %d - reserved for WM8960 Audio HAT!", pin);
+    if (!is_chip_line(pin) || is_audio_hat_pin(pin)) {
+        LOG_ERROR(LOG_GPIO, "Cannot use GPIO %d - invalid or reserved for WM8960 Audio HAT!", pin);
         return -1;
     }
     
@@ -277,8 +447,8 @@ bool gpio_read(int pin) {
         return false;
     }
     
-    if (is_audio_hat_pin(pin)) {
-        LOG_ERROR(LOG_GPIO, "Cannot use GPIO %d - reserved for WM8960 Audio HAT!", pin);
+    if (!is_chip_line(pin) || is_audio_hat_pin(pin)) {
+        LOG_ERROR(LOG_GPIO, "Cannot use GPIO %d - invalid or reserved for WM8960 Audio HAT!", pin);
         return false;
     }
     
@@ -303,51 +473,493 @@ bool gpio_read(int pin) {
 // ============================================================================
 
 struct PWMMonitor {
-    int pin;
-    char *feature_name;
-    struct gpiod_line_request *line_request;
+    // ---- Hot: touched by every pulse on the monitoring thread ----
+    // Kept together at the start of the slot so decoding a pulse stays on the
+    // first few cache lines; arrays and setup-only fields follow further down.
     
+    // Track rising edge for pulse width calculation
+    _Alignas(PWM_MONITOR_ALIGN) struct timespec rise_time;   // Registry slots start on their own cache line
+    atomic_bool waiting_for_fall;
     atomic_bool active;
-    atomic_bool has_new_reading;
-    atomic_bool first_signal_received;
+    bool ppm_mode;                   // PPM sum signal (see PPM state below)
+    bool tach_mode;                  // Tachometer (see tach state below)
+    
+    // Input filter chain and its state (monitoring thread only, set under pwm_monitors_mutex)
+    PWMFilter filter;
+    int glitch_last_us;              // Last pulse accepted by glitch rejection (0 = none yet)
+    int glitch_candidate_us;         // Rejected jump, accepted if the next pulse confirms it
+    int median_count;
+    int median_pos;
+    float ema_us;
+    float rate_last_us;
+    int64_t rate_last_ns;
+    bool filter_primed;              // EMA / rate limiter have a previous output
+    
+    // Averaging window: ring of the last avg_window_pulses pulses with a running sum.
+    // Owned by the monitoring thread (the only writer); readers never touch it.
+    atomic_int avg_window_pulses;
+    int sample_head;                 // Oldest sample in the window
+    int sample_count;
+    int64_t sample_sum_us;
+    
+    // Window result published through a seqlock (odd sequence = write in progress)
+    atomic_uint avg_seq;
+    atomic_int avg_count;
+    _Atomic int64_t avg_sum_us;
+    _Atomic int64_t avg_newest_ns;   // Timestamp of the newest sample in the window
     
     // Current reading - written by monitoring thread, read by API
+    _Atomic int64_t current_ts_ns;
     atomic_int current_duration_us;
     atomic_int current_pin;
+    atomic_bool has_new_reading;
+    atomic_bool first_signal_received;
+    
+    // Change notification: event_fd becomes readable when the windowed average
+    // moves more than change_threshold_us from the last notified value
+    int event_fd;
+    atomic_int change_threshold_us;
+    int notified_avg_us;             // Monitoring thread only (-1 = nothing notified yet)
+    
+    // Signal health, written by the monitoring thread and read lock-free
+    _Atomic int64_t last_valid_ns;   // Edge timestamp of the last in-range pulse (0 = never)
+    atomic_int frame_rate_mhz;       // Smoothed pulse rate in millihertz
+    atomic_int jitter_us;            // Smoothed |period - mean period|
+    atomic_uint valid_pulses;
+    atomic_uint rejected_pulses;     // Outside the 500-3000 µs sanity range
+    float period_avg_us;             // Monitoring thread only
+    float jitter_avg_us;             // Monitoring thread only
+    
+    // Frame period detection: median of the last few in-range pulse intervals
+    int period_hist_count;           // Monitoring thread only
+    int period_hist_pos;
+    int64_t period_hist_ns[PWM_PERIOD_HISTORY];
+    int64_t period_logged_ns;        // Last period reported in the log
+    _Atomic int64_t frame_period_ns; // 0 = not detected yet
     
     PWMCallback callback;
     void *user_data;
+    ChannelDecoder *decoder;         // Switch / mux decoding (state updated under pwm_monitors_mutex)
     
-    // Track rising edge for pulse width calculation
-    struct timespec rise_time;
-    atomic_bool waiting_for_fall;
-
-    // Averaging window and ring buffer for recent readings
-    atomic_int avg_window_ms;
-    #define PWM_AVG_MAX_SAMPLES 128
+    // ---- Cold: setup, registry and per-mode state ----
+    int pin;
+    char *feature_name;
+    bool in_use;                     // Registry slot taken (guarded by pwm_monitors_mutex)
+    bool registered;                 // Line is part of the shared edge request (same)
+    atomic_int failsafe_timeout_ms;
+    
+    // Filter and window buffers: each pulse touches one or two entries
+    int median_buf[PWM_FILTER_MAX_MEDIAN];
     struct {
-        atomic_int duration_us;
-        struct timespec ts;
+        int duration_us;
+        int64_t ts_ns;
     } samples[PWM_AVG_MAX_SAMPLES];
-    atomic_int sample_head;
+    
+    // PPM sum-signal decoding (monitoring thread only, outputs set under pwm_monitors_mutex).
+    // A PPM monitor publishes through its output monitors instead of itself.
+    PWMMonitor *ppm_outputs[PPM_MAX_CHANNELS];
+    int ppm_values_us[PPM_MAX_CHANNELS];
+    int ppm_index;                   // Channels collected since the last sync gap (-1 = not synced)
+    int ppm_last_count;              // Channel count of the previous frame
+    int64_t ppm_last_edge_ns;
+    atomic_int ppm_channel_count;    // Channels in the last accepted frame
+    
+    // Tachometer mode: rising-edge timestamps over a sliding window (monitoring thread only),
+    // result published through a seqlock like the PWM average
+    int64_t *tach_edges_ns;          // Ring of TACH_RING_SIZE timestamps
+    int tach_head;                   // Oldest edge in the window
+    int tach_count;
+    int64_t tach_window_ns;
+    int tach_pulses_per_rev;
+    atomic_uint tach_seq;
+    _Atomic int64_t tach_period_ns;  // Mean edge interval over the window (0 = fewer than two edges)
+    _Atomic int64_t tach_last_ns;
+    atomic_uint tach_edges;
+    atomic_uint tach_rejected;
+    
+    PWMMonitor *decoder_outputs[CHANNEL_DECODER_MAX_OUTPUTS];
 };
 
+// The per-pulse fields of a PWM monitor should stay within five cache lines
+_Static_assert(offsetof(struct PWMMonitor, pin) <= 5 * PWM_MONITOR_ALIGN, "PWMMonitor hot fields outgrew five cache lines");
+
 // Get microseconds from timespec
 static int64_t timespec_to_us(const struct timespec *ts) {
     return (int64_t)ts->tv_sec * 1000000 + ts->tv_nsec / 1000;
 }
 
-// Process edge event for a specific monitor
-static void process_pwm_event(PWMMonitor *monitor, struct gpiod_edge_event *event) {
-    if (gpiod_edge_event_get_event_type(event) == GPIOD_EDGE_EVENT_RISING_EDGE) {
+_Static_assert((PWM_AVG_MAX_SAMPLES & (PWM_AVG_MAX_SAMPLES - 1)) == 0, "ring size must be a power of two");
+#define PWM_AVG_RING_MASK (PWM_AVG_MAX_SAMPLES - 1)
+
+// Tachometer edge ring: a full TACH_WINDOW_MAX_MS window at TACH_MAX_HZ
+#define TACH_RING_SIZE 256
+#define TACH_RING_MASK (TACH_RING_SIZE - 1)
+#define TACH_BOUNCE_NS (1000000000LL / (2 * TACH_MAX_HZ))
+_Static_assert(TACH_RING_SIZE >= TACH_MAX_HZ * TACH_WINDOW_MAX_MS / 1000 + 1, "tach ring too small");
+
+// Slack added to the window span before samples count as stale (covers the
+// few-ms resolution of CLOCK_MONOTONIC_COARSE and frame jitter)
+#define PWM_AVG_EXPIRY_SLACK_NS 10000000LL
+
+// Time the averaging window may span before its samples count as stale: the
+// window's pulses (at least 3) at the detected frame period, plus slack
+static int64_t pwm_window_span_ns(PWMMonitor *monitor) {
+    int64_t period_ns = atomic_load_explicit(&monitor->frame_period_ns, memory_order_relaxed);
+    if (period_ns == 0) {
+        period_ns = PWM_FRAME_PERIOD_DEFAULT_US * 1000LL;
+    }
+    int pulses = atomic_load_explicit(&monitor->avg_window_pulses, memory_order_relaxed);
+    return (pulses < 3 ? 3 : pulses) * period_ns + PWM_AVG_EXPIRY_SLACK_NS;
+}
+
+// Append a pulse to the averaging window, evict samples that fell out of it,
+// and publish the new sum/count. Called from the monitoring thread only.
+static void pwm_window_push(PWMMonitor *monitor, int duration_us, int64_t ts_ns) {
+    int pulses = atomic_load_explicit(&monitor->avg_window_pulses, memory_order_relaxed);
+    int64_t span_ns = pwm_window_span_ns(monitor);
+    
+    // Keep pulses - 1 samples for the new one; also drop samples from before a signal gap
+    while (monitor->sample_count > 0) {
+        int oldest = monitor->sample_head;
+        if (monitor->sample_count < pulses && ts_ns - monitor->samples[oldest].ts_ns <= span_ns) {
+            break;
+        }
+        monitor->sample_sum_us -= monitor->samples[oldest].duration_us;
+        monitor->sample_head = (oldest + 1) & PWM_AVG_RING_MASK;
+        monitor->sample_count--;
+    }
+    
+    int tail = (monitor->sample_head + monitor->sample_count) & PWM_AVG_RING_MASK;
+    monitor->samples[tail].duration_us = duration_us;
+    monitor->samples[tail].ts_ns = ts_ns;
+    monitor->sample_count++;
+    monitor->sample_sum_us += duration_us;
+    
+    // Seqlock write: odd while the three fields are inconsistent
+    unsigned int seq = atomic_load_explicit(&monitor->avg_seq, memory_order_relaxed);
+    atomic_store_explicit(&monitor->avg_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&monitor->avg_sum_us, monitor->sample_sum_us, memory_order_relaxed);
+    atomic_store_explicit(&monitor->avg_count, monitor->sample_count, memory_order_relaxed);
+    atomic_store_explicit(&monitor->avg_newest_ns, ts_ns, memory_order_relaxed);
+    atomic_store_explicit(&monitor->avg_seq, seq + 2, memory_order_release);
+    
+    // Wake consumers blocked on the event fd if the average moved enough
+    int avg_us = (int)(monitor->sample_sum_us / monitor->sample_count);
+    int threshold = atomic_load_explicit(&monitor->change_threshold_us, memory_order_relaxed);
+    if (monitor->notified_avg_us < 0 || abs(avg_us - monitor->notified_avg_us) > threshold) {
+        monitor->notified_avg_us = avg_us;
+        eventfd_write(monitor->event_fd, 1);
+    }
+}
+
+static void pwm_filter_reset(PWMMonitor *monitor) {
+    monitor->glitch_last_us = 0;
+    monitor->glitch_candidate_us = 0;
+    monitor->median_count = 0;
+    monitor->median_pos = 0;
+    monitor->filter_primed = false;
+}
+
+// Run a raw pulse through the monitor's filter chain.
+// Returns false if the pulse was rejected as a glitch.
+static bool pwm_filter_apply(PWMMonitor *monitor, int pulse_us, int64_t ts_ns, int *out_us) {
+    const PWMFilter *f = &monitor->filter;
+    
+    // Glitch rejection: hold back a lone jump until the next pulse confirms it
+    if (f->glitch_us > 0) {
+        if (monitor->glitch_last_us != 0 && abs(pulse_us - monitor->glitch_last_us) > f->glitch_us) {
+            bool confirmed = monitor->glitch_candidate_us != 0 &&
+                             abs(pulse_us - monitor->glitch_candidate_us) <= f->glitch_us;
+            if (!confirmed) {
+                monitor->glitch_candidate_us = pulse_us;
+                return false;
+            }
+        }
+        monitor->glitch_last_us = pulse_us;
+        monitor->glitch_candidate_us = 0;
+    }
+    
+    float value = (float)pulse_us;
+    
+    // Median of the last N pulses (insertion sort of at most 9 values)
+    if (f->median_samples > 1) {
+        monitor->median_buf[monitor->median_pos] = pulse_us;
+        monitor->median_pos = (monitor->median_pos + 1) % f->median_samples;
+        if (monitor->median_count < f->median_samples) monitor->median_count++;
+        
+        int sorted[PWM_FILTER_MAX_MEDIAN];
+        int n = monitor->median_count;
+        for (int i = 0; i < n; i++) {
+            int v = monitor->median_buf[i];
+            int j = i;
+            while (j > 0 && sorted[j - 1] > v) {
+                sorted[j] = sorted[j - 1];
+                j--;
+            }
+            sorted[j] = v;
+        }
+        value = (n & 1) ? (float)sorted[n / 2] : 0.5f * (float)(sorted[n / 2 - 1] + sorted[n / 2]);
+    }
+    
+    // One-pole IIR
+    if (f->ema_alpha > 0.0f && f->ema_alpha < 1.0f) {
+        if (monitor->filter_primed) {
+            value = monitor->ema_us + f->ema_alpha * (value - monitor->ema_us);
+        }
+        monitor->ema_us = value;
+    }
+    
+    // Slew limit relative to the previous output, scaled by the edge interval
+    if (f->rate_limit_us_per_s > 0 && monitor->filter_primed) {
+        float max_step = (float)f->rate_limit_us_per_s * (float)(ts_ns - monitor->rate_last_ns) / 1e9f;
+        if (value > monitor->rate_last_us + max_step) value = monitor->rate_last_us + max_step;
+        if (value < monitor->rate_last_us - max_step) value = monitor->rate_last_us - max_step;
+    }
+    monitor->rate_last_us = value;
+    monitor->rate_last_ns = ts_ns;
+    monitor->filter_primed = true;
+    
+    *out_us = (int)lrintf(value);
+    return true;
+}
+
+// Track the frame period as the median of recent pulse intervals, so a dropped
+// pulse (double interval) or a glitch does not move it
+static void pwm_period_detect(PWMMonitor *monitor, int64_t interval_ns) {
+    if (interval_ns < PWM_FRAME_PERIOD_MIN_US * 1000LL || interval_ns > PWM_FRAME_PERIOD_MAX_US * 1000LL) {
+        return;
+    }
+    
+    monitor->period_hist_ns[monitor->period_hist_pos] = interval_ns;
+    monitor->period_hist_pos = (monitor->period_hist_pos + 1) % PWM_PERIOD_HISTORY;
+    if (monitor->period_hist_count < PWM_PERIOD_HISTORY) {
+        monitor->period_hist_count++;
+        if (monitor->period_hist_count < PWM_PERIOD_HISTORY) return;  // Wait for a full history
+    }
+    
+    int64_t sorted[PWM_PERIOD_HISTORY];
+    memcpy(sorted, monitor->period_hist_ns, sizeof(sorted));
+    for (int i = 1; i < PWM_PERIOD_HISTORY; i++) {
+        for (int j = i; j > 0 && sorted[j] < sorted[j - 1]; j--) {
+            int64_t t = sorted[j]; sorted[j] = sorted[j - 1]; sorted[j - 1] = t;
+        }
+    }
+    int64_t period_ns = sorted[PWM_PERIOD_HISTORY / 2];
+    atomic_store_explicit(&monitor->frame_period_ns, period_ns, memory_order_relaxed);
+    
+    // Report the first detection and any change of more than 10%
+    int64_t logged = monitor->period_logged_ns;
+    if (logged == 0 || period_ns * 10 < logged * 9 || period_ns * 10 > logged * 11) {
+        monitor->period_logged_ns = period_ns;
+        int pulses = atomic_load_explicit(&monitor->avg_window_pulses, memory_order_relaxed);
+        LOG_INFO(LOG_GPIO, "Frame period on [%s]: %.2f ms (%.0f Hz), averaging %d pulses = %.1f ms",
+                 monitor->feature_name ?: "Unknown", (double)period_ns / 1e6, 1e9 / (double)period_ns,
+                 pulses, (double)(pulses * period_ns) / 1e6);
+    }
+}
+
+// Update frame rate and jitter statistics for an in-range pulse
+static void pwm_health_on_pulse(PWMMonitor *monitor, int64_t ts_ns) {
+    int64_t last_ns = atomic_load_explicit(&monitor->last_valid_ns, memory_order_relaxed);
+    
+    if (last_ns != 0) {
+        pwm_period_detect(monitor, ts_ns - last_ns);
+    }
+    
+    // Ignore gaps long enough to be a dropout rather than a frame period
+    if (last_ns != 0 && ts_ns - last_ns < 1000000000LL) {
+        float period_us = (float)(ts_ns - last_ns) / 1000.0f;
+        if (monitor->period_avg_us == 0.0f) {
+            monitor->period_avg_us = period_us;
+        }
+        monitor->jitter_avg_us += 0.1f * (fabsf(period_us - monitor->period_avg_us) - monitor->jitter_avg_us);
+        monitor->period_avg_us += 0.1f * (period_us - monitor->period_avg_us);
+        
+        atomic_store_explicit(&monitor->frame_rate_mhz, (int)(1e9f / monitor->period_avg_us), memory_order_relaxed);
+        atomic_store_explicit(&monitor->jitter_us, (int)monitor->jitter_avg_us, memory_order_relaxed);
+    }
+    
+    atomic_store_explicit(&monitor->last_valid_ns, ts_ns, memory_order_relaxed);
+    atomic_fetch_add_explicit(&monitor->valid_pulses, 1, memory_order_relaxed);
+}
+
+// Release pwm_monitors_mutex, then run the callbacks collected while it was held
+static void pwm_unlock_run_callbacks(PWMCallbackBatch *batch) {
+    if (batch->count == 0) {
+        mtx_unlock(&pwm_monitors_mutex);
+        return;
+    }
+    
+    mtx_lock(&pwm_callback_mutex);
+    mtx_unlock(&pwm_monitors_mutex);
+    for (int i = 0; i < batch->count; i++) {
+        batch->calls[i].callback(batch->calls[i].reading, batch->calls[i].user_data);
+    }
+    batch->count = 0;
+    mtx_unlock(&pwm_callback_mutex);
+}
+
+// Run one decoded pulse through health tracking, filters, averaging and notification.
+// Shared by GPIO edges and injected (virtual) pulses; caller holds pwm_monitors_mutex
+// and runs the collected callbacks after releasing it.
+static void pwm_process_pulse(PWMMonitor *monitor, int pulse_width, int64_t ns, PWMCallbackBatch *callbacks) {
+    // Sanity check: typical RC PWM is 1000-2000µs, allow 500-3000µs
+    bool in_range = pulse_width >= 500 && pulse_width <= 3000;
+    if (in_range) {
+        pwm_health_on_pulse(monitor, ns);
+    } else {
+        atomic_fetch_add_explicit(&monitor->rejected_pulses, 1, memory_order_relaxed);
+    }
+    
+    if (in_range && pwm_filter_apply(monitor, pulse_width, ns, &pulse_width)) {
+        if (!atomic_load(&monitor->first_signal_received)) {
+            LOG_INFO(LOG_GPIO, "First PWM signal received on [%s] pin %d: %d µs",
+                     monitor->feature_name ?: "Unknown", monitor->pin, pulse_width);
+            atomic_store(&monitor->first_signal_received, true);
+        }
+        
+        // Update current reading atomically
+        atomic_store(&monitor->current_pin, monitor->pin);
+        atomic_store(&monitor->current_duration_us, pulse_width);
+        atomic_store(&monitor->current_ts_ns, ns);
+        atomic_store(&monitor->has_new_reading, true);
+        
+        // Fold into the averaging window (timestamps are CLOCK_MONOTONIC)
+        pwm_window_push(monitor, pulse_width, ns);
+        
+        // Queue the user callback (runs once pwm_monitors_mutex is released)
+        if (monitor->callback && callbacks->count < PWM_CALLBACK_BATCH) {
+            PWMCallbackBatch *b = callbacks;
+            b->calls[b->count].callback = monitor->callback;
+            b->calls[b->count].user_data = monitor->user_data;
+            b->calls[b->count].reading = (PWMReading){ .pin = monitor->pin, .duration_us = pulse_width,
+                                                       .timestamp_ns = ns };
+            b->count++;
+        }
+        
+        // Decoded outputs are republished on every pulse so their health stays live
+        if (monitor->decoder && channel_decoder_feed(monitor->decoder, pulse_width)) {
+            for (int i = 0; i < monitor->decoder->outputs; i++) {
+                PWMMonitor *out = monitor->decoder_outputs[i];
+                if (out && atomic_load(&out->active)) {
+                    pwm_process_pulse(out, channel_decoder_output_us(monitor->decoder, i), ns, callbacks);
+                }
+            }
+        }
+    }
+}
+
+// Decode a PPM edge: channel values are the intervals between rising edges
+// (the same for either signal polarity) and a long interval marks the frame end.
+// A frame is published only when its channel count matches the previous one,
+// so a missed edge costs one frame instead of shifting channels.
+static void process_ppm_event(PWMMonitor *monitor, bool rising, int64_t ns, PWMCallbackBatch *callbacks) {
+    if (!rising) return;
+    
+    int64_t last_ns = monitor->ppm_last_edge_ns;
+    monitor->ppm_last_edge_ns = ns;
+    if (last_ns == 0) return;
+    
+    int interval_us = (int)((ns - last_ns) / 1000);
+    
+    if (interval_us >= PPM_SYNC_MIN_US) {
+        int count = monitor->ppm_index;
+        if (count >= PPM_MIN_CHANNELS && count == monitor->ppm_last_count) {
+            pwm_health_on_pulse(monitor, ns);
+            atomic_store_explicit(&monitor->ppm_channel_count, count, memory_order_relaxed);
+            for (int ch = 0; ch < count; ch++) {
+                PWMMonitor *out = monitor->ppm_outputs[ch];
+                if (out && atomic_load(&out->active)) {
+                    pwm_process_pulse(out, monitor->ppm_values_us[ch], ns, callbacks);
+                }
+            }
+        } else if (count > 0 && monitor->ppm_last_count > 0) {
+            atomic_fetch_add_explicit(&monitor->rejected_pulses, 1, memory_order_relaxed);  // Frame shape changed
+        }
+        monitor->ppm_last_count = count;
+        monitor->ppm_index = 0;
+        return;
+    }
+    
+    if (monitor->ppm_index < 0) return;  // Waiting for the first sync gap
+    
+    if (monitor->ppm_index >= PPM_MAX_CHANNELS) {
+        // Too many channels without a sync gap: not a PPM frame, resynchronise
+        atomic_fetch_add_explicit(&monitor->rejected_pulses, 1, memory_order_relaxed);
+        monitor->ppm_index = -1;
+        monitor->ppm_last_count = 0;
+        return;
+    }
+    
+    monitor->ppm_values_us[monitor->ppm_index++] = interval_us;
+}
+
+// Tachometer edge: fold a rising edge into the sliding window and publish the mean interval.
+// Falling edges only appear in replayed traces (the line requests rising edges only).
+static void process_tach_event(PWMMonitor *monitor, bool rising, int64_t ns) {
+    if (!rising) return;
+    
+    int64_t *ring = monitor->tach_edges_ns;
+    if (monitor->tach_count > 0) {
+        int64_t newest = ring[(monitor->tach_head + monitor->tach_count - 1) & TACH_RING_MASK];
+        if (ns - newest < TACH_BOUNCE_NS) {
+            atomic_fetch_add_explicit(&monitor->tach_rejected, 1, memory_order_relaxed);
+            return;
+        }
+    }
+    
+    if (monitor->tach_count == TACH_RING_SIZE) {
+        monitor->tach_head = (monitor->tach_head + 1) & TACH_RING_MASK;
+        monitor->tach_count--;
+    }
+    ring[(monitor->tach_head + monitor->tach_count) & TACH_RING_MASK] = ns;
+    monitor->tach_count++;
+    
+    // Slide the window, keeping two edges so slow inputs still give one interval
+    while (monitor->tach_count > 2 && ns - ring[monitor->tach_head] > monitor->tach_window_ns) {
+        monitor->tach_head = (monitor->tach_head + 1) & TACH_RING_MASK;
+        monitor->tach_count--;
+    }
+    int64_t period_ns = monitor->tach_count >= 2
+        ? (ns - ring[monitor->tach_head]) / (monitor->tach_count - 1) : 0;
+    
+    unsigned int seq = atomic_load_explicit(&monitor->tach_seq, memory_order_relaxed);
+    atomic_store_explicit(&monitor->tach_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&monitor->tach_period_ns, period_ns, memory_order_relaxed);
+    atomic_store_explicit(&monitor->tach_last_ns, ns, memory_order_relaxed);
+    atomic_store_explicit(&monitor->tach_seq, seq + 2, memory_order_release);
+    atomic_fetch_add_explicit(&monitor->tach_edges, 1, memory_order_relaxed);
+}
+
+// Process an edge for a specific monitor (from the chip or a replayed trace)
+static void process_pwm_event(PWMMonitor *monitor, bool rising, uint64_t ns, PWMCallbackBatch *callbacks) {
+#ifdef GPIO_BENCH
+    GPIOBenchEdgeHook hook = atomic_load_explicit(&bench_edge_hook, memory_order_relaxed);
+    if (hook) {
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        hook(monitor->pin, ns, (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec);
+    }
+#endif
+    
+    if (monitor->ppm_mode) {
+        process_ppm_event(monitor, rising, (int64_t)ns, callbacks);
+        return;
+    }
+    if (monitor->tach_mode) {
+        process_tach_event(monitor, rising, (int64_t)ns);
+        return;
+    }
+    
+    if (rising) {
         // Rising edge - start of pulse
-        uint64_t ns = gpiod_edge_event_get_timestamp_ns(event);
         monitor->rise_time.tv_sec = ns / 1000000000;
         monitor->rise_time.tv_nsec = ns % 1000000000;
         atomic_store(&monitor->waiting_for_fall, true);
-    } else if (gpiod_edge_event_get_event_type(event) == GPIOD_EDGE_EVENT_FALLING_EDGE && atomic_load(&monitor->waiting_for_fall)) {
+    } else if (atomic_load(&monitor->waiting_for_fall)) {
         // Falling edge - end of pulse, calculate pulse width
-        uint64_t ns = gpiod_edge_event_get_timestamp_ns(event);
         struct timespec fall_time = {
             .tv_sec = ns / 1000000000,
             .tv_nsec = ns % 1000000000
@@ -355,75 +967,210 @@ static void process_pwm_event(PWMMonitor *monitor, struct gpiod_edge_event *even
         
         int64_t rise_us = timespec_to_us(&monitor->rise_time);
         int64_t fall_us = timespec_to_us(&fall_time);
-        int pulse_width = (int)(fall_us - rise_us);
-        
-        // Sanity check: typical RC PWM is 1000-2000µs, allow 500-3000µs
-        if (pulse_width >= 500 && pulse_width <= 3000) {
-            if (!atomic_load(&monitor->first_signal_received)) {
-                LOG_INFO(LOG_GPIO, "First PWM signal received on [%s] pin %d: %d µs",
-                         monitor->feature_name ?: "Unknown", monitor->pin, pulse_width);
-                atomic_store(&monitor->first_signal_received, true);
+        pwm_process_pulse(monitor, (int)(fall_us - rise_us), (int64_t)ns, callbacks);
+        atomic_store(&monitor->waiting_for_fall, false);
+    }
+}
+
+// Append one edge to the trace being recorded. Caller holds pwm_monitors_mutex.
+static void trace_write_edge(unsigned int offset, bool rising, uint64_t ns) {
+    uint8_t record[GPIO_TRACE_RECORD_SIZE];
+    uint16_t line = (uint16_t)offset;   // gpio_trace_record_start() checked the chip fits
+    memcpy(record, &ns, sizeof(ns));
+    memcpy(record + 8, &line, sizeof(line));
+    record[10] = rising ? 1 : 0;
+    if (fwrite(record, sizeof(record), 1, trace_record_file) == 1) {
+        trace_record_edges++;
+    }
+}
+
+// Demultiplex one event of the shared edge request. Caller holds pwm_monitors_mutex.
+static void pwm_handle_edge_event(struct gpiod_edge_event *event, PWMCallbackBatch *callbacks) {
+    if (!event) return;
+    
+    unsigned int offset = gpiod_edge_event_get_line_offset(event);
+    bool rising = gpiod_edge_event_get_event_type(event) == GPIOD_EDGE_EVENT_RISING_EDGE;
+    uint64_t ns = gpiod_edge_event_get_timestamp_ns(event);
+    if (trace_record_file) {
+        trace_write_edge(offset, rising, ns);
+    }
+    
+    PWMMonitor *monitor = (offset < gpio_num_lines) ? pwm_line_map[offset] : NULL;
+    if (monitor && monitor->registered) {
+        process_pwm_event(monitor, rising, ns, callbacks);
+    }
+}
+
+// Process the edges still queued on the request about to be released, so
+// starting or stopping one monitor does not drop in-flight pulses on the
+// others. Caller holds pwm_monitors_mutex.
+static void pwm_request_drain(PWMCallbackBatch *callbacks) {
+    struct pollfd pfd = { .fd = gpiod_line_request_get_fd(pwm_request), .events = POLLIN };
+    while (callbacks->count <= PWM_CALLBACK_BATCH - PWM_CALLBACKS_PER_EDGE && poll(&pfd, 1, 0) > 0) {
+        int count = gpiod_line_request_read_edge_events(pwm_request, pwm_edge_buffer, pwm_edge_batch);
+        if (count <= 0) break;
+        for (int j = 0; j < count; j++) {
+            pwm_handle_edge_event(gpiod_edge_event_buffer_get_event(pwm_edge_buffer, j), callbacks);
+        }
+    }
+}
+
+// Re-request the shared edge request for the current set of active monitors.
+// A request cannot gain or lose lines in place (gpiod_line_request_reconfigure_lines()
+// only changes settings of lines it already holds), so it is released and
+// requested again. Queued edges are drained first; only edges in the short
+// gap until the new request is in place are lost, at most one pulse per
+// running channel. Caller holds pwm_monitors_mutex and runs the collected
+// callbacks after releasing it.
+static int pwm_request_rebuild(PWMCallbackBatch *callbacks) {
+    if (pwm_request) {
+        pwm_request_drain(callbacks);
+        gpiod_line_request_release(pwm_request);
+        pwm_request = NULL;
+    }
+    memset(pwm_line_map, 0, gpio_num_lines * sizeof(*pwm_line_map));
+    
+    // Tachometer lines only need rising edges, which halves their event rate.
+    // PWM offsets fill the array from the front, tachometer offsets from the back.
+    unsigned int *offsets = active_monitor_count > 0 ? malloc((size_t)active_monitor_count * sizeof(*offsets)) : NULL;
+    if (active_monitor_count > 0 && !offsets) {
+        LOG_ERROR(LOG_GPIO, "Cannot allocate edge request offsets");
+        return -1;
+    }
+    size_t num_pwm_lines = 0;
+    size_t num_tach_lines = 0;
+    for (MonitorBlock *block = monitor_blocks; block; block = block->next) {
+        for (int i = 0; i < block->capacity; i++) {
+            PWMMonitor *monitor = &block->monitors[i];
+            if (!monitor->in_use || !monitor->registered) continue;
+            if (monitor->tach_mode) {
+                offsets[active_monitor_count - 1 - (int)num_tach_lines++] = (unsigned int)monitor->pin;
+            } else {
+                offsets[num_pwm_lines++] = (unsigned int)monitor->pin;
             }
+            pwm_line_map[monitor->pin] = monitor;
+        }
+    }
+    unsigned int *tach_offsets = offsets ? offsets + active_monitor_count - num_tach_lines : NULL;
+    size_t num_lines = num_pwm_lines + num_tach_lines;
+    
+    // Grow the shared read buffer when more lines are requested than were planned for
+    size_t batch = (size_t)PWM_EDGE_EVENTS_PER_LINE * num_lines;
+    if (batch > pwm_edge_batch) {
+        struct gpiod_edge_event_buffer *buffer = gpiod_edge_event_buffer_new(batch);
+        if (buffer) {
+            gpiod_edge_event_buffer_free(pwm_edge_buffer);
+            pwm_edge_buffer = buffer;
+            pwm_edge_batch = batch;
+        } else {
+            LOG_WARN(LOG_GPIO, "Cannot grow PWM edge buffer to %zu events; reading in smaller batches", batch);
+        }
+    }
+    
+    int result = 0;
+    if (num_lines > 0 && !trace_replay_path) {  // Replay only needs the line map
+        struct gpiod_line_settings *settings = gpiod_line_settings_new();
+        struct gpiod_line_settings *tach_settings = gpiod_line_settings_new();
+        struct gpiod_request_config *req_cfg = gpiod_request_config_new();
+        struct gpiod_line_config *line_cfg = gpiod_line_config_new();
+        
+        if (settings && tach_settings && req_cfg && line_cfg) {
+            gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
+            gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+            gpiod_line_settings_set_direction(tach_settings, GPIOD_LINE_DIRECTION_INPUT);
+            gpiod_line_settings_set_edge_detection(tach_settings, GPIOD_LINE_EDGE_RISING);
+            gpiod_request_config_set_consumer(req_cfg, "sfxhub-pwm");
+            gpiod_request_config_set_event_buffer_size(req_cfg, PWM_EDGE_EVENTS_PER_LINE * num_lines);
             
-            // Update current reading atomically
-            atomic_store(&monitor->current_pin, monitor->pin);
-            atomic_store(&monitor->current_duration_us, pulse_width);
-            atomic_store(&monitor->has_new_reading, true);
-            
-            // Append to averaging buffer
-            int head = atomic_load(&monitor->sample_head);
-            clock_gettime(CLOCK_MONOTONIC, &monitor->samples[head].ts);
-            atomic_store(&monitor->samples[head].duration_us, pulse_width);
-            atomic_store(&monitor->sample_head, (head + 1) % PWM_AVG_MAX_SAMPLES);
-            
-            // Call user callback if set
-            if (monitor->callback) {
-                PWMReading reading;
-                reading.pin = monitor->pin;
-                reading.duration_us = pulse_width;
-                monitor->callback(reading, monitor->user_data);
+            bool ok = true;
+            if (num_pwm_lines > 0) {
+                ok = gpiod_line_config_add_line_settings(line_cfg, offsets, num_pwm_lines, settings) == 0;
+            }
+            if (ok && num_tach_lines > 0) {
+                ok = gpiod_line_config_add_line_settings(line_cfg, tach_offsets, num_tach_lines, tach_settings) == 0;
+            }
+            if (ok) {
+                pwm_request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
             }
         }
-        atomic_store(&monitor->waiting_for_fall, false);
+        
+        if (line_cfg) gpiod_line_config_free(line_cfg);
+        if (req_cfg) gpiod_request_config_free(req_cfg);
+        if (tach_settings) gpiod_line_settings_free(tach_settings);
+        if (settings) gpiod_line_settings_free(settings);
+        
+        if (!pwm_request) {
+            LOG_ERROR(LOG_GPIO, "Failed to request edge events for %zu PWM lines: %s", num_lines, strerror(errno));
+            memset(pwm_line_map, 0, gpio_num_lines * sizeof(*pwm_line_map));
+            result = -1;
+        }
+    }
+    free(offsets);
+    
+    // Make the monitoring thread drop the fd it is polling
+    pwm_request_generation++;
+    if (pwm_wake_fd >= 0) {
+        eventfd_write(pwm_wake_fd, 1);
+    }
+    return result;
+}
+
+#ifdef ALLOC_CHECK
+#define ALLOC_CHECK_INTERVAL_S 5
+
+// Log edges handled and heap allocations made by the monitoring thread every few seconds.
+// The first interval includes one-off startup allocations (stdio buffers etc.); every
+// later interval must report zero. Callbacks run on this thread, so they are covered too.
+static void alloc_check_report(uint64_t *edges, struct timespec *last) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    if (now.tv_sec - last->tv_sec < ALLOC_CHECK_INTERVAL_S) {
+        return;
+    }
+    
+    uint64_t allocations = alloc_check_thread_count();
+    if (allocations > 0) {
+        LOG_WARN(LOG_GPIO, "PWM hot loop: %llu edges, %llu heap allocations in last %ds",
+                 (unsigned long long)*edges, (unsigned long long)allocations, ALLOC_CHECK_INTERVAL_S);
+    } else {
+        LOG_INFO(LOG_GPIO, "PWM hot loop: %llu edges, 0 heap allocations in last %ds",
+                 (unsigned long long)*edges, ALLOC_CHECK_INTERVAL_S);
     }
+    
+    // Restart counting after logging so the log call itself is not counted
+    alloc_check_thread_enable(true);
+    *edges = 0;
+    *last = now;
 }
+#endif
 
-// Single PWM monitoring thread - polls all active monitors using poll()
+// Single PWM monitoring thread - one fd for all PWM lines, edges demultiplexed by offset
 static int pwm_monitoring_thread_func(void *arg) {
     (void)arg;  // Unused
     
-    struct pollfd fds[MAX_PWM_MONITORS];
+    struct pollfd fds[2] = {
+        { .fd = -1, .events = POLLIN },           // Shared edge request
+        { .fd = pwm_wake_fd, .events = POLLIN },  // Request rebuilt / shutdown
+    };
+    static PWMCallbackBatch callbacks;  // Monitoring thread only
     
+    rt_sched_apply(RT_ROLE_INPUT, "sfx-pwm");
     LOG_INFO(LOG_GPIO, "PWM monitoring thread started");
     
+#ifdef ALLOC_CHECK
+    uint64_t check_edges = 0;
+    struct timespec check_last;
+    clock_gettime(CLOCK_MONOTONIC, &check_last);
+    alloc_check_thread_enable(true);
+#endif
+    
     while (atomic_load(&pwm_thread_running)) {
-        // Build pollfd array from active monitors
-        int nfds = 0;
-        PWMMonitor *monitor_map[MAX_PWM_MONITORS] = {0};  // Map fd index to monitor
-        
         mtx_lock(&pwm_monitors_mutex);
-        for (int i = 0; i < MAX_PWM_MONITORS; i++) {
-            if (active_monitors[i] && atomic_load(&active_monitors[i]->active)) {
-                int fd = gpiod_line_request_get_fd(active_monitors[i]->line_request);
-                if (fd >= 0) {
-                    fds[nfds].fd = fd;
-                    fds[nfds].events = POLLIN;
-                    fds[nfds].revents = 0;
-                    monitor_map[nfds] = active_monitors[i];
-                    nfds++;
-                }
-            }
-        }
+        fds[0].fd = pwm_request ? gpiod_line_request_get_fd(pwm_request) : -1;  // poll() skips -1
+        unsigned int generation = pwm_request_generation;
         mtx_unlock(&pwm_monitors_mutex);
         
-        if (nfds == 0) {
-            // No active monitors, sleep and retry
-            usleep(100000);  // 100ms
-            continue;
-        }
-        
-        // Poll with timeout
-        int ret = poll(fds, nfds, 1000);  // 1 second timeout
+        int ret = poll(fds, 2, 1000);  // 1 second timeout
         if (ret < 0) {
             if (errno == EINTR) continue;
             LOG_ERROR(LOG_GPIO, "poll() error: %s", strerror(errno));
@@ -432,134 +1179,410 @@ static int pwm_monitoring_thread_func(void *arg) {
         
         if (ret == 0) continue;  // Timeout
         
-        // Check which monitors have events
-        for (int i = 0; i < nfds; i++) {
-            if (fds[i].revents & POLLIN) {
-                PWMMonitor *monitor = monitor_map[i];
-                if (!monitor) continue;
-                
-                // Read all pending events for this monitor
-                struct gpiod_edge_event_buffer *buffer = gpiod_edge_event_buffer_new(16);
-                if (!buffer) continue;
+        if (fds[1].revents & POLLIN) {
+            eventfd_t value;
+            eventfd_read(pwm_wake_fd, &value);
+        }
+        
+        if (!(fds[0].revents & POLLIN)) continue;
+        
+        mtx_lock(&pwm_monitors_mutex);
+        
+        // The request may have been replaced while we were polling its fd
+        if (generation == pwm_request_generation && pwm_request) {
+            // One batched read covers every channel's pending edges
+            int count = gpiod_line_request_read_edge_events(pwm_request, pwm_edge_buffer, pwm_edge_batch);
+            for (int j = 0; j < count; j++) {
+                pwm_handle_edge_event(gpiod_edge_event_buffer_get_event(pwm_edge_buffer, j), &callbacks);
                 
-                int ret = gpiod_line_request_read_edge_events(monitor->line_request, buffer, 16);
-                if (ret > 0) {
-                    for (int j = 0; j < ret; j++) {
-                        struct gpiod_edge_event *event = gpiod_edge_event_buffer_get_event(buffer, j);
-                        if (event) {
-                            process_pwm_event(monitor, event);
-                        }
-                    }
+                // Batch full: run it; a request rebuilt meanwhile invalidates the rest of the read
+                if (callbacks.count > PWM_CALLBACK_BATCH - PWM_CALLBACKS_PER_EDGE) {
+                    pwm_unlock_run_callbacks(&callbacks);
+                    mtx_lock(&pwm_monitors_mutex);
+                    if (generation != pwm_request_generation) break;
                 }
-                gpiod_edge_event_buffer_free(buffer);
             }
+#ifdef ALLOC_CHECK
+            if (count > 0) {
+                check_edges += (uint64_t)count;
+            }
+#endif
         }
+        
+        pwm_unlock_run_callbacks(&callbacks);
+        
+#ifdef ALLOC_CHECK
+        alloc_check_report(&check_edges, &check_last);
+#endif
     }
     
     LOG_INFO(LOG_GPIO, "PWM monitoring thread stopped");
     return 0;
 }
 
-PWMMonitor* pwm_monitor_create(int pin, PWMCallback callback, void *user_data) {
-    return pwm_monitor_create_with_name(pin, nullptr, callback, user_data);
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
 }
 
-PWMMonitor* pwm_monitor_create_with_name(int pin, const char *feature_name, PWMCallback callback, void *user_data) {
-    if (!initialized || !chip) {
-        LOG_ERROR(LOG_GPIO, "GPIO not initialized");
-        return nullptr;
-    }
+// Sleep until a CLOCK_MONOTONIC deadline; returns false if the thread is being stopped
+static bool replay_sleep_until(int64_t target_ns) {
+    struct pollfd wake = { .fd = pwm_wake_fd, .events = POLLIN };
     
-    if (pin < 0 || pin > 27) {
-        LOG_ERROR(LOG_GPIO, "Invalid pin number %d (must be 0-27)", pin);
-        return nullptr;
+    while (atomic_load(&pwm_thread_running)) {
+        int64_t wait_ns = target_ns - monotonic_ns();
+        if (wait_ns <= 0) {
+            return true;
+        }
+        if (wait_ns > 2000000) {
+            // Long gaps: stay responsive to shutdown, finish with a precise sleep
+            if (poll(&wake, 1, (int)(wait_ns / 1000000) - 1) > 0) {
+                eventfd_t value;
+                eventfd_read(pwm_wake_fd, &value);
+            }
+        } else {
+            struct timespec ts = {
+                .tv_sec = target_ns / 1000000000LL,
+                .tv_nsec = target_ns % 1000000000LL
+            };
+            clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+        }
     }
-    
-    PWMMonitor *monitor = calloc(1, sizeof(PWMMonitor));
-    if (!monitor) {
-        LOG_ERROR(LOG_GPIO, "Cannot allocate memory for PWM monitor");
-        return nullptr;
+    return false;
+}
+
+// Replay thread - stands in for the monitoring thread and pushes recorded edges
+// through process_pwm_event(). Timestamps are shifted to the current monotonic
+// clock so health and averaging behave as with live input.
+static int pwm_replay_thread_func(void *arg) {
+    (void)arg;
+    static PWMCallbackBatch callbacks;  // Replay thread only
+    
+    FILE *file = fopen(trace_replay_path, "rb");
+    char magic[GPIO_TRACE_MAGIC_LEN];
+    bool v1 = false;
+    if (file && fread(magic, sizeof(magic), 1, file) == 1) {
+        v1 = memcmp(magic, GPIO_TRACE_MAGIC_V1, GPIO_TRACE_MAGIC_LEN) == 0;
     }
-    
-    monitor->pin = pin;
-    monitor->feature_name = feature_name ? strdup(feature_name) : nullptr;
-    monitor->callback = callback;
-    monitor->user_data = user_data;
-    atomic_init(&monitor->active, false);
-    atomic_init(&monitor->has_new_reading, false);
-    atomic_init(&monitor->first_signal_received, false);
-    atomic_init(&monitor->waiting_for_fall, false);
-    atomic_init(&monitor->avg_window_ms, 200);
-    atomic_init(&monitor->sample_head, 0);
-    atomic_init(&monitor->current_pin, 0);
-    atomic_init(&monitor->current_duration_us, 0);
-    
-    // Clear sample buffer and initialize atomics
-    for (int i = 0; i < PWM_AVG_MAX_SAMPLES; i++) {
-        atomic_init(&monitor->samples[i].duration_us, 0);
-        monitor->samples[i].ts.tv_sec = 0;
-        monitor->samples[i].ts.tv_nsec = 0;
+    if (!file || (!v1 && memcmp(magic, GPIO_TRACE_MAGIC, GPIO_TRACE_MAGIC_LEN) != 0)) {
+        LOG_ERROR(LOG_GPIO, "Cannot replay %s: not an edge trace (%s)",
+                  trace_replay_path, file ? "bad header" : strerror(errno));
+        if (file) fclose(file);
+        return -1;
     }
+    size_t record_size = v1 ? GPIO_TRACE_RECORD_SIZE_V1 : GPIO_TRACE_RECORD_SIZE;
     
-    // Create line settings for edge detection
-    struct gpiod_line_settings *settings = gpiod_line_settings_new();
-    if (!settings) {
-        LOG_ERROR(LOG_GPIO, "Failed to create line settings");
-        free(monitor->feature_name);
-        free(monitor);
-        return nullptr;
-    }
+    rt_sched_apply(RT_ROLE_INPUT, "sfx-pwm-replay");
+    LOG_INFO(LOG_GPIO, "PWM edge replay thread started");
     
-    gpiod_line_settings_set_direction(settings, GPIOD_LINE_DIRECTION_INPUT);
-    gpiod_line_settings_set_edge_detection(settings, GPIOD_LINE_EDGE_BOTH);
+    uint8_t records[GPIO_TRACE_READ_BATCH * GPIO_TRACE_RECORD_SIZE];
+    int64_t base_ns = monotonic_ns();
+    int64_t last_ns = base_ns;
+    uint64_t first_ts = 0;
+    bool have_first = false;
+    uint64_t edges = 0;
+    uint64_t unmatched = 0;  // Edges on lines no monitor listens to
+    int64_t started_ns = base_ns;
     
-    // Create request config
-    struct gpiod_request_config *req_cfg = gpiod_request_config_new();
-    if (!req_cfg) {
-        gpiod_line_settings_free(settings);
-        free(monitor->feature_name);
-        free(monitor);
+    while (atomic_load(&pwm_thread_running)) {
+        size_t count = fread(records, record_size, GPIO_TRACE_READ_BATCH, file);
+        
+        if (count == 0) {
+            double wall_s = (double)(monotonic_ns() - started_ns) / 1e9;
+            LOG_INFO(LOG_GPIO, "Edge replay pass complete: %llu edges in %.3f s (%.0f edges/s)",
+                     (unsigned long long)edges, wall_s, wall_s > 0 ? (double)edges / wall_s : 0.0);
+            if (unmatched > 0) {
+                LOG_WARN(LOG_GPIO, "Edge replay dropped %llu of %llu edges on lines without a PWM monitor",
+                         (unsigned long long)unmatched, (unsigned long long)edges);
+            }
+            
+            if (!trace_replay_loop) {
+                // Keep the monitors alive (and in failsafe) until shutdown
+                struct pollfd wake = { .fd = pwm_wake_fd, .events = POLLIN };
+                while (atomic_load(&pwm_thread_running)) {
+                    if (poll(&wake, 1, 1000) > 0) {
+                        eventfd_t value;
+                        eventfd_read(pwm_wake_fd, &value);
+                    }
+                }
+                break;
+            }
+            
+            // Next pass continues the timeline after a short gap
+            fseek(file, GPIO_TRACE_MAGIC_LEN, SEEK_SET);
+            base_ns = last_ns + GPIO_TRACE_LOOP_GAP_NS;
+            have_first = false;
+            edges = 0;
+            unmatched = 0;
+            started_ns = monotonic_ns();
+            continue;
+        }
+        
+        for (size_t i = 0; i < count; i++) {
+            const uint8_t *record = records + i * record_size;
+            uint64_t ts;
+            memcpy(&ts, record, sizeof(ts));
+            unsigned int offset = record[8];
+            if (!v1) {
+                uint16_t line;
+                memcpy(&line, record + 8, sizeof(line));
+                offset = line;
+            }
+            bool rising = record[record_size - 1] != 0;
+            
+            if (!have_first) {
+                first_ts = ts;
+                have_first = true;
+            }
+            int64_t ns = base_ns + (int64_t)(ts - first_ts);
+            if (trace_replay_realtime && !replay_sleep_until(ns)) {
+                break;
+            }
+            
+            mtx_lock(&pwm_monitors_mutex);
+            PWMMonitor *monitor = (offset < gpio_num_lines) ? pwm_line_map[offset] : NULL;
+            if (monitor) {
+                process_pwm_event(monitor, rising, (uint64_t)ns, &callbacks);
+            } else {
+                unmatched++;
+            }
+            pwm_unlock_run_callbacks(&callbacks);
+            
+            last_ns = ns;
+            edges++;
+        }
+    }
+    
+    fclose(file);
+    LOG_INFO(LOG_GPIO, "PWM edge replay thread stopped");
+    return 0;
+}
+
+int gpio_trace_set_replay(const char *path, bool realtime, bool loop) {
+    if (initialized) {
+        LOG_ERROR(LOG_GPIO, "Edge replay must be selected before gpio_init()");
+        return -1;
+    }
+    
+    free(trace_replay_path);
+    trace_replay_path = path ? strdup(path) : NULL;
+    trace_replay_realtime = realtime;
+    trace_replay_loop = loop;
+    return 0;
+}
+
+int gpio_trace_record_start(const char *path) {
+    if (!initialized || !path) return -1;
+    if (trace_replay_path) {
+        LOG_ERROR(LOG_GPIO, "Cannot record edges while replaying a trace");
+        return -1;
+    }
+    if (gpio_num_lines > UINT16_MAX + 1u) {
+        LOG_ERROR(LOG_GPIO, "Cannot record edges: %u lines exceed the trace's 16-bit line offsets", gpio_num_lines);
+        return -1;
+    }
+    
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        LOG_ERROR(LOG_GPIO, "Cannot create edge trace %s: %s", path, strerror(errno));
+        return -1;
+    }
+    
+    // Full buffering with a buffer allocated here keeps the hot loop allocation-free
+    char *buffer = malloc(GPIO_TRACE_IO_BUFFER);
+    if (!buffer || setvbuf(file, buffer, _IOFBF, GPIO_TRACE_IO_BUFFER) != 0 ||
+        fwrite(GPIO_TRACE_MAGIC, GPIO_TRACE_MAGIC_LEN, 1, file) != 1) {
+        LOG_ERROR(LOG_GPIO, "Cannot set up edge trace %s", path);
+        fclose(file);
+        free(buffer);
+        return -1;
+    }
+    
+    mtx_lock(&pwm_monitors_mutex);
+    if (trace_record_file) {
+        mtx_unlock(&pwm_monitors_mutex);
+        LOG_WARN(LOG_GPIO, "Edge trace already recording");
+        fclose(file);
+        free(buffer);
+        return -1;
+    }
+    trace_record_file = file;
+    trace_record_buffer = buffer;
+    trace_record_edges = 0;
+    mtx_unlock(&pwm_monitors_mutex);
+    
+    LOG_INFO(LOG_GPIO, "Recording PWM edges to %s", path);
+    return 0;
+}
+
+void gpio_trace_record_stop(void) {
+    if (!initialized) return;
+    
+    mtx_lock(&pwm_monitors_mutex);
+    FILE *file = trace_record_file;
+    char *buffer = trace_record_buffer;
+    uint64_t edges = trace_record_edges;
+    trace_record_file = NULL;
+    trace_record_buffer = NULL;
+    mtx_unlock(&pwm_monitors_mutex);
+    
+    if (file) {
+        fclose(file);
+        free(buffer);
+        LOG_INFO(LOG_GPIO, "Edge trace closed (%llu edges)", (unsigned long long)edges);
+    }
+}
+
+#ifdef GPIO_BENCH
+void gpio_bench_set_edge_hook(GPIOBenchEdgeHook hook) {
+    atomic_store(&bench_edge_hook, hook);
+}
+#endif
+
+static PWMMonitor* pwm_monitor_alloc(int pin, const char *feature_name, PWMCallback callback, void *user_data);
+
+PWMMonitor* pwm_monitor_create(int pin, PWMCallback callback, void *user_data) {
+    return pwm_monitor_create_with_name(pin, nullptr, callback, user_data);
+}
+
+PWMMonitor* pwm_monitor_create_with_name(int pin, const char *feature_name, PWMCallback callback, void *user_data) {
+    if (!initialized || (!chip && !trace_replay_path)) {
+        LOG_ERROR(LOG_GPIO, "GPIO not initialized");
         return nullptr;
     }
-    gpiod_request_config_set_consumer(req_cfg, "sfxhub-pwm");
     
-    // Create line config
-    struct gpiod_line_config *line_cfg = gpiod_line_config_new();
-    if (!line_cfg) {
-        gpiod_request_config_free(req_cfg);
-        gpiod_line_settings_free(settings);
-        free(monitor->feature_name);
-        free(monitor);
+    if (!is_chip_line(pin)) {
+        LOG_ERROR(LOG_GPIO, "Invalid pin number %d (must be 0-%u)", pin, gpio_num_lines - 1);
         return nullptr;
     }
     
-    unsigned int offset = (unsigned int)pin;
-    int ret = gpiod_line_config_add_line_settings(line_cfg, &offset, 1, settings);
-    if (ret < 0) {
-        gpiod_line_config_free(line_cfg);
-        gpiod_request_config_free(req_cfg);
-        gpiod_line_settings_free(settings);
-        free(monitor->feature_name);
-        free(monitor);
+    return pwm_monitor_alloc(pin, feature_name, callback, user_data);
+}
+
+PWMMonitor* pwm_monitor_create_virtual(const char *feature_name, PWMCallback callback, void *user_data) {
+    if (!initialized) {
+        LOG_ERROR(LOG_GPIO, "GPIO not initialized");
         return nullptr;
     }
     
-    // Request the line
-    struct gpiod_line_request *request = gpiod_chip_request_lines(chip, req_cfg, line_cfg);
+    return pwm_monitor_alloc(-1, feature_name, callback, user_data);
+}
+
+int gpio_set_monitor_capacity(int monitors) {
+    if (initialized) {
+        LOG_ERROR(LOG_GPIO, "Monitor capacity must be set before gpio_init()");
+        return -1;
+    }
+    if (monitors < 1) {
+        LOG_ERROR(LOG_GPIO, "Invalid monitor capacity %d", monitors);
+        return -1;
+    }
+    monitor_capacity = monitors;
+    return 0;
+}
+
+// Take a free, zeroed registry slot, adding a block when every slot is in use.
+// Caller holds pwm_monitors_mutex.
+static PWMMonitor* monitor_slot_acquire(void) {
+    MonitorBlock **tail = &monitor_blocks;
+    int total = 0;
+    for (MonitorBlock *block = monitor_blocks; block; block = block->next) {
+        for (int i = 0; i < block->capacity; i++) {
+            if (!block->monitors[i].in_use) {
+                memset(&block->monitors[i], 0, sizeof(PWMMonitor));
+                block->monitors[i].in_use = true;
+                return &block->monitors[i];
+            }
+        }
+        total += block->capacity;
+        tail = &block->next;
+    }
     
-    // Cleanup temporary objects
-    gpiod_line_config_free(line_cfg);
-    gpiod_request_config_free(req_cfg);
-    gpiod_line_settings_free(settings);
+    MonitorBlock *block = malloc(sizeof(MonitorBlock));
+    PWMMonitor *monitors = aligned_alloc(PWM_MONITOR_ALIGN, (size_t)monitor_capacity * sizeof(PWMMonitor));
+    if (!block || !monitors) {
+        free(block);
+        free(monitors);
+        return nullptr;
+    }
+    memset(monitors, 0, (size_t)monitor_capacity * sizeof(PWMMonitor));
+    block->next = NULL;
+    block->capacity = monitor_capacity;
+    block->monitors = monitors;
+    *tail = block;
+    if (total > 0) {
+        LOG_WARN(LOG_GPIO, "More than %d PWM monitors; registry grown to %d slots", total, total + monitor_capacity);
+    }
     
-    if (!request) {
-        LOG_ERROR(LOG_GPIO, "Failed to request edge events for pin %d: %s", pin, strerror(errno));
+    monitors[0].in_use = true;
+    return &monitors[0];
+}
+
+static void monitor_registry_free(void) {
+    while (monitor_blocks) {
+        MonitorBlock *block = monitor_blocks;
+        for (int i = 0; i < block->capacity; i++) {
+            if (block->monitors[i].in_use) {
+                LOG_WARN(LOG_GPIO, "PWM monitor [%s] still exists at GPIO cleanup",
+                         block->monitors[i].feature_name ?: "Unknown");
+            }
+        }
+        monitor_blocks = block->next;
+        free(block->monitors);
+        free(block);
+    }
+    active_monitor_count = 0;
+}
+
+static PWMMonitor* pwm_monitor_alloc(int pin, const char *feature_name, PWMCallback callback, void *user_data) {
+    mtx_lock(&pwm_monitors_mutex);
+    PWMMonitor *monitor = monitor_slot_acquire();
+    mtx_unlock(&pwm_monitors_mutex);
+    if (!monitor) {
+        LOG_ERROR(LOG_GPIO, "Cannot allocate memory for PWM monitor");
+        return nullptr;
+    }
+    
+    monitor->pin = pin;
+    monitor->feature_name = feature_name ? strdup(feature_name) : nullptr;
+    monitor->callback = callback;
+    monitor->user_data = user_data;
+    atomic_init(&monitor->active, false);
+    atomic_init(&monitor->has_new_reading, false);
+    atomic_init(&monitor->first_signal_received, false);
+    atomic_init(&monitor->waiting_for_fall, false);
+    atomic_init(&monitor->avg_window_pulses, PWM_AVG_WINDOW_DEFAULT_PULSES);
+    atomic_init(&monitor->frame_period_ns, 0);
+    monitor->filter = PWM_FILTER_DEFAULTS;
+    atomic_init(&monitor->current_pin, 0);
+    atomic_init(&monitor->current_duration_us, 0);
+    atomic_init(&monitor->current_ts_ns, 0);
+    atomic_init(&monitor->avg_seq, 0);
+    atomic_init(&monitor->avg_sum_us, 0);
+    atomic_init(&monitor->avg_count, 0);
+    atomic_init(&monitor->avg_newest_ns, 0);
+    atomic_init(&monitor->change_threshold_us, PWM_CHANGE_THRESHOLD_DEFAULT_US);
+    monitor->notified_avg_us = -1;
+    monitor->ppm_index = -1;
+    atomic_init(&monitor->last_valid_ns, 0);
+    atomic_init(&monitor->frame_rate_mhz, 0);
+    atomic_init(&monitor->jitter_us, 0);
+    atomic_init(&monitor->valid_pulses, 0);
+    atomic_init(&monitor->rejected_pulses, 0);
+    atomic_init(&monitor->failsafe_timeout_ms, PWM_FAILSAFE_TIMEOUT_DEFAULT_MS);
+    
+    monitor->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (monitor->event_fd < 0) {
+        LOG_ERROR(LOG_GPIO, "Cannot create event fd for PWM monitor: %s", strerror(errno));
         free(monitor->feature_name);
-        free(monitor);
+        mtx_lock(&pwm_monitors_mutex);
+        monitor->in_use = false;
+        mtx_unlock(&pwm_monitors_mutex);
         return nullptr;
     }
     
-    monitor->line_request = request;
+    // Edge detection is requested on pwm_monitor_start() as part of the shared request
     
     LOG_INFO(LOG_GPIO, "PWM monitor created for [%s] pin %d", 
             feature_name ?: "Unknown", pin);
@@ -573,15 +1596,17 @@ void pwm_monitor_destroy(PWMMonitor *monitor) {
         pwm_monitor_stop(monitor);
     }
     
-    if (monitor->line_request) {
-        gpiod_line_request_release(monitor->line_request);
-    }
-    
     if (monitor->feature_name) {
         free(monitor->feature_name);
     }
+    free(monitor->tach_edges_ns);
     
-    free(monitor);
+    close(monitor->event_fd);
+    
+    // Hand the slot back to the registry
+    mtx_lock(&pwm_monitors_mutex);
+    monitor->in_use = false;
+    mtx_unlock(&pwm_monitors_mutex);
     
     LOG_INFO(LOG_GPIO, "PWM monitor destroyed");
 }
@@ -594,48 +1619,61 @@ int pwm_monitor_start(PWMMonitor *monitor) {
         return 0;
     }
     
+    // Virtual monitors are fed by pwm_monitor_inject_pulse(); no GPIO line to request
+    if (monitor->pin < 0) {
+        atomic_store(&monitor->active, true);
+        LOG_INFO(LOG_GPIO, "Virtual PWM monitor started for [%s]", monitor->feature_name ?: "Unknown");
+        return 0;
+    }
+    
     // Add monitor to active list
+    PWMCallbackBatch callbacks;
+    callbacks.count = 0;
     mtx_lock(&pwm_monitors_mutex);
     
-    int slot = -1;
-    for (int i = 0; i < MAX_PWM_MONITORS; i++) {
-        if (!active_monitors[i]) {
-            slot = i;
-            break;
-        }
-    }
+    monitor->registered = true;
+    active_monitor_count++;
     
-    if (slot < 0) {
-        mtx_unlock(&pwm_monitors_mutex);
-        LOG_ERROR(LOG_GPIO, "Maximum number of PWM monitors (%d) reached", MAX_PWM_MONITORS);
+    // Add the pin to the shared edge request
+    if (pwm_request_rebuild(&callbacks) != 0) {
+        monitor->registered = false;
+        active_monitor_count--;
+        pwm_request_rebuild(&callbacks);  // Restore the request for the remaining monitors
+        pwm_unlock_run_callbacks(&callbacks);
         return -1;
     }
-    
-    active_monitors[slot] = monitor;
-    active_monitor_count++;
     atomic_store(&monitor->active, true);
     
     // Start shared monitoring thread if not running
     if (!atomic_load(&pwm_thread_running)) {
         atomic_store(&pwm_thread_running, true);
-        if (thrd_create(&pwm_monitoring_thread, pwm_monitoring_thread_func, NULL) != thrd_success) {
+        thrd_start_t thread_func = trace_replay_path ? pwm_replay_thread_func : pwm_monitoring_thread_func;
+        if (thrd_create(&pwm_monitoring_thread, thread_func, NULL) != thrd_success) {
             LOG_ERROR(LOG_GPIO, "Failed to create PWM monitoring thread");
-            active_monitors[slot] = NULL;
+            monitor->registered = false;
             active_monitor_count--;
+            pwm_request_rebuild(&callbacks);
             atomic_store(&monitor->active, false);
             atomic_store(&pwm_thread_running, false);
-            mtx_unlock(&pwm_monitors_mutex);
+            pwm_unlock_run_callbacks(&callbacks);
             return -1;
         }
     }
     
-    mtx_unlock(&pwm_monitors_mutex);
+    pwm_unlock_run_callbacks(&callbacks);
     
     LOG_INFO(LOG_GPIO, "PWM monitor started for [%s] pin %d (shared thread, %d active)", 
             monitor->feature_name ?: "Unknown", monitor->pin, active_monitor_count);
     return 0;
 }
 
+// Wait for callbacks collected before the caller took the monitor out of the
+// pulse path (a no-op when called from a callback: the mutex is recursive)
+static void pwm_callbacks_wait(void) {
+    mtx_lock(&pwm_callback_mutex);
+    mtx_unlock(&pwm_callback_mutex);
+}
+
 int pwm_monitor_stop(PWMMonitor *monitor) {
     if (!monitor) return -1;
     
@@ -643,28 +1681,40 @@ int pwm_monitor_stop(PWMMonitor *monitor) {
         return 0;
     }
     
+    if (monitor->pin < 0) {
+        mtx_lock(&pwm_monitors_mutex);
+        atomic_store(&monitor->active, false);
+        mtx_unlock(&pwm_monitors_mutex);
+        pwm_callbacks_wait();
+        return 0;
+    }
+    
     // Remove monitor from active list
+    PWMCallbackBatch callbacks;
+    callbacks.count = 0;
     mtx_lock(&pwm_monitors_mutex);
     
-    for (int i = 0; i < MAX_PWM_MONITORS; i++) {
-        if (active_monitors[i] == monitor) {
-            active_monitors[i] = NULL;
-            active_monitor_count--;
-            break;
-        }
+    if (monitor->registered) {
+        monitor->registered = false;
+        active_monitor_count--;
     }
     
     atomic_store(&monitor->active, false);
     
+    // Drop the pin from the shared edge request
+    pwm_request_rebuild(&callbacks);
+    
     // If no more active monitors, stop the shared thread
-    if (active_monitor_count == 0 && atomic_load(&pwm_thread_running)) {
+    bool join = active_monitor_count == 0 && atomic_load(&pwm_thread_running);
+    if (join) {
         atomic_store(&pwm_thread_running, false);
-        mtx_unlock(&pwm_monitors_mutex);
+        eventfd_write(pwm_wake_fd, 1);
+    }
+    pwm_unlock_run_callbacks(&callbacks);
+    if (join) {
         thrd_join(pwm_monitoring_thread, NULL);
-        mtx_lock(&pwm_monitors_mutex);
     }
-    
-    mtx_unlock(&pwm_monitors_mutex);
+    pwm_callbacks_wait();
     
     LOG_INFO(LOG_GPIO, "PWM monitor stopped for [%s] (%d active)", 
             monitor->feature_name ?: "Unknown", active_monitor_count);
@@ -678,6 +1728,7 @@ bool pwm_monitor_get_reading(PWMMonitor *monitor, PWMReading *reading) {
     if (has_reading) {
         reading->pin = atomic_load(&monitor->current_pin);
         reading->duration_us = atomic_load(&monitor->current_duration_us);
+        reading->timestamp_ns = atomic_load(&monitor->current_ts_ns);
     }
     
     return has_reading;
@@ -686,30 +1737,176 @@ bool pwm_monitor_get_reading(PWMMonitor *monitor, PWMReading *reading) {
 bool pwm_monitor_wait_reading(PWMMonitor *monitor, PWMReading *reading, int timeout_ms) {
     if (!monitor || !reading) return false;
     
-    // With pigpio alerts, we don't have blocking wait anymore
-    // This function now polls with timeout
-    struct timespec start, now;
-    clock_gettime(CLOCK_MONOTONIC, &start);
+    // Block on the change event fd instead of sleeping in a loop
+    if (!atomic_load(&monitor->has_new_reading)) {
+        struct pollfd pfd = { .fd = monitor->event_fd, .events = POLLIN };
+        int ret;
+        do {
+            ret = poll(&pfd, 1, timeout_ms);
+        } while (ret < 0 && errno == EINTR);
+        if (ret <= 0) {
+            return false;  // Timeout or error
+        }
+        pwm_monitor_clear_event(monitor);
+    }
     
-    while (1) {
-        bool has_reading = atomic_exchange(&monitor->has_new_reading, false);
-        if (has_reading) {
-            reading->pin = atomic_load(&monitor->current_pin);
-            reading->duration_us = atomic_load(&monitor->current_duration_us);
-            return true;
+    atomic_store(&monitor->has_new_reading, false);
+    reading->pin = atomic_load(&monitor->current_pin);
+    reading->duration_us = atomic_load(&monitor->current_duration_us);
+    reading->timestamp_ns = atomic_load(&monitor->current_ts_ns);
+    return true;
+}
+
+void pwm_monitor_inject_pulse(PWMMonitor *monitor, int duration_us, int64_t timestamp_ns) {
+    if (!monitor || monitor->pin >= 0 || !atomic_load(&monitor->active)) return;
+    
+    // Same lock the monitoring thread holds while filtering GPIO edges
+    PWMCallbackBatch callbacks;
+    callbacks.count = 0;
+    mtx_lock(&pwm_monitors_mutex);
+    pwm_process_pulse(monitor, duration_us, timestamp_ns, &callbacks);
+    pwm_unlock_run_callbacks(&callbacks);
+}
+
+PWMMonitor* pwm_monitor_create_ppm(int pin, const char *feature_name) {
+    PWMMonitor *monitor = pwm_monitor_create_with_name(pin, feature_name, nullptr, nullptr);
+    if (monitor) {
+        monitor->ppm_mode = true;
+    }
+    return monitor;
+}
+
+PWMMonitor* pwm_monitor_create_tach(int pin, const char *feature_name, int pulses_per_rev, int window_ms) {
+    if (pulses_per_rev < 1 || window_ms < 0 || window_ms > TACH_WINDOW_MAX_MS) {
+        LOG_ERROR(LOG_GPIO, "Invalid tachometer settings (pulses_per_rev %d, window %d ms)", pulses_per_rev, window_ms);
+        return nullptr;
+    }
+    
+    PWMMonitor *monitor = pwm_monitor_create_with_name(pin, feature_name, nullptr, nullptr);
+    if (!monitor) {
+        return nullptr;
+    }
+    monitor->tach_edges_ns = calloc(TACH_RING_SIZE, sizeof(int64_t));
+    if (!monitor->tach_edges_ns) {
+        LOG_ERROR(LOG_GPIO, "Cannot allocate tachometer edge ring");
+        pwm_monitor_destroy(monitor);
+        return nullptr;
+    }
+    monitor->tach_mode = true;
+    monitor->tach_pulses_per_rev = pulses_per_rev;
+    monitor->tach_window_ns = (int64_t)(window_ms > 0 ? window_ms : TACH_WINDOW_DEFAULT_MS) * 1000000LL;
+    return monitor;
+}
+
+bool pwm_monitor_get_tach(PWMMonitor *monitor, TachReading *reading) {
+    if (!monitor || !reading || !monitor->tach_mode) return false;
+    
+    int64_t period_ns;
+    int64_t last_ns;
+    unsigned int seq;
+    do {
+        seq = atomic_load_explicit(&monitor->tach_seq, memory_order_acquire);
+        if (seq & 1) continue;
+        period_ns = atomic_load_explicit(&monitor->tach_period_ns, memory_order_relaxed);
+        last_ns = atomic_load_explicit(&monitor->tach_last_ns, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || seq != atomic_load_explicit(&monitor->tach_seq, memory_order_relaxed));
+    
+    float hz = period_ns > 0 ? 1e9f / (float)period_ns : 0.0f;
+    if (last_ns > 0) {
+        // No edge for longer than a period: the rotor is at most this fast
+        struct timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        int64_t elapsed_ns = (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec - last_ns;
+        if (elapsed_ns > period_ns) {
+            float bound_hz = 1e9f / (float)elapsed_ns;
+            if (bound_hz < hz) hz = bound_hz;
         }
-        
-        if (timeout_ms >= 0) {
-            clock_gettime(CLOCK_MONOTONIC, &now);
-            long elapsed_ms = (now.tv_sec - start.tv_sec) * 1000 + 
-                             (now.tv_nsec - start.tv_nsec) / 1000000;
-            if (elapsed_ms >= timeout_ms) {
-                return false; // Timeout
-            }
+        if (hz < (float)TACH_MIN_HZ) hz = 0.0f;
+    }
+    
+    reading->frequency_hz = hz;
+    reading->rpm = hz * 60.0f / (float)monitor->tach_pulses_per_rev;
+    reading->last_edge_ns = last_ns;
+    reading->edges = atomic_load_explicit(&monitor->tach_edges, memory_order_relaxed);
+    reading->rejected = atomic_load_explicit(&monitor->tach_rejected, memory_order_relaxed);
+    return true;
+}
+
+int pwm_monitor_ppm_attach(PWMMonitor *ppm, int channel, PWMMonitor *output) {
+    if (!ppm || !ppm->ppm_mode || channel < 1 || channel > PPM_MAX_CHANNELS) {
+        LOG_ERROR(LOG_GPIO, "Invalid PPM channel %d (must be 1-%d)", channel, PPM_MAX_CHANNELS);
+        return -1;
+    }
+    
+    mtx_lock(&pwm_monitors_mutex);
+    ppm->ppm_outputs[channel - 1] = output;
+    mtx_unlock(&pwm_monitors_mutex);
+    return 0;
+}
+
+void pwm_monitor_ppm_detach(PWMMonitor *ppm, PWMMonitor *output) {
+    if (!ppm || !output) return;
+    
+    mtx_lock(&pwm_monitors_mutex);
+    for (int i = 0; i < PPM_MAX_CHANNELS; i++) {
+        if (ppm->ppm_outputs[i] == output) {
+            ppm->ppm_outputs[i] = nullptr;
+        }
+    }
+    mtx_unlock(&pwm_monitors_mutex);
+}
+
+void pwm_monitor_set_decoder(PWMMonitor *monitor, ChannelDecoder *decoder) {
+    if (!monitor) return;
+    
+    mtx_lock(&pwm_monitors_mutex);
+    monitor->decoder = decoder;
+    mtx_unlock(&pwm_monitors_mutex);
+}
+
+int pwm_monitor_decoder_attach(PWMMonitor *monitor, int output, PWMMonitor *target) {
+    if (!monitor || !monitor->decoder || output < 0 || output >= monitor->decoder->outputs) {
+        LOG_ERROR(LOG_GPIO, "Invalid decoder output %d", output);
+        return -1;
+    }
+    
+    mtx_lock(&pwm_monitors_mutex);
+    monitor->decoder_outputs[output] = target;
+    mtx_unlock(&pwm_monitors_mutex);
+    return 0;
+}
+
+void pwm_monitor_decoder_detach(PWMMonitor *monitor, PWMMonitor *target) {
+    if (!monitor || !target) return;
+    
+    mtx_lock(&pwm_monitors_mutex);
+    for (int i = 0; i < CHANNEL_DECODER_MAX_OUTPUTS; i++) {
+        if (monitor->decoder_outputs[i] == target) {
+            monitor->decoder_outputs[i] = nullptr;
         }
-        
-        usleep(1000); // Sleep 1ms between checks
     }
+    mtx_unlock(&pwm_monitors_mutex);
+}
+
+int pwm_monitor_ppm_channel_count(PWMMonitor *ppm) {
+    return ppm ? atomic_load_explicit(&ppm->ppm_channel_count, memory_order_relaxed) : 0;
+}
+
+int pwm_monitor_get_event_fd(PWMMonitor *monitor) {
+    return monitor ? monitor->event_fd : -1;
+}
+
+void pwm_monitor_clear_event(PWMMonitor *monitor) {
+    if (!monitor) return;
+    eventfd_t value;
+    eventfd_read(monitor->event_fd, &value);  // Non-blocking; EAGAIN when already clear
+}
+
+void pwm_monitor_set_change_threshold(PWMMonitor *monitor, int threshold_us) {
+    if (!monitor) return;
+    if (threshold_us < 0) threshold_us = 0;
+    atomic_store(&monitor->change_threshold_us, threshold_us);
 }
 
 bool pwm_monitor_is_running(PWMMonitor *monitor) {
@@ -717,40 +1914,123 @@ bool pwm_monitor_is_running(PWMMonitor *monitor) {
     return atomic_load(&monitor->active);
 }
 
-void pwm_monitor_set_avg_window_ms(PWMMonitor *monitor, int window_ms) {
+void pwm_monitor_set_avg_window_pulses(PWMMonitor *monitor, int pulses) {
     if (!monitor) return;
-    if (window_ms < 10) window_ms = 10;
-    if (window_ms > 5000) window_ms = 5000;
-    atomic_store(&monitor->avg_window_ms, window_ms);
+    if (pulses < 1) pulses = 1;
+    if (pulses > PWM_AVG_MAX_SAMPLES) pulses = PWM_AVG_MAX_SAMPLES;
+    atomic_store(&monitor->avg_window_pulses, pulses);
 }
 
-bool pwm_monitor_get_average(PWMMonitor *monitor, int *avg_us) {
-    if (!monitor || !avg_us) return false;
-    struct timespec now;
-    clock_gettime(CLOCK_MONOTONIC, &now);
+void pwm_monitor_set_filter(PWMMonitor *monitor, const PWMFilter *filter) {
+    if (!monitor) return;
     
-    long long window_ns = (long long)atomic_load(&monitor->avg_window_ms) * 1000000LL;
-    long long sum = 0;
-    int count = 0;
+    PWMFilter f = filter ? *filter : PWM_FILTER_DEFAULTS;
+    if (f.glitch_us < 0) f.glitch_us = 0;
+    if (f.median_samples < 0) f.median_samples = 0;
+    if (f.median_samples > PWM_FILTER_MAX_MEDIAN) f.median_samples = PWM_FILTER_MAX_MEDIAN;
+    if (f.ema_alpha < 0.0f || f.ema_alpha >= 1.0f) f.ema_alpha = 0.0f;
+    if (f.rate_limit_us_per_s < 0) f.rate_limit_us_per_s = 0;
+    if (f.avg_window_pulses <= 0) f.avg_window_pulses = PWM_AVG_WINDOW_DEFAULT_PULSES;
     
-    for (int i = 0; i < PWM_AVG_MAX_SAMPLES; i++) {
-        struct timespec ts = monitor->samples[i].ts;
-        if (ts.tv_sec == 0 && ts.tv_nsec == 0) continue;
-        long long age_ns = ((long long)(now.tv_sec - ts.tv_sec) * 1000000000LL) + (now.tv_nsec - ts.tv_nsec);
-        if (age_ns >= 0 && age_ns <= window_ns) {
-            sum += atomic_load(&monitor->samples[i].duration_us);
-            count++;
-        }
-    }
+    // The monitoring thread filters under this mutex
+    mtx_lock(&pwm_monitors_mutex);
+    monitor->filter = f;
+    pwm_filter_reset(monitor);
+    mtx_unlock(&pwm_monitors_mutex);
+    
+    pwm_monitor_set_avg_window_pulses(monitor, f.avg_window_pulses);
+    
+    LOG_INFO(LOG_GPIO, "Input filter for [%s]: glitch=%d us, median=%d, ema=%.2f, rate_limit=%d us/s, window=%d pulses",
+             monitor->feature_name ?: "Unknown", f.glitch_us, f.median_samples,
+             f.ema_alpha, f.rate_limit_us_per_s, f.avg_window_pulses);
+}
+
+bool pwm_monitor_get_average(PWMMonitor *monitor, int *avg_us) {
+    int64_t newest_ns;
+    return pwm_monitor_get_average_ts(monitor, avg_us, &newest_ns);
+}
+
+bool pwm_monitor_get_average_ts(PWMMonitor *monitor, int *avg_us, int64_t *newest_ns) {
+    if (!monitor || !avg_us || !newest_ns) return false;
+    
+    // Seqlock read: retry if the monitoring thread published mid-read
+    int64_t sum;
+    int count;
+    int64_t newest;
+    unsigned int seq;
+    do {
+        seq = atomic_load_explicit(&monitor->avg_seq, memory_order_acquire);
+        if (seq & 1) continue;
+        sum = atomic_load_explicit(&monitor->avg_sum_us, memory_order_relaxed);
+        count = atomic_load_explicit(&monitor->avg_count, memory_order_relaxed);
+        newest = atomic_load_explicit(&monitor->avg_newest_ns, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || seq != atomic_load_explicit(&monitor->avg_seq, memory_order_relaxed));
     
     if (count == 0) {
         return false;
     }
     
+    // The window only advances when pulses arrive, so treat it as expired once
+    // the newest pulse is older than the window span (signal lost). The coarse
+    // clock is a vDSO read; the span includes slack for its few-ms resolution.
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    int64_t age_ns = (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec - newest;
+    if (age_ns > pwm_window_span_ns(monitor)) {
+        return false;
+    }
+    
     *avg_us = (int)(sum / count);
+    *newest_ns = newest;
     return true;
 }
 
+void pwm_monitor_set_failsafe_timeout(PWMMonitor *monitor, int timeout_ms) {
+    if (!monitor) return;
+    if (timeout_ms < 50) timeout_ms = 50;
+    atomic_store(&monitor->failsafe_timeout_ms, timeout_ms);
+}
+
+bool pwm_monitor_get_health(PWMMonitor *monitor, PWMHealth *health) {
+    if (!monitor || !health) return false;
+    
+    int64_t last_ns = atomic_load_explicit(&monitor->last_valid_ns, memory_order_relaxed);
+    health->valid_pulses = atomic_load_explicit(&monitor->valid_pulses, memory_order_relaxed);
+    health->rejected_pulses = atomic_load_explicit(&monitor->rejected_pulses, memory_order_relaxed);
+    health->frame_rate_hz = (float)atomic_load_explicit(&monitor->frame_rate_mhz, memory_order_relaxed) / 1000.0f;
+    health->jitter_us = atomic_load_explicit(&monitor->jitter_us, memory_order_relaxed);
+    health->frame_period_us = (int)(atomic_load_explicit(&monitor->frame_period_ns, memory_order_relaxed) / 1000);
+    
+    if (last_ns == 0) {
+        health->ms_since_last_pulse = -1;
+        health->state = PWM_SIGNAL_NONE;
+        return true;
+    }
+    
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC_COARSE, &now);
+    int64_t age_ns = (int64_t)now.tv_sec * 1000000000LL + now.tv_nsec - last_ns;
+    health->ms_since_last_pulse = age_ns > 0 ? (int)(age_ns / 1000000) : 0;
+    health->state = health->ms_since_last_pulse > atomic_load(&monitor->failsafe_timeout_ms)
+                    ? PWM_SIGNAL_FAILSAFE : PWM_SIGNAL_OK;
+    return true;
+}
+
+bool pwm_monitor_in_failsafe(PWMMonitor *monitor) {
+    PWMHealth health;
+    return pwm_monitor_get_health(monitor, &health) && health.state == PWM_SIGNAL_FAILSAFE;
+}
+
+const char* pwm_signal_state_to_string(PWMSignalState state) {
+    switch (state) {
+        case PWM_SIGNAL_NONE:     return "NO SIGNAL";
+        case PWM_SIGNAL_OK:       return "OK";
+        case PWM_SIGNAL_FAILSAFE: return "FAILSAFE";
+        default:                  return "UNKNOWN";
+    }
+}
+
 bool gpio_is_initialized(void) {
     return initialized;
 }
@@ -1,6 +1,9 @@
 #include "gun_fx.h"
 #include "config_loader.h"
 #include "gpio.h"
+#include "input.h"
+#include "rt_sched.h"
+#include "calibration.h"
 #include "audio_player.h"
 #include "serial_bus.h"
 #include "logging.h"
@@ -10,6 +13,7 @@
 #include <threads.h>
 #include <unistd.h>
 #include <string.h>
+#include <poll.h>
 
 // ---------------------- Binary Protocol (PC -> Pico) ----------------------
 // Packet: [type:u8][len:u8][payload:len][crc8(0x07 over type+len+payload)] then COBS-encoded and terminated with 0x00
@@ -41,6 +45,9 @@ static const uint8_t PKT_KEEPALIVE    = 0xF2;
 static const uint8_t PKT_INIT_READY   = 0xF3;
 static const uint8_t PKT_STATUS       = 0xF4;
 
+#define STATUS_PAYLOAD_LEN   11
+#define STATUS_SERVOS        3
+#define MODULE_NAME_MAX      32
 
 struct GunFX {
     // Audio
@@ -50,6 +57,17 @@ struct GunFX {
     // Serial bus to Pico
     SerialBus *serial_bus;
     SerialBusConfig serial_bus_config;
+
+    // Pico telemetry, written by the serial bus reader thread. STATUS fields
+    // form a seqlock snapshot (odd telemetry_seq = update in progress).
+    atomic_uint telemetry_seq;
+    atomic_int telemetry_flags;
+    atomic_int telemetry_fan_off_ms;
+    atomic_int telemetry_servo_us[STATUS_SERVOS];
+    atomic_int telemetry_rpm;
+    _Atomic int64_t telemetry_ns;       // Receive time of the last STATUS (0 = none yet)
+    char module_name[MODULE_NAME_MAX];  // From the first INIT_READY
+    atomic_bool module_ready;
     
     // PWM monitoring for trigger and heater toggle
     PWMMonitor *trigger_pwm_monitor;
@@ -65,6 +83,8 @@ struct GunFX {
     int yaw_pwm_pin;
     ServoConfig pitch_cfg;
     ServoConfig yaw_cfg;
+    InputMap pitch_map;                 // Input -> output tables (calibration applied)
+    InputMap yaw_map;
     int pitch_servo_id;
     int yaw_servo_id;
     int last_pitch_output_us;
@@ -80,6 +100,11 @@ struct GunFX {
     atomic_int current_rate_index;  // Currently active rate (-1 = not firing)
     atomic_bool smoke_heater_on;
     
+    // Input failsafe
+    FailsafeAction failsafe_action;
+    unsigned int failsafe_inputs;    // Bitmask of inputs currently in failsafe (processing thread)
+    atomic_bool in_failsafe;
+    
     // Protocol timing
     struct timespec last_keepalive_time;
     
@@ -108,6 +133,56 @@ static void send_keepalive(GunFX *gun) {
     clock_gettime(CLOCK_MONOTONIC, &gun->last_keepalive_time);
 }
 
+// ---------------------- Telemetry (Pico -> PC) ----------------------
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static int read_u16le(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+// STATUS handler (serial bus reader thread). Fields are read straight from
+// the received packet and published without blocking the status display.
+static void on_pico_status(uint8_t type, const uint8_t *payload, size_t len, void *user_data) {
+    GunFX *gun = (GunFX *)user_data;
+    (void)type;
+    if (len != STATUS_PAYLOAD_LEN) {
+        LOG_DEBUG(LOG_GUN, "Ignoring STATUS with %zu byte payload", len);
+        return;
+    }
+
+    unsigned int seq = atomic_load_explicit(&gun->telemetry_seq, memory_order_relaxed);
+    atomic_store_explicit(&gun->telemetry_seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&gun->telemetry_flags, payload[0], memory_order_relaxed);
+    atomic_store_explicit(&gun->telemetry_fan_off_ms, read_u16le(&payload[1]), memory_order_relaxed);
+    for (int i = 0; i < STATUS_SERVOS; i++) {
+        atomic_store_explicit(&gun->telemetry_servo_us[i], read_u16le(&payload[3 + 2 * i]), memory_order_relaxed);
+    }
+    atomic_store_explicit(&gun->telemetry_rpm, read_u16le(&payload[9]), memory_order_relaxed);
+    atomic_store_explicit(&gun->telemetry_ns, monotonic_ns(), memory_order_relaxed);
+    atomic_store_explicit(&gun->telemetry_seq, seq + 2, memory_order_release);
+}
+
+// INIT_READY handler: the name is kept from the first reply; later ones
+// (the Pico answers every INIT) are only logged
+static void on_pico_init_ready(uint8_t type, const uint8_t *payload, size_t len, void *user_data) {
+    GunFX *gun = (GunFX *)user_data;
+    (void)type;
+    int name_len = len < MODULE_NAME_MAX ? (int)len : MODULE_NAME_MAX - 1;
+
+    if (!atomic_load_explicit(&gun->module_ready, memory_order_relaxed)) {
+        memcpy(gun->module_name, payload, (size_t)name_len);
+        gun->module_name[name_len] = '\0';
+        atomic_store_explicit(&gun->module_ready, true, memory_order_release);
+    }
+    LOG_INFO(LOG_GUN, "Pico ready: %.*s", name_len, (const char *)payload);
+}
+
 // Select rate of fire from PWM reading with hysteresis
 // Returns -1 if not firing, or index of active rate (0 to rate_count-1)
 // Finds the highest matching rate (rates don't need to be ordered)
@@ -154,21 +229,6 @@ static int select_rate_of_fire(GunFX *gun, int pwm_duration_us, int previous_rat
     return best_match;  // Returns -1 if no match found (not firing)
 }
 
-static int map_input_to_output_us(const ServoConfig *cfg, int input_us) {
-    if (input_us < cfg->input_min_us) input_us = cfg->input_min_us;
-    if (input_us > cfg->input_max_us) input_us = cfg->input_max_us;
-
-    float input_range = (float)(cfg->input_max_us - cfg->input_min_us);
-    float output_range = (float)(cfg->output_max_us - cfg->output_min_us);
-    if (input_range <= 0.0f) return cfg->output_min_us;
-
-    float normalized = (float)(input_us - cfg->input_min_us) / input_range;
-    int output_us = cfg->output_min_us + (int)(normalized * output_range);
-    if (output_us < cfg->output_min_us) output_us = cfg->output_min_us;
-    if (output_us > cfg->output_max_us) output_us = cfg->output_max_us;
-    return output_us;
-}
-
 static void send_servo_command(GunFX *gun, int servo_id, int output_us, int *last_sent) {
     if (last_sent && *last_sent == output_us) return;
     if (!gun->serial_bus) {
@@ -224,12 +284,52 @@ static void send_servo_recoil_jerk(GunFX *gun, int servo_id, const ServoConfig *
              servo_id, cfg->recoil_jerk_us, cfg->recoil_jerk_variance_us);
 }
 
+// Re-evaluate which inputs are in failsafe, logging transitions
+static void update_failsafe(GunFX *gun) {
+    static const char *names[] = { "Trigger", "Smoke heater toggle", "Pitch", "Yaw" };
+    PWMMonitor *monitors[] = {
+        gun->trigger_pwm_monitor, gun->smoke_heater_toggle_monitor,
+        gun->pitch_pwm_monitor, gun->yaw_pwm_monitor,
+    };
+    
+    unsigned int inputs = 0;
+    for (int i = 0; i < 4; i++) {
+        if (pwm_monitor_in_failsafe(monitors[i])) {
+            inputs |= 1u << i;
+        }
+        
+        unsigned int bit = 1u << i;
+        if ((inputs & bit) && !(gun->failsafe_inputs & bit)) {
+            LOG_WARN(LOG_GUN, "%s input signal lost - failsafe", names[i]);
+        } else if (!(inputs & bit) && (gun->failsafe_inputs & bit)) {
+            LOG_INFO(LOG_GUN, "%s input signal recovered", names[i]);
+        }
+    }
+    
+    gun->failsafe_inputs = inputs;
+    atomic_store(&gun->in_failsafe, inputs != 0);
+}
+
 // Update servo positions from averaged PWM inputs
 static void update_servos(GunFX *gun) {
+    // Neutral failsafe centres a servo whose input is lost; hold and stop leave it in place
+    if (gun->failsafe_action == FAILSAFE_NEUTRAL) {
+        if ((gun->failsafe_inputs & (1u << 2)) && gun->pitch_cfg.servo_id > 0) {
+            int centre_us = gun->pitch_map.center_in_us;
+            send_servo_command(gun, gun->pitch_servo_id, input_map_lookup(&gun->pitch_map, centre_us),
+                               &gun->last_pitch_output_us);
+        }
+        if ((gun->failsafe_inputs & (1u << 3)) && gun->yaw_cfg.servo_id > 0) {
+            int centre_us = gun->yaw_map.center_in_us;
+            send_servo_command(gun, gun->yaw_servo_id, input_map_lookup(&gun->yaw_map, centre_us),
+                               &gun->last_yaw_output_us);
+        }
+    }
+    
     if (gun->pitch_pwm_monitor && gun->pitch_cfg.servo_id > 0) {
         int pitch_avg_us;
         if (pwm_monitor_get_average(gun->pitch_pwm_monitor, &pitch_avg_us)) {
-            int output_us = map_input_to_output_us(&gun->pitch_cfg, pitch_avg_us);
+            int output_us = input_map_lookup(&gun->pitch_map, pitch_avg_us);
             send_servo_command(gun, gun->pitch_servo_id, output_us, &gun->last_pitch_output_us);
         } else {
             static int pitch_warn_count = 0;
@@ -243,7 +343,7 @@ static void update_servos(GunFX *gun) {
     if (gun->yaw_pwm_monitor && gun->yaw_cfg.servo_id > 0) {
         int yaw_avg_us;
         if (pwm_monitor_get_average(gun->yaw_pwm_monitor, &yaw_avg_us)) {
-            int output_us = map_input_to_output_us(&gun->yaw_cfg, yaw_avg_us);
+            int output_us = input_map_lookup(&gun->yaw_map, yaw_avg_us);
             send_servo_command(gun, gun->yaw_servo_id, output_us, &gun->last_yaw_output_us);
         } else {
             static int yaw_warn_count = 0;
@@ -293,15 +393,18 @@ static int handle_trigger_input(GunFX *gun, int previous_rate_index, struct time
 
 // Handle smoke heater toggle
 static void handle_smoke_heater(GunFX *gun) {
-    int heater_avg_us;
-    if (!gun->smoke_heater_toggle_monitor || !pwm_monitor_get_average(gun->smoke_heater_toggle_monitor, &heater_avg_us)) {
+    int heater_avg_us = -1;
+    bool heater_toggle_on;
+    if ((gun->failsafe_inputs & (1u << 1)) && gun->failsafe_action != FAILSAFE_HOLD) {
+        heater_toggle_on = false;  // Lost toggle input: heater off
+    } else if (!gun->smoke_heater_toggle_monitor || !pwm_monitor_get_average(gun->smoke_heater_toggle_monitor, &heater_avg_us)) {
         return;
+    } else {
+        heater_toggle_on = (heater_avg_us >= gun->smoke_heater_threshold);
+        LOG_DEBUG(LOG_GUN, "Heater toggle PWM avg: %d µs (threshold: %d µs) -> %s",
+                 heater_avg_us, gun->smoke_heater_threshold, heater_toggle_on ? "ON" : "OFF");
     }
     
-    bool heater_toggle_on = (heater_avg_us >= gun->smoke_heater_threshold);
-    LOG_DEBUG(LOG_GUN, "Heater toggle PWM avg: %d µs (threshold: %d µs) -> %s",
-             heater_avg_us, gun->smoke_heater_threshold, heater_toggle_on ? "ON" : "OFF");
-    
     bool current_heater_on = atomic_load(&gun->smoke_heater_on);
     if (heater_toggle_on && !current_heater_on) {
         atomic_store(&gun->smoke_heater_on, true);
@@ -312,7 +415,7 @@ static void handle_smoke_heater(GunFX *gun) {
         }
     } else if (!heater_toggle_on && current_heater_on) {
         atomic_store(&gun->smoke_heater_on, false);
-        LOG_INFO(LOG_GUN, "Smoke heater OFF (PWM avg: %d µs)");
+        LOG_INFO(LOG_GUN, "Smoke heater OFF (PWM avg: %d µs)", heater_avg_us);
         if (gun->serial_bus) {
             uint8_t payload = 0;
             serial_bus_send_packet(gun->serial_bus, PKT_SMOKE_HEAT, &payload, 1);
@@ -341,7 +444,7 @@ static void handle_rate_change(GunFX *gun, int new_rate_index, int previous_rate
         }
         
         if (gun->mixer && gun->rates[new_rate_index].sound) {
-            PlaybackOptions opts = {.loop = true, .volume = 1.0f};
+            PlaybackOptions opts = {.loop = true, .volume = 1.0f, .fade_in_ms = PLAYBACK_FADE_IN_ENVELOPE};
             audio_mixer_play(gun->mixer, gun->audio_channel, gun->rates[new_rate_index].sound, &opts);
         }
         
@@ -360,7 +463,8 @@ static void handle_rate_change(GunFX *gun, int new_rate_index, int previous_rate
         }
         
         if (gun->mixer) {
-            audio_mixer_stop_channel(gun->mixer, gun->audio_channel, STOP_IMMEDIATE);
+            // Fade runs on the audio thread; the release tail (if any) follows it
+            audio_mixer_stop_channel(gun->mixer, gun->audio_channel, STOP_FADE_OUT);
         }
         
         LOG_STATE(LOG_GUN, "FIRING", "IDLE");
@@ -371,29 +475,43 @@ static void handle_rate_change(GunFX *gun, int new_rate_index, int previous_rate
 
 
 
+// Apply a configured input filter chain and failsafe timeout to a PWM monitor
+static void apply_input_filter(PWMMonitor *monitor, const InputFilterConfig *fc, const FailsafeConfig *failsafe) {
+    pwm_monitor_set_failsafe_timeout(monitor, failsafe->timeout_ms);
+    pwm_monitor_set_filter(monitor, &(PWMFilter){
+        .glitch_us = fc->glitch_us,
+        .median_samples = fc->median_samples,
+        .ema_alpha = fc->ema_alpha,
+        .rate_limit_us_per_s = fc->rate_limit_us_per_s,
+        .avg_window_pulses = fc->avg_window_pulses,
+    });
+}
+
 // Setup servo PWM monitoring and send initial servo settings to Pico
 static int setup_servos(GunFX *gun, const GunFXConfig *config) {
     // Create pitch PWM monitor if valid channel specified
-    if (gun->pitch_pwm_pin >= 0) {
-        gun->pitch_pwm_monitor = pwm_monitor_create_with_name(gun->pitch_pwm_pin, "Turret Pitch Servo", nullptr, nullptr);
+    if (config->turret_control.pitch.input_channel > 0) {
+        gun->pitch_pwm_monitor = input_monitor_create(config->turret_control.pitch.input_channel, "Turret Pitch Servo");
         if (!gun->pitch_pwm_monitor) {
             LOG_ERROR(LOG_GUN, "Failed to create pitch PWM monitor on channel %d (GPIO %d)", 
                      config->turret_control.pitch.input_channel, gun->pitch_pwm_pin);
             return -1;
         }
+        apply_input_filter(gun->pitch_pwm_monitor, &config->turret_control.pitch.filter, &config->failsafe);
         pwm_monitor_start(gun->pitch_pwm_monitor);
         LOG_DEBUG(LOG_GUN, "Pitch servo input monitoring started on channel %d (GPIO %d, servo_id=%d)",
                  config->turret_control.pitch.input_channel, gun->pitch_pwm_pin, gun->pitch_cfg.servo_id);
     }
     
     // Create yaw PWM monitor if valid channel specified
-    if (gun->yaw_pwm_pin >= 0) {
-        gun->yaw_pwm_monitor = pwm_monitor_create_with_name(gun->yaw_pwm_pin, "Turret Yaw Servo", nullptr, nullptr);
+    if (config->turret_control.yaw.input_channel > 0) {
+        gun->yaw_pwm_monitor = input_monitor_create(config->turret_control.yaw.input_channel, "Turret Yaw Servo");
         if (!gun->yaw_pwm_monitor) {
             LOG_ERROR(LOG_GUN, "Failed to create yaw PWM monitor on channel %d (GPIO %d)", 
                      config->turret_control.yaw.input_channel, gun->yaw_pwm_pin);
             return -1;
         }
+        apply_input_filter(gun->yaw_pwm_monitor, &config->turret_control.yaw.filter, &config->failsafe);
         pwm_monitor_start(gun->yaw_pwm_monitor);
         LOG_DEBUG(LOG_GUN, "Yaw servo input monitoring started on channel %d (GPIO %d, servo_id=%d)",
                  config->turret_control.yaw.input_channel, gun->yaw_pwm_pin, gun->yaw_cfg.servo_id);
@@ -410,10 +528,35 @@ static int setup_servos(GunFX *gun, const GunFXConfig *config) {
     return 0;
 }
 
+// Idle wake-up bound while no input changes: keeps keepalives flowing and
+// notices lost signals once their averages expire
+#define GUN_IDLE_POLL_MS 100
+
+// Block until any PWM input average changes (or the idle timeout passes)
+static void gun_wait_for_input(GunFX *gun) {
+    PWMMonitor *monitors[] = {
+        gun->trigger_pwm_monitor, gun->smoke_heater_toggle_monitor,
+        gun->pitch_pwm_monitor, gun->yaw_pwm_monitor,
+    };
+    struct pollfd fds[4];
+    for (int i = 0; i < 4; i++) {
+        fds[i] = (struct pollfd){ .fd = pwm_monitor_get_event_fd(monitors[i]), .events = POLLIN };
+    }
+    
+    if (poll(fds, 4, GUN_IDLE_POLL_MS) > 0) {
+        for (int i = 0; i < 4; i++) {
+            if (fds[i].revents & POLLIN) {
+                pwm_monitor_clear_event(monitors[i]);
+            }
+        }
+    }
+}
+
 // Processing thread to monitor PWM and handle firing
 static int gun_fx_processing_thread(void *arg) {
     GunFX *gun = (GunFX *)arg;
     
+    rt_sched_apply(RT_ROLE_GUN, "sfx-gun");
     LOG_INFO(LOG_GUN, "Processing thread started");
     
     struct timespec last_pwm_debug_time;
@@ -432,6 +575,9 @@ static int gun_fx_processing_thread(void *arg) {
             send_keepalive(gun);
         }
         
+        // Track inputs that lost their signal
+        update_failsafe(gun);
+        
         // Update servos
         update_servos(gun);
         
@@ -439,6 +585,9 @@ static int gun_fx_processing_thread(void *arg) {
         int previous_rate_index = atomic_load(&gun->current_rate_index);
         
         int new_rate_index = handle_trigger_input(gun, previous_rate_index, &last_pwm_debug_time);
+        if ((gun->failsafe_inputs & (1u << 0)) && gun->failsafe_action != FAILSAFE_HOLD) {
+            new_rate_index = -1;  // Lost trigger input: cease fire
+        }
         
         // Handle smoke heater
         handle_smoke_heater(gun);
@@ -446,13 +595,22 @@ static int gun_fx_processing_thread(void *arg) {
         // Handle rate changes and firing logic
         handle_rate_change(gun, new_rate_index, previous_rate_index);
         
-        usleep(10000); // 10ms loop
+        gun_wait_for_input(gun);
     }
     
     LOG_INFO(LOG_GUN, "Processing thread stopped");
     return thrd_success;
 }
 
+// The bus may be shared with the Pico capture input: drop our handlers before
+// releasing it so none runs on a freed GunFX
+static void close_link(GunFX *gun) {
+    if (!gun->serial_bus) return;
+    serial_bus_set_handler(gun->serial_bus, PKT_STATUS, nullptr, nullptr);
+    serial_bus_set_handler(gun->serial_bus, PKT_INIT_READY, nullptr, nullptr);
+    serial_bus_close(gun->serial_bus);
+}
+
 GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
                      const GunFXConfig *config) {
     if (!config) {
@@ -469,19 +627,22 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     gun->mixer = mixer;
     gun->audio_channel = audio_channel;
     
-    // Convert input channels to GPIO pins
-    int trigger_gpio = channel_to_gpio(config->trigger.input_channel);
-    int smoke_heater_gpio = channel_to_gpio(config->smoke.heater_toggle_channel);
+    // Resolve input channels (GPIO pins are -1 for serial receiver inputs)
+    int trigger_gpio = input_channel_pin(config->trigger.input_channel);
+    int smoke_heater_gpio = input_channel_pin(config->smoke.heater_toggle_channel);
     
     gun->trigger_pwm_pin = trigger_gpio;
     gun->smoke_heater_toggle_pin = smoke_heater_gpio;
     gun->smoke_heater_threshold = config->smoke.heater_pwm_threshold_us;
     gun->pitch_cfg = config->turret_control.pitch;
     gun->yaw_cfg = config->turret_control.yaw;
+    input_map_build(&gun->pitch_map, gun->pitch_cfg.input_channel, gun->pitch_cfg.input_min_us,
+                    gun->pitch_cfg.input_max_us, gun->pitch_cfg.output_min_us, gun->pitch_cfg.output_max_us);
+    input_map_build(&gun->yaw_map, gun->yaw_cfg.input_channel, gun->yaw_cfg.input_min_us,
+                    gun->yaw_cfg.input_max_us, gun->yaw_cfg.output_min_us, gun->yaw_cfg.output_max_us);
     
-    // Convert servo input channels to GPIO pins
-    int pitch_gpio = channel_to_gpio(config->turret_control.pitch.input_channel);
-    int yaw_gpio = channel_to_gpio(config->turret_control.yaw.input_channel);
+    int pitch_gpio = input_channel_pin(config->turret_control.pitch.input_channel);
+    int yaw_gpio = input_channel_pin(config->turret_control.yaw.input_channel);
     gun->pitch_pwm_pin = pitch_gpio;
     gun->yaw_pwm_pin = yaw_gpio;
     gun->pitch_servo_id = config->turret_control.pitch.servo_id;
@@ -497,6 +658,9 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     atomic_init(&gun->processing_running, false);
     gun->pitch_pwm_monitor = nullptr;
     gun->yaw_pwm_monitor = nullptr;
+    gun->failsafe_action = config_failsafe_action(&config->failsafe, FAILSAFE_STOP);
+    gun->failsafe_inputs = 0;
+    atomic_init(&gun->in_failsafe, false);
     
     // Open serial bus to gunfx_pico by USB VID/PID
     // Use default configuration: baud_rate=115200, timeout_ms=100
@@ -521,6 +685,21 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     gun->serial_bus_config = pico_config;
     
     LOG_DEBUG(LOG_GUN, "gunfx_pico opened on %s", gun->serial_bus_config.device_path);
+
+    // Telemetry handlers go in before INIT so the INIT_READY reply is seen
+    atomic_init(&gun->telemetry_seq, 0);
+    atomic_init(&gun->telemetry_flags, 0);
+    atomic_init(&gun->telemetry_fan_off_ms, 0);
+    for (int i = 0; i < STATUS_SERVOS; i++) {
+        atomic_init(&gun->telemetry_servo_us[i], 0);
+    }
+    atomic_init(&gun->telemetry_rpm, 0);
+    atomic_init(&gun->telemetry_ns, 0);
+    atomic_init(&gun->module_ready, false);
+    if (serial_bus_set_handler(gun->serial_bus, PKT_STATUS, on_pico_status, gun) != 0 ||
+        serial_bus_set_handler(gun->serial_bus, PKT_INIT_READY, on_pico_init_ready, gun) != 0) {
+        LOG_WARN(LOG_GUN, "Pico telemetry unavailable on %s", gun->serial_bus_config.device_path);
+    }
     
     // Initialize keepalive timer and send INIT
     clock_gettime(CLOCK_MONOTONIC, &gun->last_keepalive_time);
@@ -530,12 +709,13 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     usleep(100000); // 100ms
 
     // Create trigger PWM monitor if valid channel specified
-    if (trigger_gpio >= 0) {
-        gun->trigger_pwm_monitor = pwm_monitor_create_with_name(trigger_gpio, "Gun Trigger", nullptr, nullptr);
+    if (config->trigger.input_channel > 0) {
+        gun->trigger_pwm_monitor = input_monitor_create(config->trigger.input_channel, "Gun Trigger");
         if (!gun->trigger_pwm_monitor) {
             LOG_ERROR(LOG_GUN, "Failed to create trigger PWM monitor on channel %d (GPIO %d)", 
                      config->trigger.input_channel, trigger_gpio);
         } else {
+            apply_input_filter(gun->trigger_pwm_monitor, &config->trigger.filter, &config->failsafe);
             pwm_monitor_start(gun->trigger_pwm_monitor);
             LOG_DEBUG(LOG_GUN, "Trigger PWM monitoring started on channel %d (GPIO %d)", 
                      config->trigger.input_channel, trigger_gpio);
@@ -543,12 +723,13 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     }
     
     // Create smoke heater toggle PWM monitor if valid channel specified
-    if (smoke_heater_gpio >= 0) {
-        gun->smoke_heater_toggle_monitor = pwm_monitor_create_with_name(smoke_heater_gpio, "Smoke Heater Toggle", nullptr, nullptr);
+    if (config->smoke.heater_toggle_channel > 0) {
+        gun->smoke_heater_toggle_monitor = input_monitor_create(config->smoke.heater_toggle_channel, "Smoke Heater Toggle");
         if (!gun->smoke_heater_toggle_monitor) {
             LOG_WARN(LOG_GUN, "Failed to create smoke heater toggle monitor on channel %d (GPIO %d)",
                     config->smoke.heater_toggle_channel, smoke_heater_gpio);
         } else {
+            apply_input_filter(gun->smoke_heater_toggle_monitor, &config->smoke.filter, &config->failsafe);
             pwm_monitor_start(gun->smoke_heater_toggle_monitor);
             LOG_DEBUG(LOG_GUN, "Smoke heater toggle monitoring started on channel %d (GPIO %d, threshold: %d µs)",
                      config->smoke.heater_toggle_channel, smoke_heater_gpio, config->smoke.heater_pwm_threshold_us);
@@ -559,15 +740,9 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
     if (setup_servos(gun, config) != 0) {
         LOG_ERROR(LOG_GUN, "Failed to setup servos");
         
-        if (gun->trigger_pwm_monitor) {
-            pwm_monitor_stop(gun->trigger_pwm_monitor);
-            pwm_monitor_destroy(gun->trigger_pwm_monitor);
-        }
-        if (gun->smoke_heater_toggle_monitor) {
-            pwm_monitor_stop(gun->smoke_heater_toggle_monitor);
-            pwm_monitor_destroy(gun->smoke_heater_toggle_monitor);
-        }
-        if (gun->serial_bus) serial_bus_close(gun->serial_bus);
+        input_monitor_destroy(gun->trigger_pwm_monitor);
+        input_monitor_destroy(gun->smoke_heater_toggle_monitor);
+        close_link(gun);
         free(gun);
         return nullptr;
     }
@@ -578,15 +753,9 @@ GunFX* gun_fx_create(AudioMixer *mixer, int audio_channel,
         LOG_ERROR(LOG_GUN, "Failed to create processing thread");
         atomic_store(&gun->processing_running, false);
         
-        if (gun->trigger_pwm_monitor) {
-            pwm_monitor_stop(gun->trigger_pwm_monitor);
-            pwm_monitor_destroy(gun->trigger_pwm_monitor);
-        }
-        if (gun->smoke_heater_toggle_monitor) {
-            pwm_monitor_stop(gun->smoke_heater_toggle_monitor);
-            pwm_monitor_destroy(gun->smoke_heater_toggle_monitor);
-        }
-        if (gun->serial_bus) serial_bus_close(gun->serial_bus);
+        input_monitor_destroy(gun->trigger_pwm_monitor);
+        input_monitor_destroy(gun->smoke_heater_toggle_monitor);
+        close_link(gun);
         free(gun);
         return nullptr;
     }
@@ -605,27 +774,15 @@ void gun_fx_destroy(GunFX *gun) {
     }
     
     // Stop and destroy PWM monitors
-    if (gun->trigger_pwm_monitor) {
-        pwm_monitor_stop(gun->trigger_pwm_monitor);
-        pwm_monitor_destroy(gun->trigger_pwm_monitor);
-    }
-    if (gun->smoke_heater_toggle_monitor) {
-        pwm_monitor_stop(gun->smoke_heater_toggle_monitor);
-        pwm_monitor_destroy(gun->smoke_heater_toggle_monitor);
-    }
-    if (gun->pitch_pwm_monitor) {
-        pwm_monitor_stop(gun->pitch_pwm_monitor);
-        pwm_monitor_destroy(gun->pitch_pwm_monitor);
-    }
-    if (gun->yaw_pwm_monitor) {
-        pwm_monitor_stop(gun->yaw_pwm_monitor);
-        pwm_monitor_destroy(gun->yaw_pwm_monitor);
-    }
+    input_monitor_destroy(gun->trigger_pwm_monitor);
+    input_monitor_destroy(gun->smoke_heater_toggle_monitor);
+    input_monitor_destroy(gun->pitch_pwm_monitor);
+    input_monitor_destroy(gun->yaw_pwm_monitor);
 
     if (gun->serial_bus) {
         send_shutdown(gun);
         usleep(50000); // 50ms delay to allow Pico to process shutdown
-        serial_bus_close(gun->serial_bus);
+        close_link(gun);
     }
     
     // Destroy components
@@ -725,6 +882,72 @@ int gun_fx_get_yaw_pin(GunFX *gun) {
     return gun ? gun->yaw_pwm_pin : -1;
 }
 
+bool gun_fx_get_trigger_health(GunFX *gun, PWMHealth *health) {
+    return gun && pwm_monitor_get_health(gun->trigger_pwm_monitor, health);
+}
+
+bool gun_fx_get_heater_toggle_health(GunFX *gun, PWMHealth *health) {
+    return gun && pwm_monitor_get_health(gun->smoke_heater_toggle_monitor, health);
+}
+
+bool gun_fx_get_pitch_health(GunFX *gun, PWMHealth *health) {
+    return gun && pwm_monitor_get_health(gun->pitch_pwm_monitor, health);
+}
+
+bool gun_fx_get_yaw_health(GunFX *gun, PWMHealth *health) {
+    return gun && pwm_monitor_get_health(gun->yaw_pwm_monitor, health);
+}
+
+bool gun_fx_in_failsafe(GunFX *gun) {
+    return gun ? atomic_load(&gun->in_failsafe) : false;
+}
+
+bool gun_fx_get_link_stats(GunFX *gun, SerialBusTxStats *stats) {
+    return gun && gun->serial_bus && serial_bus_get_tx_stats(gun->serial_bus, stats) == 0;
+}
+
+bool gun_fx_get_telemetry(GunFX *gun, GunFXTelemetry *telemetry) {
+    if (!gun || !gun->serial_bus || !telemetry) return false;
+
+    int flags, fan_off_ms, rpm;
+    int servo_us[STATUS_SERVOS];
+    int64_t received_ns;
+    unsigned int seq;
+    do {
+        seq = atomic_load_explicit(&gun->telemetry_seq, memory_order_acquire);
+        if (seq & 1) continue;
+        flags = atomic_load_explicit(&gun->telemetry_flags, memory_order_relaxed);
+        fan_off_ms = atomic_load_explicit(&gun->telemetry_fan_off_ms, memory_order_relaxed);
+        for (int i = 0; i < STATUS_SERVOS; i++) {
+            servo_us[i] = atomic_load_explicit(&gun->telemetry_servo_us[i], memory_order_relaxed);
+        }
+        rpm = atomic_load_explicit(&gun->telemetry_rpm, memory_order_relaxed);
+        received_ns = atomic_load_explicit(&gun->telemetry_ns, memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+    } while ((seq & 1) || seq != atomic_load_explicit(&gun->telemetry_seq, memory_order_relaxed));
+
+    if (received_ns == 0) return false;
+
+    telemetry->firing = flags & 0x01;
+    telemetry->flash_active = flags & 0x02;
+    telemetry->flash_fading = flags & 0x04;
+    telemetry->heater_on = flags & 0x08;
+    telemetry->fan_on = flags & 0x10;
+    telemetry->fan_spindown = flags & 0x20;
+    telemetry->fan_off_remaining_ms = fan_off_ms;
+    for (int i = 0; i < STATUS_SERVOS; i++) {
+        telemetry->servo_us[i] = servo_us[i];
+    }
+    telemetry->rate_of_fire_rpm = rpm;
+    telemetry->age_ms = (int)((monotonic_ns() - received_ns) / 1000000);
+    return true;
+}
+
+const char* gun_fx_get_module_name(GunFX *gun) {
+    if (!gun || !atomic_load_explicit(&gun->module_ready, memory_order_acquire)) return nullptr;
+    return gun->module_name;
+}
+
 // Recoil jerk getters
 int gun_fx_get_pitch_recoil_jerk(GunFX *gun) {
     return gun ? gun->pitch_cfg.recoil_jerk_us : 0;
@@ -0,0 +1,243 @@
+/**
+ * @file input.c
+ * @brief Input source selection: GPIO PWM, PPM sum signal or serial RC receiver,
+ *        plus switch / mux decoders publishing virtual channels
+ */
+
+#include "input.h"
+#include "config_loader.h"
+#include "gpio.h"
+#include "rc_receiver.h"
+#include "channel_decoder.h"
+#include "calibration.h"
+#include "logging.h"
+#include <string.h>
+
+// Active serial receiver / PPM decoder (both nullptr when inputs are GPIO PWM)
+static RCReceiver *receiver = nullptr;
+static PWMMonitor *ppm_decoder = nullptr;
+
+// Switch / mux decoders: a source monitor on a physical channel feeding virtual channels
+typedef struct {
+    ChannelDecoder decoder;
+    PWMMonitor *source;
+    int output_channel;              // First virtual channel
+} InputDecoder;
+
+static InputDecoder decoders[INPUT_MAX_DECODERS];
+static int decoder_count = 0;
+
+static PWMMonitor* physical_monitor_create(int channel, const char *feature_name);
+static void physical_monitor_destroy(PWMMonitor *monitor);
+
+static InputDecoder* decoder_for_channel(int channel) {
+    for (int i = 0; i < decoder_count; i++) {
+        InputDecoder *d = &decoders[i];
+        if (channel >= d->output_channel && channel < d->output_channel + d->decoder.outputs) {
+            return d;
+        }
+    }
+    return nullptr;
+}
+
+static void input_cleanup_decoders(void) {
+    for (int i = 0; i < decoder_count; i++) {
+        physical_monitor_destroy(decoders[i].source);
+        decoders[i].source = nullptr;
+    }
+    decoder_count = 0;
+}
+
+static int input_init_decoders(const InputConfig *config) {
+    for (int i = 0; i < config->decoder_count && i < INPUT_MAX_DECODERS; i++) {
+        const ChannelDecoderConfig *cfg = &config->decoders[i];
+        InputDecoder *d = &decoders[decoder_count];
+        ChannelDecoderType type;
+        if (channel_decoder_type_from_string(cfg->type, &type) != 0) {
+            LOG_ERROR(LOG_INPUT, "Unknown decoder type: %s", cfg->type);
+            return -1;
+        }
+
+        // Levels span the learned travel when the channel is calibrated
+        ChannelCalibration cal = { .min_us = CHANNEL_DECODER_OUTPUT_MIN_US, .max_us = CHANNEL_DECODER_OUTPUT_MAX_US };
+        calibration_get(cfg->input_channel, &cal);
+        int size = type == CHANNEL_DECODER_SWITCH ? cfg->positions : cfg->bits;
+        if (channel_decoder_init(&d->decoder, type, size, cal.min_us, cal.max_us,
+                                 cfg->hysteresis_us, cfg->debounce_pulses) != 0) {
+            LOG_ERROR(LOG_INPUT, "Invalid decoder on channel %d", cfg->input_channel);
+            return -1;
+        }
+
+        d->output_channel = cfg->output_channel;
+        d->source = physical_monitor_create(cfg->input_channel, "Channel Decoder");
+        if (!d->source) {
+            return -1;
+        }
+        pwm_monitor_set_decoder(d->source, &d->decoder);
+        decoder_count++;
+        if (pwm_monitor_start(d->source) != 0) {
+            return -1;
+        }
+
+        LOG_INFO(LOG_INPUT, "Channel %d decoded as %d-%s %s -> channel %d%s", cfg->input_channel, size,
+                 type == CHANNEL_DECODER_SWITCH ? "position" : "switch",
+                 type == CHANNEL_DECODER_SWITCH ? "switch" : "mux", d->output_channel,
+                 d->decoder.outputs > 1 ? "+" : "");
+    }
+    return 0;
+}
+
+static int input_init_ppm(int ppm_channel) {
+    int pin = channel_to_gpio(ppm_channel);
+    if (pin < 0) {
+        LOG_ERROR(LOG_INPUT, "Invalid PPM input channel %d", ppm_channel);
+        return -1;
+    }
+
+    ppm_decoder = pwm_monitor_create_ppm(pin, "PPM");
+    if (!ppm_decoder) {
+        return -1;
+    }
+    if (pwm_monitor_start(ppm_decoder) != 0) {
+        pwm_monitor_destroy(ppm_decoder);
+        ppm_decoder = nullptr;
+        return -1;
+    }
+
+    LOG_INFO(LOG_INPUT, "Input source: PPM on channel %d (GPIO %d)", ppm_channel, pin);
+    return 0;
+}
+
+static int input_init_source(const InputConfig *config) {
+    if (!config || !config->source || strcmp(config->source, "pwm") == 0) {
+        LOG_INFO(LOG_INPUT, "Input source: GPIO PWM");
+        return 0;
+    }
+
+    if (strcmp(config->source, "ppm") == 0) {
+        return input_init_ppm(config->ppm_channel);
+    }
+
+    RCProtocol protocol;
+    if (rc_protocol_from_string(config->source, &protocol) != 0) {
+        LOG_ERROR(LOG_INPUT, "Unknown input source: %s", config->source);
+        return -1;
+    }
+
+    receiver = rc_receiver_open(config->device, protocol);
+    if (!receiver) {
+        return -1;
+    }
+
+    if (rc_receiver_start(receiver) != 0) {
+        rc_receiver_close(receiver);
+        receiver = nullptr;
+        return -1;
+    }
+
+    LOG_INFO(LOG_INPUT, "Input source: %s receiver on %s", rc_protocol_to_string(protocol), config->device);
+    return 0;
+}
+
+int input_init(const InputConfig *config) {
+    if (input_init_source(config) != 0) {
+        return -1;
+    }
+    if (config && input_init_decoders(config) != 0) {
+        input_cleanup();
+        return -1;
+    }
+    return 0;
+}
+
+void input_cleanup(void) {
+    input_cleanup_decoders();
+    if (ppm_decoder) {
+        pwm_monitor_stop(ppm_decoder);
+        pwm_monitor_destroy(ppm_decoder);
+        ppm_decoder = nullptr;
+    }
+    if (receiver) {
+        rc_receiver_close(receiver);
+        receiver = nullptr;
+    }
+}
+
+bool input_is_multiplexed(void) {
+    return receiver != nullptr || ppm_decoder != nullptr;
+}
+
+int input_channel_pin(int channel) {
+    return input_is_multiplexed() ? -1 : channel_to_gpio(channel);  // -1 for virtual channels too
+}
+
+static PWMMonitor* physical_monitor_create(int channel, const char *feature_name) {
+    if (!input_is_multiplexed()) {
+        int pin = channel_to_gpio(channel);
+        if (pin < 0) {
+            LOG_ERROR(LOG_INPUT, "Invalid input channel %d for %s", channel, feature_name);
+            return nullptr;
+        }
+        return pwm_monitor_create_with_name(pin, feature_name, nullptr, nullptr);
+    }
+
+    PWMMonitor *monitor = pwm_monitor_create_virtual(feature_name, nullptr, nullptr);
+    if (!monitor) {
+        return nullptr;
+    }
+    int ret = receiver ? rc_receiver_attach(receiver, channel, monitor)
+                       : pwm_monitor_ppm_attach(ppm_decoder, channel, monitor);
+    if (ret != 0) {
+        pwm_monitor_destroy(monitor);
+        return nullptr;
+    }
+
+    LOG_DEBUG(LOG_INPUT, "%s mapped to %s channel %d", feature_name, receiver ? "receiver" : "PPM", channel);
+    return monitor;
+}
+
+PWMMonitor* input_monitor_create(int channel, const char *feature_name) {
+    if (channel < VIRTUAL_CHANNEL_MIN) {
+        return physical_monitor_create(channel, feature_name);
+    }
+
+    InputDecoder *d = decoder_for_channel(channel);
+    if (!d) {
+        LOG_ERROR(LOG_INPUT, "No decoder publishes virtual channel %d for %s", channel, feature_name);
+        return nullptr;
+    }
+
+    PWMMonitor *monitor = pwm_monitor_create_virtual(feature_name, nullptr, nullptr);
+    if (!monitor) {
+        return nullptr;
+    }
+    if (pwm_monitor_decoder_attach(d->source, channel - d->output_channel, monitor) != 0) {
+        pwm_monitor_destroy(monitor);
+        return nullptr;
+    }
+
+    LOG_DEBUG(LOG_INPUT, "%s mapped to decoder output channel %d", feature_name, channel);
+    return monitor;
+}
+
+static void physical_monitor_destroy(PWMMonitor *monitor) {
+    if (!monitor) return;
+
+    if (receiver) {
+        rc_receiver_detach(receiver, monitor);
+    }
+    if (ppm_decoder) {
+        pwm_monitor_ppm_detach(ppm_decoder, monitor);
+    }
+    pwm_monitor_stop(monitor);
+    pwm_monitor_destroy(monitor);
+}
+
+void input_monitor_destroy(PWMMonitor *monitor) {
+    if (!monitor) return;
+
+    for (int i = 0; i < decoder_count; i++) {
+        pwm_monitor_decoder_detach(decoders[i].source, monitor);
+    }
+    physical_monitor_destroy(monitor);
+}
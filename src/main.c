@@ -4,13 +4,16 @@
  * Integrated engine and gun effects for scale model simulations
  * Reads configuration from YAML file and manages all effects
  * 
- * Usage: sfxhub <config.yaml>
+ * Usage: sfxhub [options] <config.yaml>
  */
 
 #include "engine_fx.h"
 #include "gun_fx.h"
 #include "audio_player.h"
 #include "gpio.h"
+#include "input.h"
+#include "rt_sched.h"
+#include "calibration.h"
 #include "config_loader.h"
 #include "logging.h"
 #include "status.h"
@@ -28,21 +31,51 @@ void signal_handler(int signum) {
     running = false;
 }
 
+static void print_usage(const char *prog) {
+    fprintf(stderr, "Usage: %s [options] <config.yaml>\n", prog);
+    fprintf(stderr, "  --interactive          Enable interactive status display (stdout) with file logging\n");
+    fprintf(stderr, "                         Without this flag, logging goes to console only\n");
+    fprintf(stderr, "  --hot-reload           Reload sound files when they change on disk\n");
+    fprintf(stderr, "  --gpio-chip <path>     GPIO chip device (default: %s)\n", GPIO_DEFAULT_CHIP);
+    fprintf(stderr, "  --record-edges <file>  Record all PWM input edges to a trace file\n");
+    fprintf(stderr, "  --replay-edges <file>  Replay a recorded edge trace instead of reading GPIO\n");
+    fprintf(stderr, "  --replay-fast          Replay as fast as possible instead of in real time\n");
+    fprintf(stderr, "  --replay-loop          Restart the trace when it ends\n");
+    fprintf(stderr, "  --calibrate            Learn input endpoints and centres, save the profile and exit\n");
+}
+
 int main(int argc, char *argv[]) {
-    if (argc < 2 || argc > 3) {
-        fprintf(stderr, "Usage: %s [--interactive] <config.yaml>\n", argv[0]);
-        fprintf(stderr, "  --interactive  Enable interactive status display (stdout) with file logging\n");
-        fprintf(stderr, "                 Without this flag, logging goes to console only\n");
-        return 1;
-    }
-    
     // Parse command line arguments
     bool interactive_mode = false;
+    bool hot_reload = false;
     const char *config_file = NULL;
+    const char *gpio_chip = NULL;
+    const char *record_edges = NULL;
+    const char *replay_edges = NULL;
+    bool replay_fast = false;
+    bool replay_loop = false;
+    bool calibrate = false;
     
     for (int i = 1; i < argc; i++) {
         if (strcmp(argv[i], "--interactive") == 0) {
             interactive_mode = true;
+        } else if (strcmp(argv[i], "--hot-reload") == 0) {
+            hot_reload = true;
+        } else if (strcmp(argv[i], "--gpio-chip") == 0 && i + 1 < argc) {
+            gpio_chip = argv[++i];
+        } else if (strcmp(argv[i], "--record-edges") == 0 && i + 1 < argc) {
+            record_edges = argv[++i];
+        } else if (strcmp(argv[i], "--replay-edges") == 0 && i + 1 < argc) {
+            replay_edges = argv[++i];
+        } else if (strcmp(argv[i], "--replay-fast") == 0) {
+            replay_fast = true;
+        } else if (strcmp(argv[i], "--replay-loop") == 0) {
+            replay_loop = true;
+        } else if (strcmp(argv[i], "--calibrate") == 0) {
+            calibrate = true;
+        } else if (argv[i][0] == '-' || config_file) {
+            print_usage(argv[0]);
+            return 1;
         } else {
             config_file = argv[i];
         }
@@ -50,7 +83,7 @@ int main(int argc, char *argv[]) {
     
     if (!config_file) {
         fprintf(stderr, "Error: Configuration file not specified\n");
-        fprintf(stderr, "Usage: %s [--interactive] <config.yaml>\n", argv[0]);
+        print_usage(argv[0]);
         return 1;
     }
     
@@ -94,18 +127,71 @@ int main(int argc, char *argv[]) {
     // Print configuration
     config_print(config);
     
+    // Real-time scheduling and memory locking (before any worker thread starts)
+    if (rt_sched_init(&config->realtime) != 0) {
+        LOG_ERROR(LOG_SFXHUB, "Invalid real-time configuration");
+        config_free(config);
+        return 1;
+    }
+    
+    // Edge replay replaces the GPIO chip as the source of PWM input edges
+    if (replay_edges) {
+        gpio_trace_set_replay(replay_edges, !replay_fast, replay_loop);
+    }
+    
+    // One contiguous monitor block covers every input the configuration creates
+    int monitor_count = config_monitor_count(config);
+    gpio_set_monitor_capacity(monitor_count > 0 ? monitor_count : 1);
+    
     // Initialize GPIO (required for PWM emitters, servo control, lights, and general GPIO)
-    if (gpio_init() < 0) {
+    if (gpio_init(gpio_chip) < 0) {
         LOG_ERROR(LOG_SFXHUB, "Failed to initialize GPIO");
         LOG_ERROR(LOG_SFXHUB, "Note: Try running with sudo for GPIO access");
         return 1;
     }
     LOG_INFO(LOG_SFXHUB, "GPIO subsystem initialized (PWM emitters ready)");
     
+    if (record_edges && gpio_trace_record_start(record_edges) != 0) {
+        LOG_WARN(LOG_SFXHUB, "Edge recording disabled");
+    }
+    
+    // Calibration profile (learned in --calibrate mode, applied to servo mappings and decoders)
+    char calibration_path[512];
+    snprintf(calibration_path, sizeof(calibration_path), "%s",
+             config->inputs.calibration ? config->inputs.calibration : config_file);
+    if (!config->inputs.calibration) {
+        strncat(calibration_path, ".calibration", sizeof(calibration_path) - strlen(calibration_path) - 1);
+    }
+    if (!calibrate) {
+        calibration_load(calibration_path);
+    }
+    
+    // Select input source (GPIO PWM or serial RC receiver). Calibration reads
+    // decoded channels raw, so decoders are not started in that mode.
+    InputConfig inputs = config->inputs;
+    if (calibrate) {
+        inputs.decoder_count = 0;
+    }
+    if (input_init(&inputs) < 0) {
+        LOG_ERROR(LOG_SFXHUB, "Failed to initialize inputs");
+        gpio_cleanup();
+        return 1;
+    }
+    
+    if (calibrate) {
+        int result = calibration_run(config, calibration_path, &running);
+        input_cleanup();
+        gpio_cleanup();
+        config_free(config);
+        logging_shutdown();
+        return result == 0 ? 0 : 1;
+    }
+    
     // Create audio mixer (8 channels)
     AudioMixer *mixer = audio_mixer_create(8);
     if (!mixer) {
         LOG_ERROR(LOG_SFXHUB, "Failed to create audio mixer");
+        input_cleanup();
         gpio_cleanup();
         return 1;
     }
@@ -115,10 +201,22 @@ int main(int argc, char *argv[]) {
     if (!sound_mgr) {
         LOG_ERROR(LOG_SFXHUB, "Failed to create sound manager");
         audio_mixer_destroy(mixer);
+        input_cleanup();
         gpio_cleanup();
         return 1;
     }
     
+    // Sound load options: compressed assets trade a little callback CPU for
+    // ~8x less RAM; normalisation evens out levels across sound packs
+    SoundLoadOptions load_options = SOUND_LOAD_DEFAULTS;
+    if (config->audio.asset_storage && strcmp(config->audio.asset_storage, "adpcm") == 0) {
+        load_options.storage = SOUND_STORAGE_ADPCM;
+        LOG_INFO(LOG_SFXHUB, "Sound assets stored as IMA-ADPCM");
+    }
+    load_options.normalize = config->audio.normalize;
+    load_options.target_lufs = config->audio.target_lufs;
+    sound_manager_set_load_options(sound_mgr, &load_options);
+    
     // Initialize Engine FX if configured (optional)
     EngineFX *engine = nullptr;
     bool engine_present = (config->engine.engine_toggle.input_channel != 0) ||
@@ -164,6 +262,16 @@ int main(int argc, char *argv[]) {
                 config->gun.rates[i].sound_file);
         }
         
+        // Fade envelope for the gun channel so trigger release doesn't click
+        sound_manager_load_sound(sound_mgr, SOUND_GUN_RELEASE_TAIL, config->gun.envelope.release_tail);
+        ChannelEnvelope gun_envelope = {
+            .fade_in_ms = config->gun.envelope.fade_in_ms,
+            .fade_out_ms = config->gun.envelope.fade_out_ms,
+            .volume_ramp_ms = config->gun.envelope.volume_ramp_ms,
+            .release_tail = sound_manager_get_sound(sound_mgr, SOUND_GUN_RELEASE_TAIL)
+        };
+        audio_mixer_set_channel_envelope(mixer, 1, &gun_envelope);
+        
         // Create gun FX controller (audio channel 1)
         gun = gun_fx_create(mixer, 1, &config->gun);
         
@@ -196,6 +304,11 @@ int main(int argc, char *argv[]) {
         LOG_INFO(LOG_SFXHUB, "Gun FX not configured; skipping initialization");
     }
     
+    // Watch loaded sound files for changes (asset iteration without restart)
+    if (hot_reload && sound_manager_enable_hot_reload(sound_mgr) != 0) {
+        LOG_WARN(LOG_SFXHUB, "Failed to enable sound hot reload");
+    }
+    
     // Create status display if in interactive mode
     StatusDisplay *status = NULL;
     if (interactive_mode) {
@@ -236,10 +349,11 @@ int main(int argc, char *argv[]) {
         LOG_INFO(LOG_SFXHUB, "Gun FX thread stopped");
     }
     
-    // Cleanup resources
+    // Cleanup resources (mixer first: playing voices reference sound buffers)
+    audio_mixer_destroy(mixer);
     sound_manager_destroy(sound_mgr);
     config_free(config);
-    audio_mixer_destroy(mixer);
+    input_cleanup();
     gpio_cleanup();
     
     LOG_INFO(LOG_SFXHUB, "Shutdown complete");
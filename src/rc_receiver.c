@@ -0,0 +1,525 @@
+/**
+ * @file rc_receiver.c
+ * @brief Serial RC receiver input backend (SBUS, FlySky iBUS, CRSF, Pico capture)
+ *
+ * One reader thread per receiver polls the UART fd, runs the byte stream
+ * through a resynchronising frame parser and injects each channel value into
+ * the attached virtual PWM monitors. The Pico source has no reader of its
+ * own: its capture frames arrive through a packet handler on the serial bus
+ * it shares with the GunFX link.
+ */
+
+#include "rc_receiver.h"
+#include "gpio.h"
+#include "logging.h"
+#include "rt_sched.h"
+#include "serial_bus.h"
+#include <asm/termbits.h>   // termios2 / BOTHER for 100000 and 420000 baud
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <threads.h>
+
+// SBUS: 0x0F, 22 bytes of 16x11-bit channels, flags, footer
+#define SBUS_FRAME_LEN        25
+#define SBUS_HEADER           0x0F
+#define SBUS_FLAG_FRAME_LOST  0x04
+#define SBUS_FLAG_FAILSAFE    0x08
+
+// iBUS: 0x20 0x40, 14x uint16 LE channels, uint16 LE checksum
+#define IBUS_FRAME_LEN        32
+#define IBUS_HEADER_LEN       0x20
+#define IBUS_HEADER_CMD       0x40
+#define IBUS_CHANNELS         14
+
+// CRSF: [address][length][type][payload][crc8 DVB-S2 over type+payload]
+#define CRSF_MAX_LEN          62
+#define CRSF_TYPE_RC_CHANNELS 0x16
+#define CRSF_RC_PAYLOAD_LEN   22
+
+// Pico capture: packets on the GunFX link (see serial_bus.h). CAPTURE_FRAME
+// payload: fresh_mask:u8, age_us:u16le, pulse_us[n]:u16le - bit i of
+// fresh_mask is set when input i captured a new pulse since the previous frame
+#define PICO_PKT_CAPTURE_CTRL   0x30   // Pi -> Pico, payload: enable:u8
+#define PICO_PKT_CAPTURE_FRAME  0x31   // Pico -> Pi
+#define PICO_CAPTURE_HEADER_LEN 3
+#define PICO_CAPTURE_MAX_AGE_US 50000  // Ages above this are treated as link delay, not capture time
+
+struct RCReceiver {
+    char device_path[256];
+    RCProtocol protocol;
+    int fd;
+    int stop_fd;
+    SerialBus *bus;             // RC_PROTOCOL_PICO: link to the Pico (fd and thread unused)
+
+    RCParser parser;
+
+    mtx_t monitors_mutex;
+    PWMMonitor *monitors[RC_RECEIVER_MAX_CHANNELS];
+
+    thrd_t thread;
+    atomic_bool running;
+};
+
+// ============================================================================
+// PROTOCOL HELPERS
+// ============================================================================
+
+int rc_protocol_from_string(const char *name, RCProtocol *protocol) {
+    if (!name || !protocol) return -1;
+    if (strcmp(name, "sbus") == 0) { *protocol = RC_PROTOCOL_SBUS; return 0; }
+    if (strcmp(name, "ibus") == 0) { *protocol = RC_PROTOCOL_IBUS; return 0; }
+    if (strcmp(name, "crsf") == 0) { *protocol = RC_PROTOCOL_CRSF; return 0; }
+    if (strcmp(name, "pico") == 0) { *protocol = RC_PROTOCOL_PICO; return 0; }
+    return -1;
+}
+
+const char* rc_protocol_to_string(RCProtocol protocol) {
+    switch (protocol) {
+        case RC_PROTOCOL_SBUS: return "sbus";
+        case RC_PROTOCOL_IBUS: return "ibus";
+        case RC_PROTOCOL_CRSF: return "crsf";
+        case RC_PROTOCOL_PICO: return "pico";
+        default:               return "unknown";
+    }
+}
+
+// SBUS / CRSF 11-bit value (172-1811, centre 992) to microseconds
+static int rc_11bit_to_us(int value) {
+    return 1500 + ((value - 992) * 5) / 8;
+}
+
+// Unpack 16 little-endian 11-bit channels (shared by SBUS and CRSF)
+static void unpack_11bit_channels(const uint8_t *data, int *channels_us) {
+    uint32_t bits = 0;
+    int bit_count = 0;
+    int ch = 0;
+    for (int i = 0; i < 22 && ch < 16; i++) {
+        bits |= (uint32_t)data[i] << bit_count;
+        bit_count += 8;
+        while (bit_count >= 11 && ch < 16) {
+            channels_us[ch++] = rc_11bit_to_us((int)(bits & 0x7FF));
+            bits >>= 11;
+            bit_count -= 11;
+        }
+    }
+}
+
+static uint8_t crsf_crc8(const uint8_t *data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? (uint8_t)((crc << 1) ^ 0xD5) : (uint8_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+// ============================================================================
+// STREAM PARSER
+// ============================================================================
+
+void rc_parser_init(RCParser *parser, RCProtocol protocol) {
+    memset(parser, 0, sizeof(*parser));
+    parser->protocol = protocol;
+}
+
+void rc_parser_resync(RCParser *parser) {
+    parser->len = 0;
+}
+
+static bool is_frame_start(RCProtocol protocol, uint8_t byte) {
+    switch (protocol) {
+        case RC_PROTOCOL_SBUS: return byte == SBUS_HEADER;
+        case RC_PROTOCOL_IBUS: return byte == IBUS_HEADER_LEN;
+        case RC_PROTOCOL_CRSF: return byte == 0xC8 || byte == 0xEA || byte == 0xEC || byte == 0xEE;
+        case RC_PROTOCOL_PICO: break;  // Decoded by pico_on_capture(), not the stream parser
+    }
+    return false;
+}
+
+// Expected length of the frame at the start of the buffer: 0 = need more bytes, -1 = not a frame
+static int frame_length(const RCParser *p) {
+    switch (p->protocol) {
+        case RC_PROTOCOL_SBUS:
+            return SBUS_FRAME_LEN;
+        case RC_PROTOCOL_IBUS:
+            if (p->len < 2) return 0;
+            return p->buf[1] == IBUS_HEADER_CMD ? IBUS_FRAME_LEN : -1;
+        case RC_PROTOCOL_CRSF:
+            if (p->len < 2) return 0;
+            return (p->buf[1] >= 2 && p->buf[1] <= CRSF_MAX_LEN) ? p->buf[1] + 2 : -1;
+        case RC_PROTOCOL_PICO:
+            break;
+    }
+    return -1;
+}
+
+// Decode a complete frame: 1 = channels, 0 = valid but no usable channels, -1 = corrupt
+static int decode_frame(RCParser *p, int len, int *channels_us, int *count) {
+    const uint8_t *f = p->buf;
+
+    switch (p->protocol) {
+        case RC_PROTOCOL_SBUS: {
+            uint8_t footer = f[24];
+            if (footer != 0x00 && (footer & 0x0F) != 0x04) return -1;  // SBUS / SBUS2 footers
+            if (f[23] & (SBUS_FLAG_FAILSAFE | SBUS_FLAG_FRAME_LOST)) {
+                p->failsafe_frames++;
+                return 0;
+            }
+            unpack_11bit_channels(&f[1], channels_us);
+            *count = 16;
+            return 1;
+        }
+        case RC_PROTOCOL_IBUS: {
+            uint16_t sum = 0xFFFF;
+            for (int i = 0; i < IBUS_FRAME_LEN - 2; i++) sum -= f[i];
+            if (sum != (uint16_t)(f[30] | (f[31] << 8))) return -1;
+            for (int i = 0; i < IBUS_CHANNELS; i++) {
+                channels_us[i] = (f[2 + 2 * i] | (f[3 + 2 * i] << 8)) & 0x0FFF;
+            }
+            *count = IBUS_CHANNELS;
+            return 1;
+        }
+        case RC_PROTOCOL_CRSF: {
+            if (crsf_crc8(&f[2], (size_t)len - 3) != f[len - 1]) return -1;
+            if (f[2] != CRSF_TYPE_RC_CHANNELS || len - 4 != CRSF_RC_PAYLOAD_LEN) {
+                return 0;  // Link statistics, telemetry, etc.
+            }
+            unpack_11bit_channels(&f[3], channels_us);
+            *count = 16;
+            return 1;
+        }
+        case RC_PROTOCOL_PICO:
+            break;
+    }
+    return -1;
+}
+
+static void parser_drop(RCParser *p, size_t n) {
+    memmove(p->buf, p->buf + n, p->len - n);
+    p->len -= n;
+}
+
+void rc_parser_feed(RCParser *parser, const uint8_t *data, size_t len,
+                    void (*on_frame)(const int *channels_us, int count, void *user_data),
+                    void *user_data) {
+    for (size_t i = 0; i < len; i++) {
+        if (parser->len == 0 && !is_frame_start(parser->protocol, data[i])) {
+            parser->errors++;
+            continue;
+        }
+        parser->buf[parser->len++] = data[i];
+
+        // Consume every complete frame at the head of the buffer; on corruption
+        // drop one byte and rescan from the next candidate header
+        while (parser->len > 0) {
+            if (!is_frame_start(parser->protocol, parser->buf[0])) {
+                parser_drop(parser, 1);
+                parser->errors++;
+                continue;
+            }
+
+            int need = frame_length(parser);
+            if (need < 0) {
+                parser_drop(parser, 1);
+                parser->errors++;
+                continue;
+            }
+            if (need == 0 || (size_t)need > parser->len) {
+                break;  // Wait for more bytes
+            }
+
+            int channels_us[RC_RECEIVER_MAX_CHANNELS];
+            int count = 0;
+            int result = decode_frame(parser, need, channels_us, &count);
+            if (result < 0) {
+                parser_drop(parser, 1);
+                parser->errors++;
+                continue;
+            }
+            if (result > 0) {
+                parser->frames++;
+                if (on_frame) on_frame(channels_us, count, user_data);
+            }
+            parser_drop(parser, (size_t)need);
+        }
+    }
+}
+
+// ============================================================================
+// RECEIVER
+// ============================================================================
+
+// Configure the UART for the protocol's line settings (custom baud via termios2)
+static int configure_uart(int fd, RCProtocol protocol) {
+    struct termios2 tio;
+    if (ioctl(fd, TCGETS2, &tio) != 0) {
+        return -1;
+    }
+
+    unsigned int baud = protocol == RC_PROTOCOL_SBUS ? 100000 :
+                        protocol == RC_PROTOCOL_CRSF ? 420000 : 115200;
+
+    tio.c_cflag &= ~(CBAUD | CSIZE | PARENB | PARODD | CSTOPB | CRTSCTS);
+    tio.c_cflag |= BOTHER | CS8 | CLOCAL | CREAD;
+    if (protocol == RC_PROTOCOL_SBUS) {
+        tio.c_cflag |= PARENB | CSTOPB;  // 8E2
+    }
+    tio.c_ispeed = baud;
+    tio.c_ospeed = baud;
+    tio.c_iflag = 0;
+    tio.c_oflag = 0;
+    tio.c_lflag = 0;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = 0;
+
+    return ioctl(fd, TCSETS2, &tio);
+}
+
+static int64_t monotonic_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Inject every attached channel with a value (0 = no new pulse) at time ns
+static void publish_channels(RCReceiver *rx, const int *channels_us, int count, int64_t ns) {
+    mtx_lock(&rx->monitors_mutex);
+    for (int ch = 0; ch < count; ch++) {
+        if (rx->monitors[ch] && channels_us[ch] > 0) {
+            pwm_monitor_inject_pulse(rx->monitors[ch], channels_us[ch], ns);
+        }
+    }
+    mtx_unlock(&rx->monitors_mutex);
+}
+
+// Parser callback: publish with the frame's arrival time
+static void publish_frame(const int *channels_us, int count, void *user_data) {
+    publish_channels((RCReceiver *)user_data, channels_us, count, monotonic_ns());
+}
+
+// CAPTURE_FRAME handler (serial bus reader thread). Pulses are backdated by
+// the capture age the Pico reports, so USB transfer and host scheduling
+// delays do not show up as pulse timing jitter.
+static void pico_on_capture(uint8_t type, const uint8_t *payload, size_t len, void *user_data) {
+    RCReceiver *rx = (RCReceiver *)user_data;
+    (void)type;
+
+    int inputs = ((int)len - PICO_CAPTURE_HEADER_LEN) / 2;
+    if (len < PICO_CAPTURE_HEADER_LEN || (len - PICO_CAPTURE_HEADER_LEN) % 2 != 0 ||
+        inputs > RC_PICO_MAX_CHANNELS) {
+        rx->parser.errors++;
+        return;
+    }
+
+    uint8_t fresh = payload[0];
+    uint32_t age_us = (uint32_t)(payload[1] | (payload[2] << 8));
+    int channels_us[RC_PICO_MAX_CHANNELS];
+    for (int i = 0; i < inputs; i++) {
+        const uint8_t *v = &payload[PICO_CAPTURE_HEADER_LEN + 2 * i];
+        channels_us[i] = (fresh & (1u << i)) ? (v[0] | (v[1] << 8)) : 0;
+    }
+
+    int64_t ns = monotonic_ns();
+    if (age_us <= PICO_CAPTURE_MAX_AGE_US) {
+        ns -= (int64_t)age_us * 1000;
+    }
+    rx->parser.frames++;
+    publish_channels(rx, channels_us, inputs, ns);
+}
+
+// Ask the Pico to start / stop streaming capture frames
+static int pico_set_capture(RCReceiver *rx, bool enable) {
+    uint8_t payload = enable ? 1 : 0;
+    return serial_bus_send_packet(rx->bus, PICO_PKT_CAPTURE_CTRL, &payload, 1);
+}
+
+static int rc_receiver_thread(void *arg) {
+    RCReceiver *rx = (RCReceiver *)arg;
+    uint8_t buf[256];
+    struct pollfd fds[2] = {
+        { .fd = rx->fd, .events = POLLIN },
+        { .fd = rx->stop_fd, .events = POLLIN },
+    };
+
+    rt_sched_apply(RT_ROLE_INPUT, "sfx-rc-rx");
+    LOG_INFO(LOG_INPUT, "RC receiver thread started (%s on %s)",
+             rc_protocol_to_string(rx->protocol), rx->device_path);
+
+    while (atomic_load(&rx->running)) {
+        int ret = poll(fds, 2, 100);
+        if (ret < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(LOG_INPUT, "poll() error: %s", strerror(errno));
+            break;
+        }
+        if (ret == 0) {
+            rc_parser_resync(&rx->parser);  // Line idle: drop any partial frame
+            continue;
+        }
+        if (fds[1].revents & POLLIN) break;
+
+        if (fds[0].revents & (POLLERR | POLLHUP)) {
+            LOG_ERROR(LOG_INPUT, "RC receiver device %s closed", rx->device_path);
+            break;
+        }
+
+        ssize_t n = read(rx->fd, buf, sizeof(buf));
+        if (n > 0) {
+            rc_parser_feed(&rx->parser, buf, (size_t)n, publish_frame, rx);
+        } else if (n < 0 && errno != EAGAIN && errno != EINTR) {
+            LOG_ERROR(LOG_INPUT, "RC receiver read error: %s", strerror(errno));
+            break;
+        }
+    }
+
+    LOG_INFO(LOG_INPUT, "RC receiver thread stopped (%u frames, %u failsafe, %u bytes discarded)",
+             rx->parser.frames, rx->parser.failsafe_frames, rx->parser.errors);
+    return thrd_success;
+}
+
+RCReceiver* rc_receiver_open(const char *device_path, RCProtocol protocol) {
+    if (!device_path) {
+        LOG_ERROR(LOG_INPUT, "No RC receiver device configured");
+        return nullptr;
+    }
+
+    RCReceiver *rx = calloc(1, sizeof(RCReceiver));
+    if (!rx) {
+        LOG_ERROR(LOG_INPUT, "Cannot allocate memory for RC receiver");
+        return nullptr;
+    }
+
+    snprintf(rx->device_path, sizeof(rx->device_path), "%s", device_path);
+    rx->protocol = protocol;
+    rc_parser_init(&rx->parser, protocol);
+    mtx_init(&rx->monitors_mutex, mtx_plain);
+    atomic_init(&rx->running, false);
+    rx->fd = -1;
+    rx->stop_fd = -1;
+
+    // The Pico's tty may already be open for the GunFX link; share that bus
+    if (protocol == RC_PROTOCOL_PICO) {
+        SerialBusConfig bus_config = { .device_path = device_path, .baud_rate = 115200, .timeout_ms = 100 };
+        rx->bus = serial_bus_open(&bus_config);
+        if (!rx->bus) {
+            LOG_ERROR(LOG_INPUT, "Failed to open Pico capture link %s", device_path);
+            mtx_destroy(&rx->monitors_mutex);
+            free(rx);
+            return nullptr;
+        }
+        LOG_INFO(LOG_INPUT, "RC receiver opened: %s (%s)", device_path, rc_protocol_to_string(protocol));
+        return rx;
+    }
+
+    rx->fd = open(device_path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (rx->fd < 0) {
+        LOG_ERROR(LOG_INPUT, "Failed to open RC receiver %s: %s", device_path, strerror(errno));
+        mtx_destroy(&rx->monitors_mutex);
+        free(rx);
+        return nullptr;
+    }
+
+    // A pty (capture replay) may not accept custom line settings; data still flows
+    if (configure_uart(rx->fd, protocol) != 0) {
+        LOG_WARN(LOG_INPUT, "Could not set %s line settings on %s: %s",
+                 rc_protocol_to_string(protocol), device_path, strerror(errno));
+    }
+
+    rx->stop_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (rx->stop_fd < 0) {
+        LOG_ERROR(LOG_INPUT, "Failed to create RC receiver eventfd: %s", strerror(errno));
+        close(rx->fd);
+        mtx_destroy(&rx->monitors_mutex);
+        free(rx);
+        return nullptr;
+    }
+
+    LOG_INFO(LOG_INPUT, "RC receiver opened: %s (%s)", device_path, rc_protocol_to_string(protocol));
+    return rx;
+}
+
+int rc_receiver_start(RCReceiver *rx) {
+    if (!rx) return -1;
+    if (atomic_load(&rx->running)) return 0;
+
+    if (rx->bus) {
+        if (serial_bus_set_handler(rx->bus, PICO_PKT_CAPTURE_FRAME, pico_on_capture, rx) != 0) {
+            return -1;
+        }
+        atomic_store(&rx->running, true);
+        if (pico_set_capture(rx, true) != 0) {
+            LOG_WARN(LOG_INPUT, "Could not enable Pico pulse capture on %s", rx->device_path);
+        }
+        return 0;
+    }
+
+    atomic_store(&rx->running, true);
+    if (thrd_create(&rx->thread, rc_receiver_thread, rx) != thrd_success) {
+        LOG_ERROR(LOG_INPUT, "Failed to create RC receiver thread");
+        atomic_store(&rx->running, false);
+        return -1;
+    }
+    return 0;
+}
+
+void rc_receiver_close(RCReceiver *rx) {
+    if (!rx) return;
+
+    if (rx->bus) {
+        if (atomic_load(&rx->running)) {
+            pico_set_capture(rx, false);
+            serial_bus_set_handler(rx->bus, PICO_PKT_CAPTURE_FRAME, nullptr, nullptr);
+            LOG_INFO(LOG_INPUT, "Pico capture stopped (%u frames, %u malformed)",
+                     rx->parser.frames, rx->parser.errors);
+        }
+        serial_bus_close(rx->bus);
+    } else {
+        if (atomic_load(&rx->running)) {
+            atomic_store(&rx->running, false);
+            eventfd_write(rx->stop_fd, 1);
+            thrd_join(rx->thread, nullptr);
+        }
+        close(rx->stop_fd);
+        close(rx->fd);
+    }
+    mtx_destroy(&rx->monitors_mutex);
+    free(rx);
+
+    LOG_INFO(LOG_INPUT, "RC receiver closed");
+}
+
+int rc_receiver_attach(RCReceiver *rx, int channel, PWMMonitor *monitor) {
+    if (!rx || channel < 1 || channel > RC_RECEIVER_MAX_CHANNELS) {
+        LOG_ERROR(LOG_INPUT, "Invalid RC receiver channel %d (must be 1-%d)",
+                  channel, RC_RECEIVER_MAX_CHANNELS);
+        return -1;
+    }
+
+    mtx_lock(&rx->monitors_mutex);
+    rx->monitors[channel - 1] = monitor;
+    mtx_unlock(&rx->monitors_mutex);
+    return 0;
+}
+
+void rc_receiver_detach(RCReceiver *rx, PWMMonitor *monitor) {
+    if (!rx || !monitor) return;
+
+    mtx_lock(&rx->monitors_mutex);
+    for (int i = 0; i < RC_RECEIVER_MAX_CHANNELS; i++) {
+        if (rx->monitors[i] == monitor) {
+            rx->monitors[i] = nullptr;
+        }
+    }
+    mtx_unlock(&rx->monitors_mutex);
+}
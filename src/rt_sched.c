@@ -0,0 +1,174 @@
+/**
+ * @file rt_sched.c
+ * @brief Real-time scheduling, CPU affinity and memory locking
+ */
+
+#define _GNU_SOURCE  // CPU_SET, pthread_setaffinity_np, pthread_setname_np
+
+#include "rt_sched.h"
+#include "config_loader.h"
+#include "logging.h"
+#include <errno.h>
+#include <malloc.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+
+#define RT_STACK_PREFAULT_BYTES (256 * 1024)
+
+typedef struct {
+    bool configured;
+    int policy;
+    int priority;
+    bool has_affinity;
+    cpu_set_t cpus;
+} RTRoleSettings;
+
+static RTRoleSettings role_settings[RT_ROLE_COUNT];
+static bool memory_locked = false;
+static atomic_flag privilege_warned = ATOMIC_FLAG_INIT;
+
+static const char *role_names[RT_ROLE_COUNT] = { "input", "audio", "engine", "gun" };
+
+// Parse "2", "2,3" or "0-3" into a CPU set
+static int parse_cpu_list(const char *list, cpu_set_t *set) {
+    CPU_ZERO(set);
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long first = strtol(p, &end, 10);
+        if (end == p || first < 0 || first >= CPU_SETSIZE) return -1;
+        long last = first;
+        p = end;
+        if (*p == '-') {
+            last = strtol(p + 1, &end, 10);
+            if (end == p + 1 || last < first || last >= CPU_SETSIZE) return -1;
+            p = end;
+        }
+        for (long cpu = first; cpu <= last; cpu++) {
+            CPU_SET((int)cpu, set);
+        }
+        if (*p == ',') p++;
+        else if (*p != '\0') return -1;
+    }
+    return CPU_COUNT(set) > 0 ? 0 : -1;
+}
+
+static int load_role(RTRole role, const RealtimeThreadConfig *cfg) {
+    RTRoleSettings *rs = &role_settings[role];
+    memset(rs, 0, sizeof(*rs));
+    rs->policy = SCHED_OTHER;
+
+    if (cfg->policy && strcmp(cfg->policy, "fifo") == 0) {
+        rs->policy = SCHED_FIFO;
+    } else if (cfg->policy && strcmp(cfg->policy, "rr") == 0) {
+        rs->policy = SCHED_RR;
+    }
+    rs->priority = rs->policy == SCHED_OTHER ? 0 : cfg->priority;
+
+    if (cfg->cpus) {
+        if (parse_cpu_list(cfg->cpus, &rs->cpus) != 0) {
+            LOG_ERROR(LOG_RT, "Invalid CPU list for %s threads: \"%s\"", role_names[role], cfg->cpus);
+            return -1;
+        }
+        rs->has_affinity = true;
+    }
+
+    rs->configured = rs->policy != SCHED_OTHER || rs->has_affinity;
+    if (rs->configured) {
+        LOG_INFO(LOG_RT, "%-6s threads: %s priority %d, CPUs %s", role_names[role],
+                 cfg->policy ? cfg->policy : "other", rs->priority, cfg->cpus ? cfg->cpus : "any");
+    }
+    return 0;
+}
+
+// Touch a block of the calling thread's stack so later calls never take a
+// page fault there (pages stay locked)
+static void prefault_stack(void) {
+    volatile unsigned char stack[RT_STACK_PREFAULT_BYTES];
+    for (size_t i = 0; i < sizeof(stack); i += 4096) {
+        stack[i] = 0;
+    }
+}
+
+static void lock_memory(void) {
+    // Keep freed heap in the process instead of returning it to the kernel,
+    // so locked pages are reused rather than faulted in again
+    mallopt(M_TRIM_THRESHOLD, -1);
+    mallopt(M_MMAP_MAX, 0);
+
+    // MCL_ONFAULT locks new mappings page by page as they are touched. Without
+    // it every later thread stack (8 MiB by default) would be populated and
+    // pinned in full; instead each real-time thread prefaults a fixed block.
+    int flags = MCL_CURRENT | MCL_FUTURE;
+#ifdef MCL_ONFAULT
+    flags |= MCL_ONFAULT;
+#endif
+    if (mlockall(flags) != 0) {
+        LOG_WARN(LOG_RT, "mlockall failed: %s - memory not locked (needs CAP_IPC_LOCK or a higher RLIMIT_MEMLOCK)",
+                 strerror(errno));
+        return;
+    }
+
+    memory_locked = true;
+    prefault_stack();
+    LOG_INFO(LOG_RT, "Process memory locked (new pages locked on first touch), %d KB of main stack prefaulted",
+             RT_STACK_PREFAULT_BYTES / 1024);
+}
+
+int rt_sched_init(const RealtimeConfig *config) {
+    memset(role_settings, 0, sizeof(role_settings));
+    if (!config) return 0;
+
+    if (load_role(RT_ROLE_INPUT, &config->input) != 0 ||
+        load_role(RT_ROLE_AUDIO, &config->audio) != 0 ||
+        load_role(RT_ROLE_ENGINE, &config->engine) != 0 ||
+        load_role(RT_ROLE_GUN, &config->gun) != 0) {
+        return -1;
+    }
+
+    if (config->lock_memory) {
+        lock_memory();
+    }
+    return 0;
+}
+
+void rt_sched_apply(RTRole role, const char *thread_name) {
+    if (thread_name) {
+        pthread_setname_np(pthread_self(), thread_name);
+    }
+    if (role < 0 || role >= RT_ROLE_COUNT) return;
+
+    const RTRoleSettings *rs = &role_settings[role];
+    if (!rs->configured) return;
+
+    // The audio role is applied from inside the first device callback, where
+    // touching a large block of stack would glitch; its stack pages are locked
+    // as the callback first uses them
+    if (memory_locked && role != RT_ROLE_AUDIO) {
+        prefault_stack();
+    }
+
+    if (rs->has_affinity) {
+        int err = pthread_setaffinity_np(pthread_self(), sizeof(rs->cpus), &rs->cpus);
+        if (err != 0) {
+            LOG_WARN(LOG_RT, "Cannot set CPU affinity for %s: %s", thread_name ?: role_names[role], strerror(err));
+        }
+    }
+
+    if (rs->policy != SCHED_OTHER) {
+        struct sched_param param = { .sched_priority = rs->priority };
+        int err = pthread_setschedparam(pthread_self(), rs->policy, &param);
+        if (err == EPERM) {
+            if (!atomic_flag_test_and_set(&privilege_warned)) {
+                LOG_WARN(LOG_RT, "No permission for real-time scheduling - threads stay on CFS. "
+                         "Run as root, grant CAP_SYS_NICE (setcap cap_sys_nice+ep) or raise RLIMIT_RTPRIO");
+            }
+        } else if (err != 0) {
+            LOG_WARN(LOG_RT, "Cannot set real-time priority for %s: %s", thread_name ?: role_names[role], strerror(err));
+        }
+    }
+}
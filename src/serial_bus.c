@@ -1,5 +1,6 @@
 #include "serial_bus.h"
 #include "logging.h"
+#include "rt_sched.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -9,6 +10,33 @@
 #include <termios.h>
 #include <errno.h>
 #include <stdint.h>
+#include <poll.h>
+#include <time.h>
+#include <threads.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <sys/eventfd.h>
+#include <sys/uio.h>
+
+#define SERIAL_BUS_TX_RING_SIZE   4096    // Queued TX bytes (power of two)
+#define SERIAL_BUS_TX_RING_MASK   (SERIAL_BUS_TX_RING_SIZE - 1)
+#define SERIAL_BUS_TX_COALESCE_US 1000    // Packets queued within this window share one write()
+#define SERIAL_BUS_TX_POLL_MS     100     // Wait for a stalled device to become writable
+#define SERIAL_BUS_TX_DRAIN_MS    250     // On close, time allowed to send what is still queued
+
+#define SERIAL_BUS_RX_RING_MASK   (SERIAL_BUS_RX_RING_SIZE - 1)
+#define SERIAL_BUS_MAX_PACKET     (2 + 255 + 1)  // [type][len][payload][crc]
+#define SERIAL_BUS_ACM_SCAN       10      // /dev/ttyACM0-9 are checked for a VID/PID match
+
+_Static_assert((SERIAL_BUS_TX_RING_SIZE & SERIAL_BUS_TX_RING_MASK) == 0,
+               "SERIAL_BUS_TX_RING_SIZE must be a power of two");
+_Static_assert((SERIAL_BUS_RX_RING_SIZE & SERIAL_BUS_RX_RING_MASK) == 0,
+               "SERIAL_BUS_RX_RING_SIZE must be a power of two");
+
+typedef struct {
+    SerialBusPacketHandler handler;
+    void *user_data;
+} SerialBusHandlerEntry;
 
 struct SerialBus {
     int fd;                     // File descriptor
@@ -16,8 +44,56 @@ struct SerialBus {
     int baud_rate;              // Baud rate
     int timeout_ms;             // Read timeout
     struct termios orig_termios; // Original terminal settings (for restore)
+
+    // TX ring: writers append under tx_mutex; the TX thread sends
+    // [tx_head, tx_head + tx_count) without the lock, then advances tx_head
+    uint8_t tx_ring[SERIAL_BUS_TX_RING_SIZE];
+    size_t tx_head;
+    size_t tx_count;
+    bool tx_stop;
+    bool tx_full_logged;        // Backpressure warning issued for the current stall
+    mtx_t tx_mutex;
+    cnd_t tx_cond;
+    thrd_t tx_thread;
+    SerialBusTxStats tx_stats;
+
+    // RX: the reader thread owns the ring. Indices are free-running:
+    // [rx_start, rx_end) is buffered, rx_scan is the next byte to check for
+    // a delimiter. Handlers are swapped under rx_mutex, held while dispatching.
+    uint8_t rx_ring[SERIAL_BUS_RX_RING_SIZE];
+    uint8_t rx_scratch[SERIAL_BUS_RX_RING_SIZE];    // Frames that wrap or carry debug text
+    uint8_t rx_packet[SERIAL_BUS_MAX_PACKET];       // Decoded from rx_scratch
+    size_t rx_start;
+    size_t rx_scan;
+    size_t rx_end;
+    SerialBusHandlerEntry handlers[256];
+    mtx_t rx_mutex;
+    bool rx_started;
+    int rx_stop_fd;             // eventfd: wakes the reader thread to exit
+    thrd_t rx_thread;
+    atomic_uint rx_packets;
+    atomic_uint rx_unhandled;
+    atomic_uint rx_bad_frames;
+    atomic_uint rx_overruns;
+
+    // Open buses are shared per device (see serial_bus_open)
+    char real_path[PATH_MAX];
+    int refs;
+    SerialBus *next;
 };
 
+static int serial_bus_tx_thread(void *arg);
+static int serial_bus_rx_thread(void *arg);
+
+// Buses currently open, so a second open of the same device shares the fd
+static SerialBus *open_buses = NULL;
+static mtx_t open_buses_mutex;
+static once_flag open_buses_once = ONCE_FLAG_INIT;
+
+static void open_buses_init(void) {
+    mtx_init(&open_buses_mutex, mtx_plain);
+}
+
 // Convert baud rate integer to termios constant
 static speed_t get_baud_constant(int baud_rate) {
     switch (baud_rate) {
@@ -45,13 +121,8 @@ static speed_t get_baud_constant(int baud_rate) {
     }
 }
 
-SerialBus* serial_bus_open(const SerialBusConfig *config) {
-    if (!config || !config->device_path) {
-        LOG_ERROR(LOG_SYSTEM, "Invalid serial bus configuration");
-        return NULL;
-    }
-
-    SerialBus *bus = malloc(sizeof(SerialBus));
+static SerialBus* serial_bus_open_device(const SerialBusConfig *config) {
+    SerialBus *bus = calloc(1, sizeof(SerialBus));
     if (!bus) {
         LOG_ERROR(LOG_SYSTEM, "Failed to allocate serial bus");
         return NULL;
@@ -62,8 +133,8 @@ SerialBus* serial_bus_open(const SerialBusConfig *config) {
     bus->baud_rate = config->baud_rate;
     bus->timeout_ms = config->timeout_ms;
 
-    // Open serial device
-    bus->fd = open(config->device_path, O_RDWR | O_NOCTTY | O_SYNC);
+    // Open serial device (nonblocking: writes go through the TX thread, reads poll)
+    bus->fd = open(config->device_path, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
     if (bus->fd < 0) {
         LOG_ERROR(LOG_SYSTEM, "Failed to open serial device %s: %s", 
                  config->device_path, strerror(errno));
@@ -113,9 +184,9 @@ SerialBus* serial_bus_open(const SerialBusConfig *config) {
     tty.c_iflag &= ~(IXON | IXOFF | IXANY);         // No software flow control
     tty.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL); // No special handling
 
-    // Set timeout (deciseconds)
+    // Read timeout is applied with poll() in serial_bus_read()
     tty.c_cc[VMIN]  = 0;                            // Non-blocking read
-    tty.c_cc[VTIME] = (config->timeout_ms + 99) / 100; // Convert ms to deciseconds (rounded up)
+    tty.c_cc[VTIME] = 0;
 
     // Apply settings
     if (tcsetattr(bus->fd, TCSANOW, &tty) != 0) {
@@ -128,39 +199,280 @@ SerialBus* serial_bus_open(const SerialBusConfig *config) {
     // Flush any stale data
     tcflush(bus->fd, TCIOFLUSH);
 
+    bus->tx_head = 0;
+    bus->tx_count = 0;
+    bus->tx_stop = false;
+    bus->tx_full_logged = false;
+    memset(&bus->tx_stats, 0, sizeof(bus->tx_stats));
+    if (mtx_init(&bus->tx_mutex, mtx_plain) != thrd_success) {
+        LOG_ERROR(LOG_SYSTEM, "Failed to create serial TX mutex");
+        tcsetattr(bus->fd, TCSANOW, &bus->orig_termios);
+        close(bus->fd);
+        free(bus);
+        return NULL;
+    }
+    if (cnd_init(&bus->tx_cond) != thrd_success) {
+        LOG_ERROR(LOG_SYSTEM, "Failed to create serial TX condition");
+        mtx_destroy(&bus->tx_mutex);
+        tcsetattr(bus->fd, TCSANOW, &bus->orig_termios);
+        close(bus->fd);
+        free(bus);
+        return NULL;
+    }
+    bus->rx_stop_fd = eventfd(0, EFD_CLOEXEC);
+    if (bus->rx_stop_fd < 0 || mtx_init(&bus->rx_mutex, mtx_plain) != thrd_success) {
+        LOG_ERROR(LOG_SYSTEM, "Failed to set up serial RX");
+        if (bus->rx_stop_fd >= 0) close(bus->rx_stop_fd);
+        cnd_destroy(&bus->tx_cond);
+        mtx_destroy(&bus->tx_mutex);
+        tcsetattr(bus->fd, TCSANOW, &bus->orig_termios);
+        close(bus->fd);
+        free(bus);
+        return NULL;
+    }
+    if (thrd_create(&bus->tx_thread, serial_bus_tx_thread, bus) != thrd_success) {
+        LOG_ERROR(LOG_SYSTEM, "Failed to create serial TX thread");
+        mtx_destroy(&bus->rx_mutex);
+        close(bus->rx_stop_fd);
+        cnd_destroy(&bus->tx_cond);
+        mtx_destroy(&bus->tx_mutex);
+        tcsetattr(bus->fd, TCSANOW, &bus->orig_termios);
+        close(bus->fd);
+        free(bus);
+        return NULL;
+    }
+
     LOG_INFO(LOG_SYSTEM, "Serial bus opened: %s @ %d baud (timeout: %d ms)", 
              config->device_path, config->baud_rate, config->timeout_ms);
 
     return bus;
 }
 
+SerialBus* serial_bus_open(const SerialBusConfig *config) {
+    if (!config || !config->device_path) {
+        LOG_ERROR(LOG_SYSTEM, "Invalid serial bus configuration");
+        return NULL;
+    }
+
+    // Symlinks (e.g. /dev/serial/by-id/...) resolve to the same device node
+    char real_path[PATH_MAX];
+    if (!realpath(config->device_path, real_path)) {
+        snprintf(real_path, sizeof(real_path), "%s", config->device_path);
+    }
+
+    call_once(&open_buses_once, open_buses_init);
+    mtx_lock(&open_buses_mutex);
+    for (SerialBus *bus = open_buses; bus; bus = bus->next) {
+        if (strcmp(bus->real_path, real_path) == 0) {
+            bus->refs++;
+            mtx_unlock(&open_buses_mutex);
+            LOG_INFO(LOG_SYSTEM, "Serial bus %s shared (%d users)", bus->device_path, bus->refs);
+            return bus;
+        }
+    }
+
+    SerialBus *bus = serial_bus_open_device(config);
+    if (bus) {
+        snprintf(bus->real_path, sizeof(bus->real_path), "%s", real_path);
+        bus->refs = 1;
+        bus->next = open_buses;
+        open_buses = bus;
+    }
+    mtx_unlock(&open_buses_mutex);
+    return bus;
+}
+
 void serial_bus_close(SerialBus *bus) {
     if (!bus) return;
 
+    mtx_lock(&open_buses_mutex);
+    if (--bus->refs > 0) {
+        mtx_unlock(&open_buses_mutex);
+        return;
+    }
+    for (SerialBus **link = &open_buses; *link; link = &(*link)->next) {
+        if (*link == bus) {
+            *link = bus->next;
+            break;
+        }
+    }
+    mtx_unlock(&open_buses_mutex);
+
+    if (bus->rx_started) {
+        eventfd_write(bus->rx_stop_fd, 1);
+        thrd_join(bus->rx_thread, NULL);
+    }
+
+    // The TX thread sends what is still queued (e.g. a final SHUTDOWN) before exiting
+    mtx_lock(&bus->tx_mutex);
+    bus->tx_stop = true;
+    cnd_signal(&bus->tx_cond);
+    mtx_unlock(&bus->tx_mutex);
+    thrd_join(bus->tx_thread, NULL);
+
     if (bus->fd >= 0) {
         // Restore original terminal settings
         tcsetattr(bus->fd, TCSANOW, &bus->orig_termios);
         close(bus->fd);
-        LOG_INFO(LOG_SYSTEM, "Serial bus closed: %s", bus->device_path);
+        LOG_INFO(LOG_SYSTEM, "Serial bus closed: %s (%u packets in %u writes, %u dropped, queue max %zu bytes)",
+                 bus->device_path, bus->tx_stats.packets_queued, bus->tx_stats.batches,
+                 bus->tx_stats.packets_dropped, bus->tx_stats.max_depth_bytes);
+        if (bus->rx_started) {
+            LOG_INFO(LOG_SYSTEM, "Serial bus RX: %u packets, %u unhandled, %u bad frames, %u overruns",
+                     atomic_load(&bus->rx_packets), atomic_load(&bus->rx_unhandled),
+                     atomic_load(&bus->rx_bad_frames), atomic_load(&bus->rx_overruns));
+        }
     }
 
+    close(bus->rx_stop_fd);
+    mtx_destroy(&bus->rx_mutex);
+    cnd_destroy(&bus->tx_cond);
+    mtx_destroy(&bus->tx_mutex);
     free(bus);
 }
 
+// ---------------------- TX queue ----------------------
+
+static int64_t monotonic_ms(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+// Append to the TX ring. Never blocks on the device: when the ring cannot
+// take the whole buffer nothing is queued and the caller gets -1.
+static int tx_enqueue(SerialBus *bus, const uint8_t *data, size_t len) {
+    mtx_lock(&bus->tx_mutex);
+    if (bus->tx_stop || len > SERIAL_BUS_TX_RING_SIZE - bus->tx_count) {
+        bus->tx_stats.packets_dropped++;
+        bool log = !bus->tx_full_logged && !bus->tx_stop;
+        bus->tx_full_logged = true;
+        mtx_unlock(&bus->tx_mutex);
+        if (log) {
+            LOG_WARN(LOG_SYSTEM, "Serial TX queue full on %s; dropping packets until the device drains",
+                     bus->device_path);
+        }
+        return -1;
+    }
+
+    size_t tail = (bus->tx_head + bus->tx_count) & SERIAL_BUS_TX_RING_MASK;
+    size_t first = SERIAL_BUS_TX_RING_SIZE - tail;
+    if (first > len) first = len;
+    memcpy(&bus->tx_ring[tail], data, first);
+    memcpy(bus->tx_ring, data + first, len - first);
+
+    bool wake = bus->tx_count == 0;
+    bus->tx_count += len;
+    bus->tx_stats.packets_queued++;
+    if (bus->tx_count > bus->tx_stats.max_depth_bytes) {
+        bus->tx_stats.max_depth_bytes = bus->tx_count;
+    }
+    if (wake) cnd_signal(&bus->tx_cond);
+    mtx_unlock(&bus->tx_mutex);
+    return 0;
+}
+
+// One writev() of the queued bytes (two segments when they wrap the ring).
+// Returns bytes written, 0 if the device stayed unwritable, -1 on error.
+static ssize_t tx_write_batch(SerialBus *bus, size_t head, size_t count) {
+    size_t first = SERIAL_BUS_TX_RING_SIZE - head;
+    if (first > count) first = count;
+    struct iovec iov[2] = {
+        { .iov_base = &bus->tx_ring[head], .iov_len = first },
+        { .iov_base = bus->tx_ring, .iov_len = count - first },
+    };
+
+    for (;;) {
+        ssize_t n = writev(bus->fd, iov, count > first ? 2 : 1);
+        if (n >= 0) return n;
+        if (errno == EINTR) continue;
+        if (errno != EAGAIN) return -1;
+
+        struct pollfd pfd = { .fd = bus->fd, .events = POLLOUT };
+        if (poll(&pfd, 1, SERIAL_BUS_TX_POLL_MS) <= 0) return 0;
+    }
+}
+
+static int serial_bus_tx_thread(void *arg) {
+    SerialBus *bus = (SerialBus *)arg;
+    const struct timespec window = { .tv_sec = 0, .tv_nsec = SERIAL_BUS_TX_COALESCE_US * 1000L };
+    int64_t drain_deadline_ms = 0;
+    bool error_logged = false;
+    bool continuing = false;    // Rest of a partially written batch is queued
+
+    // Commands go out with the priority of the gun thread that queues them
+    rt_sched_apply(RT_ROLE_GUN, "sfx-serial-tx");
+
+    mtx_lock(&bus->tx_mutex);
+    for (;;) {
+        while (bus->tx_count == 0 && !bus->tx_stop) {
+            cnd_wait(&bus->tx_cond, &bus->tx_mutex);
+        }
+        if (bus->tx_count == 0) break;  // Stopping and drained
+        if (bus->tx_stop && drain_deadline_ms == 0) {
+            drain_deadline_ms = monotonic_ms() + SERIAL_BUS_TX_DRAIN_MS;
+        }
+        bool stopping = bus->tx_stop;
+        mtx_unlock(&bus->tx_mutex);
+
+        // Let the rest of a burst (servo updates, trigger, heater) queue up behind
+        // the first packet so the whole burst goes out in one write()
+        if (!stopping && !continuing) {
+            thrd_sleep(&window, NULL);
+        }
+
+        mtx_lock(&bus->tx_mutex);
+        size_t head = bus->tx_head;
+        size_t count = bus->tx_count;
+        mtx_unlock(&bus->tx_mutex);
+
+        ssize_t n = tx_write_batch(bus, head, count);
+        if (n < 0 && !error_logged) {
+            LOG_ERROR(LOG_SYSTEM, "Failed to write to serial bus %s: %s", bus->device_path, strerror(errno));
+            error_logged = true;
+        }
+
+        mtx_lock(&bus->tx_mutex);
+        size_t done = n > 0 ? (size_t)n : 0;
+        if (n < 0 || (n == 0 && stopping && monotonic_ms() >= drain_deadline_ms)) {
+            done = count;  // Device gone or still stalled at close: discard the batch
+        }
+        if (n > 0) {
+            bus->tx_stats.batches++;
+            bus->tx_stats.bytes_written += (uint64_t)n;
+            bus->tx_full_logged = false;
+            error_logged = false;
+        }
+        bus->tx_head = (bus->tx_head + done) & SERIAL_BUS_TX_RING_MASK;
+        bus->tx_count -= done;
+        continuing = bus->tx_count > 0 && n > 0;
+    }
+    mtx_unlock(&bus->tx_mutex);
+    return thrd_success;
+}
+
 int serial_bus_write(SerialBus *bus, const void *data, size_t len) {
     if (!bus || bus->fd < 0 || !data) {
         LOG_ERROR(LOG_SYSTEM, "Invalid serial bus or data");
         return -1;
     }
 
-    ssize_t n = write(bus->fd, data, len);
-    if (n < 0) {
-        LOG_ERROR(LOG_SYSTEM, "Failed to write to serial bus: %s", strerror(errno));
+    if (tx_enqueue(bus, (const uint8_t *)data, len) != 0) {
         return -1;
     }
 
-    LOG_DEBUG(LOG_SYSTEM, "Serial TX: %zd bytes", n);
-    return (int)n;
+    LOG_DEBUG(LOG_SYSTEM, "Serial TX: %zu bytes queued", len);
+    return (int)len;
+}
+
+int serial_bus_get_tx_stats(SerialBus *bus, SerialBusTxStats *stats) {
+    if (!bus || !stats) return -1;
+
+    mtx_lock(&bus->tx_mutex);
+    *stats = bus->tx_stats;
+    stats->depth_bytes = bus->tx_count;
+    mtx_unlock(&bus->tx_mutex);
+    return 0;
 }
 
 int serial_bus_write_string(SerialBus *bus, const char *str) {
@@ -201,7 +513,29 @@ int serial_bus_read(SerialBus *bus, void *buffer, size_t max_len) {
         return -1;
     }
 
+    // Once a packet handler is set the RX thread owns the fd
+    mtx_lock(&bus->rx_mutex);
+    bool rx_owned = bus->rx_started;
+    mtx_unlock(&bus->rx_mutex);
+    if (rx_owned) {
+        LOG_ERROR(LOG_SYSTEM, "Serial bus %s is read by its packet handlers", bus->device_path);
+        return -1;
+    }
+
+    struct pollfd pfd = { .fd = bus->fd, .events = POLLIN };
+    int ret = poll(&pfd, 1, bus->timeout_ms);
+    if (ret < 0 && errno != EINTR) {
+        LOG_ERROR(LOG_SYSTEM, "Failed to wait for serial bus: %s", strerror(errno));
+        return -1;
+    }
+    if (ret <= 0) {
+        return 0;  // Timeout
+    }
+
     ssize_t n = read(bus->fd, buffer, max_len);
+    if (n < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return 0;
+    }
     if (n < 0) {
         LOG_ERROR(LOG_SYSTEM, "Failed to read from serial bus: %s", strerror(errno));
         return -1;
@@ -342,8 +676,6 @@ int serial_bus_send_packet(SerialBus *bus, uint8_t type, const uint8_t *payload,
     if (!bus) return -1;
     if (payload_len > 255) return -1;
 
-    // Conservative buffer sizes
-    const size_t max_packet = 2 /*type+len*/ + payload_len + 1 /*crc*/;
     uint8_t packet[2 + 255 + 1];
     size_t idx = 0;
     packet[idx++] = type;
@@ -352,7 +684,8 @@ int serial_bus_send_packet(SerialBus *bus, uint8_t type, const uint8_t *payload,
         memcpy(packet + idx, payload, payload_len);
         idx += payload_len;
     }
-    packet[idx++] = serial_bus_crc8_poly_07(packet, idx);
+    packet[idx] = serial_bus_crc8_poly_07(packet, idx);
+    idx++;
 
     // Worst-case COBS expansion is +length/254 + 1
     uint8_t encoded[2 + 255 + 1 + 2];
@@ -367,89 +700,224 @@ int serial_bus_send_packet(SerialBus *bus, uint8_t type, const uint8_t *payload,
     }
     encoded[enc_len++] = 0x00; // delimiter
 
-    int written = serial_bus_write(bus, encoded, enc_len);
-    if (written < 0) {
-        LOG_ERROR(LOG_SYSTEM, "Serial write failed (type=0x%02X)", type);
+    // One packet is queued whole or not at all; a full queue is reported to
+    // the caller (backpressure) instead of blocking it
+    if (serial_bus_write(bus, encoded, enc_len) < 0) {
+        LOG_DEBUG(LOG_SYSTEM, "Serial packet not queued (type=0x%02X)", type);
+        return -1;
+    }
+    return 0;
+}
+
+// ---------------------- RX path ----------------------
+
+// Check [type][len][payload][crc] and pass it to the type's handler.
+// Returns false if the packet is malformed.
+static bool rx_dispatch(SerialBus *bus, const uint8_t *pkt, size_t len) {
+    if (len < 3 || pkt[1] != len - 3 || serial_bus_crc8_poly_07(pkt, len - 1) != pkt[len - 1]) {
+        return false;
+    }
+
+    mtx_lock(&bus->rx_mutex);
+    SerialBusHandlerEntry entry = bus->handlers[pkt[0]];
+    if (entry.handler) {
+        entry.handler(pkt[0], &pkt[2], pkt[1], entry.user_data);
+        atomic_fetch_add_explicit(&bus->rx_packets, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&bus->rx_unhandled, 1, memory_order_relaxed);
+    }
+    mtx_unlock(&bus->rx_mutex);
+    return true;
+}
+
+// Decode one delimited frame of len bytes at ring index start. A contiguous
+// frame is decoded in place and dispatched straight from the ring. A frame
+// that wraps, or that has firmware debug text (newline-terminated lines)
+// printed in front of it, is copied out and retried after each newline.
+static void rx_frame(SerialBus *bus, size_t start, size_t len) {
+    size_t pos = start & SERIAL_BUS_RX_RING_MASK;
+    uint8_t *frame = &bus->rx_ring[pos];
+
+    if (pos + len <= SERIAL_BUS_RX_RING_SIZE && !memchr(frame, '\n', len)) {
+        size_t pkt_len = serial_bus_cobs_decode(frame, len, frame, len);
+        if (!rx_dispatch(bus, frame, pkt_len)) {
+            atomic_fetch_add_explicit(&bus->rx_bad_frames, 1, memory_order_relaxed);
+        }
+        return;
+    }
+
+    size_t first = SERIAL_BUS_RX_RING_SIZE - pos;
+    if (first > len) first = len;
+    memcpy(bus->rx_scratch, frame, first);
+    memcpy(bus->rx_scratch + first, bus->rx_ring, len - first);
+
+    size_t offset = 0;
+    while (offset < len) {
+        size_t pkt_len = serial_bus_cobs_decode(bus->rx_scratch + offset, len - offset,
+                                                bus->rx_packet, sizeof(bus->rx_packet));
+        if (rx_dispatch(bus, bus->rx_packet, pkt_len)) return;
+
+        const uint8_t *nl = memchr(bus->rx_scratch + offset, '\n', len - offset);
+        if (!nl) break;
+        offset = (size_t)(nl - bus->rx_scratch) + 1;
+    }
+    // A frame that ends in a newline held only text, which is not an error
+    if (offset < len) {
+        atomic_fetch_add_explicit(&bus->rx_bad_frames, 1, memory_order_relaxed);
+    }
+}
+
+// Split buffered bytes on 0x00 delimiters; the scan resumes where it stopped
+static void rx_split(SerialBus *bus) {
+    while (bus->rx_scan != bus->rx_end) {
+        size_t pos = bus->rx_scan & SERIAL_BUS_RX_RING_MASK;
+        size_t run = SERIAL_BUS_RX_RING_SIZE - pos;
+        if (run > bus->rx_end - bus->rx_scan) run = bus->rx_end - bus->rx_scan;
+
+        const uint8_t *delim = memchr(&bus->rx_ring[pos], 0x00, run);
+        if (!delim) {
+            bus->rx_scan += run;
+            continue;
+        }
+        size_t end = bus->rx_scan + (size_t)(delim - &bus->rx_ring[pos]);
+        if (end > bus->rx_start) {
+            rx_frame(bus, bus->rx_start, end - bus->rx_start);
+        }
+        bus->rx_start = bus->rx_scan = end + 1;
+    }
+}
+
+// Read what the device has into the free part of the ring.
+// Returns 0 on success (or nothing to read), -1 on error.
+static int rx_fill(SerialBus *bus) {
+    if (bus->rx_end - bus->rx_start == SERIAL_BUS_RX_RING_SIZE) {
+        // A full ring without a delimiter is not a frame; drop it and resync
+        atomic_fetch_add_explicit(&bus->rx_overruns, 1, memory_order_relaxed);
+        bus->rx_start = bus->rx_scan = bus->rx_end;
+    }
+
+    size_t free_len = SERIAL_BUS_RX_RING_SIZE - (bus->rx_end - bus->rx_start);
+    size_t tail = bus->rx_end & SERIAL_BUS_RX_RING_MASK;
+    size_t first = SERIAL_BUS_RX_RING_SIZE - tail;
+    if (first > free_len) first = free_len;
+    struct iovec iov[2] = {
+        { .iov_base = &bus->rx_ring[tail], .iov_len = first },
+        { .iov_base = bus->rx_ring, .iov_len = free_len - first },
+    };
+
+    ssize_t n = readv(bus->fd, iov, free_len > first ? 2 : 1);
+    if (n < 0) {
+        if (errno == EAGAIN || errno == EINTR) return 0;
+        LOG_ERROR(LOG_SYSTEM, "Failed to read from serial bus %s: %s", bus->device_path, strerror(errno));
         return -1;
     }
+    bus->rx_end += (size_t)n;
+    return 0;
+}
+
+static int serial_bus_rx_thread(void *arg) {
+    SerialBus *bus = (SerialBus *)arg;
+    struct pollfd fds[2] = {
+        { .fd = bus->fd, .events = POLLIN },
+        { .fd = bus->rx_stop_fd, .events = POLLIN },
+    };
+
+    // Pico capture frames are RC inputs; telemetry rides along
+    rt_sched_apply(RT_ROLE_INPUT, "sfx-serial-rx");
+
+    for (;;) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR(LOG_SYSTEM, "Failed to wait for serial bus %s: %s", bus->device_path, strerror(errno));
+            break;
+        }
+        if (fds[1].revents & POLLIN) break;
+        if (fds[0].revents & (POLLERR | POLLHUP | POLLNVAL)) {
+            LOG_ERROR(LOG_SYSTEM, "Serial device %s disconnected", bus->device_path);
+            break;
+        }
+        if (rx_fill(bus) != 0) break;
+        rx_split(bus);
+    }
+    return thrd_success;
+}
+
+int serial_bus_set_handler(SerialBus *bus, uint8_t type, SerialBusPacketHandler handler, void *user_data) {
+    if (!bus) return -1;
+
+    int result = 0;
+    mtx_lock(&bus->rx_mutex);
+    bus->handlers[type] = (SerialBusHandlerEntry){ .handler = handler, .user_data = user_data };
+    if (handler && !bus->rx_started) {
+        if (thrd_create(&bus->rx_thread, serial_bus_rx_thread, bus) == thrd_success) {
+            bus->rx_started = true;
+        } else {
+            LOG_ERROR(LOG_SYSTEM, "Failed to create serial RX thread");
+            bus->handlers[type].handler = NULL;
+            result = -1;
+        }
+    }
+    mtx_unlock(&bus->rx_mutex);
+    return result;
+}
+
+int serial_bus_get_rx_stats(SerialBus *bus, SerialBusRxStats *stats) {
+    if (!bus || !stats) return -1;
+
+    stats->packets = atomic_load_explicit(&bus->rx_packets, memory_order_relaxed);
+    stats->unhandled = atomic_load_explicit(&bus->rx_unhandled, memory_order_relaxed);
+    stats->bad_frames = atomic_load_explicit(&bus->rx_bad_frames, memory_order_relaxed);
+    stats->overruns = atomic_load_explicit(&bus->rx_overruns, memory_order_relaxed);
     return 0;
 }
 
 // ---------------------- USB Device Detection ----------------------
 
+// The tty's device link is the CDC interface; its parent is the USB device
+static bool tty_acm_matches(int index, uint16_t vendor_id, uint16_t product_id) {
+    static const char *const attrs[2] = { "idVendor", "idProduct" };
+    unsigned int ids[2];
+    for (int i = 0; i < 2; i++) {
+        char path[96];
+        snprintf(path, sizeof(path), "/sys/class/tty/ttyACM%d/device/../%s", index, attrs[i]);
+        FILE *fp = fopen(path, "r");
+        if (!fp) return false;
+        int ok = fscanf(fp, "%x", &ids[i]) == 1;
+        fclose(fp);
+        if (!ok) return false;
+    }
+    return ids[0] == vendor_id && ids[1] == product_id;
+}
+
 /**
  * Find and open a USB serial device by VID/PID
- * Searches /sys/bus/usb/devices for matching device and opens its ttyACM port
+ * Checks the USB device behind each /dev/ttyACM* port in sysfs
  */
 SerialBus* serial_bus_open_by_vid_pid(uint16_t vendor_id, uint16_t product_id, SerialBusConfig *config) {
     if (!config) {
         LOG_ERROR(LOG_SYSTEM, "Invalid serial bus configuration");
         return NULL;
     }
-    
-    char vid_pid_str[32];
-    snprintf(vid_pid_str, sizeof(vid_pid_str), "%04x:%04x", vendor_id, product_id);
-    
-    LOG_DEBUG(LOG_SYSTEM, "Searching for USB device %s", vid_pid_str);
-    
-    // Search /sys/bus/usb-serial/devices for matching device
-    FILE *lsusb = popen("lsusb | grep -i \"" XSTR(vendor_id) ":" XSTR(product_id) "\"", "r");
-    if (!lsusb) {
-        // Fallback: manually search /dev for ttyACM devices and check their VID/PID
-        // This is more reliable on some systems
-        for (int i = 0; i < 10; i++) {
-            char device_path[64];
-            snprintf(device_path, sizeof(device_path), "/dev/ttyACM%d", i);
-            
-            // Try to open and see if it's the device we want
-            // For now, just try the first available ttyACM device
-            if (access(device_path, F_OK) == 0) {
-                LOG_INFO(LOG_SYSTEM, "Found potential device: %s", device_path);
-                strncpy((char *)config->device_path, device_path, 255);
-                
-                SerialBus *bus = serial_bus_open(config);
-                if (bus) {
-                    LOG_INFO(LOG_SYSTEM, "Opened USB device %s (VID=%04x, PID=%04x)", 
-                            device_path, vendor_id, product_id);
-                    return bus;
-                }
-            }
-        }
-        
-        LOG_ERROR(LOG_SYSTEM, "USB device %s not found", vid_pid_str);
-        return NULL;
-    }
-    
-    char device_info[256];
-    if (fgets(device_info, sizeof(device_info), lsusb)) {
-        pclose(lsusb);
-        
-        // Extract bus and device number from lsusb output
-        // Format: Bus 001 Device 003: ID 2e8a:0180 ...
-        int bus_num, dev_num;
-        if (sscanf(device_info, "Bus %d Device %d:", &bus_num, &dev_num) == 2) {
-            // Find the corresponding ttyACM device
-            // Try common numbering (usually sequential)
-            for (int i = 0; i < 10; i++) {
-                char device_path[64];
-                snprintf(device_path, sizeof(device_path), "/dev/ttyACM%d", i);
-                
-                if (access(device_path, F_OK) == 0) {
-                    strncpy((char *)config->device_path, device_path, 255);
-                    
-                    SerialBus *bus = serial_bus_open(config);
-                    if (bus) {
-                        LOG_INFO(LOG_SYSTEM, "Opened USB device %s (VID=%04x, PID=%04x)", 
-                                device_path, vendor_id, product_id);
-                        return bus;
-                    }
-                }
-            }
+
+    LOG_DEBUG(LOG_SYSTEM, "Searching for USB device %04x:%04x", vendor_id, product_id);
+
+    for (int i = 0; i < SERIAL_BUS_ACM_SCAN; i++) {
+        if (!tty_acm_matches(i, vendor_id, product_id)) continue;
+
+        char device_path[32];
+        snprintf(device_path, sizeof(device_path), "/dev/ttyACM%d", i);
+        SerialBusConfig found = *config;
+        found.device_path = device_path;
+
+        SerialBus *bus = serial_bus_open(&found);
+        if (bus) {
+            config->device_path = bus->device_path;
+            LOG_INFO(LOG_SYSTEM, "Opened USB device %s (VID=%04x, PID=%04x)",
+                     device_path, vendor_id, product_id);
+            return bus;
         }
-    } else {
-        pclose(lsusb);
     }
-    
-    LOG_ERROR(LOG_SYSTEM, "USB device %s not found", vid_pid_str);
+
+    LOG_ERROR(LOG_SYSTEM, "USB device %04x:%04x not found", vendor_id, product_id);
     return NULL;
 }
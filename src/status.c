@@ -2,6 +2,7 @@
 #include "gun_fx.h"
 #include "engine_fx.h"
 #include "gpio.h"
+#include "serial_bus.h"
 #include "logging.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -20,6 +21,8 @@
 #define COLOR_MAGENTA "\033[35m"
 #define COLOR_BLUE    "\033[34m"
 
+#define STATUS_TELEMETRY_STALE_MS 3000   // The Pico sends STATUS about once a second
+
 struct StatusDisplay {
     GunFX *gun;
     EngineFX *engine;
@@ -52,6 +55,33 @@ static const char* bool_color(bool state) {
     return state ? COLOR_GREEN : COLOR_RED;
 }
 
+// Format the input source column: GPIO pin, or serial receiver channel
+static const char* format_input(int pin, char *buf, size_t size) {
+    if (pin < 0) {
+        snprintf(buf, size, "RX");
+    } else {
+        snprintf(buf, size, "GPIO %2d", pin);
+    }
+    return buf;
+}
+
+// Print signal health for one input and end the line
+static void print_health(bool available, const PWMHealth *health) {
+    if (!available) {
+        printf("\n");
+        return;
+    }
+    
+    const char *color = health->state == PWM_SIGNAL_OK ? COLOR_GREEN : COLOR_RED;
+    printf("  %5.1f Hz  jit %3d µs  rej %-4u %s[%s]" COLOR_RESET,
+           health->frame_rate_hz, health->jitter_us, health->rejected_pulses,
+           color, pwm_signal_state_to_string(health->state));
+    if (health->state == PWM_SIGNAL_FAILSAFE) {
+        printf(" %d ms", health->ms_since_last_pulse);
+    }
+    printf("\n");
+}
+
 // Print engine status
 static void print_engine_status(EngineFX *engine) {
     if (!engine) return;
@@ -104,7 +134,35 @@ static void print_gun_status(GunFX *gun) {
     printf(COLOR_BOLD "Firing:" COLOR_RESET " %s%-4s" COLOR_RESET "  │  ", 
            bool_color(is_firing), is_firing ? "YES" : "NO");
     printf(COLOR_BOLD "Rate:" COLOR_RESET " %d  │  ", rate_index >= 0 ? rate_index + 1 : 0);
-    printf(COLOR_BOLD "RPM:" COLOR_RESET " %-4d\n", rpm);
+    printf(COLOR_BOLD "RPM:" COLOR_RESET " %-4d", rpm);
+    if (gun_fx_in_failsafe(gun)) {
+        printf("  │  " COLOR_RED COLOR_BOLD "INPUT FAILSAFE" COLOR_RESET);
+    }
+    printf("\n");
+    
+    SerialBusTxStats link;
+    if (gun_fx_get_link_stats(gun, &link)) {
+        printf(COLOR_BOLD "Pico Link:" COLOR_RESET " queue %zu B (max %zu)  │  %u packets in %u writes  │  %s%u dropped" COLOR_RESET "\n",
+               link.depth_bytes, link.max_depth_bytes, link.packets_queued, link.batches,
+               link.packets_dropped ? COLOR_RED : "", link.packets_dropped);
+    }
+    
+    GunFXTelemetry pico;
+    if (gun_fx_get_telemetry(gun, &pico)) {
+        const char *name = gun_fx_get_module_name(gun);
+        printf(COLOR_BOLD "Pico:" COLOR_RESET " %s%s%s%s%s  │  Servos %d/%d/%d µs  │  RPM %d",
+               name ? name : "?",
+               pico.firing ? "  FIRING" : "", pico.heater_on ? "  HEATER" : "",
+               pico.fan_on ? "  FAN" : "", pico.flash_active ? "  FLASH" : "",
+               pico.servo_us[0], pico.servo_us[1], pico.servo_us[2], pico.rate_of_fire_rpm);
+        if (pico.fan_spindown) {
+            printf("  │  fan off in %.1fs", pico.fan_off_remaining_ms / 1000.0);
+        }
+        if (pico.age_ms > STATUS_TELEMETRY_STALE_MS) {
+            printf("  │  " COLOR_RED "no status for %ds" COLOR_RESET, pico.age_ms / 1000);
+        }
+        printf("\n");
+    }
     
     // Display recoil jerk settings if any are configured
     if (pitch_jerk > 0 || yaw_jerk > 0) {
@@ -122,6 +180,8 @@ static void print_gun_status(GunFX *gun) {
 // Print PWM inputs
 static void print_pwm_inputs(GunFX *gun, EngineFX *engine) {
     char pwm_buf[16];
+    char pin_buf[16];
+    PWMHealth health;
     
     printf(COLOR_CYAN "═══════════════════════════════════════════════════════════════════════════\n" COLOR_RESET);
     printf(COLOR_MAGENTA COLOR_BOLD "📡 PWM INPUTS\n" COLOR_RESET);
@@ -130,20 +190,27 @@ static void print_pwm_inputs(GunFX *gun, EngineFX *engine) {
     if (engine) {
         int engine_pwm = engine_fx_get_toggle_pwm(engine);
         int engine_pin = engine_fx_get_toggle_pin(engine);
-        printf("  • Engine Toggle:     GPIO %2d  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs\n",
-               engine_pin,
+        printf("  • Engine Toggle:     %-7s  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs",
+               format_input(engine_pin, pin_buf, sizeof(pin_buf)),
                pwm_color(engine_pwm),
                format_pwm(engine_pwm, pwm_buf, sizeof(pwm_buf)));
+        print_health(engine_fx_get_toggle_health(engine, &health), &health);
+        
+        float rotor_rpm = engine_fx_get_rotor_rpm(engine);
+        if (rotor_rpm >= 0.0f) {
+            printf("  • Rotor Speed:       %.0f RPM\n", rotor_rpm);
+        }
     }
     
     // Gun trigger
     if (gun) {
         int trigger_pwm = gun_fx_get_trigger_pwm(gun);
         int trigger_pin = gun_fx_get_trigger_pin(gun);
-        printf("  • Gun Trigger:       GPIO %2d  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs\n",
-               trigger_pin,
+        printf("  • Gun Trigger:       %-7s  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs",
+               format_input(trigger_pin, pin_buf, sizeof(pin_buf)),
                pwm_color(trigger_pwm),
                format_pwm(trigger_pwm, pwm_buf, sizeof(pwm_buf)));
+        print_health(gun_fx_get_trigger_health(gun, &health), &health);
     }
     
     // Smoke heater toggle
@@ -151,35 +218,36 @@ static void print_pwm_inputs(GunFX *gun, EngineFX *engine) {
         int heater_pwm = gun_fx_get_heater_toggle_pwm(gun);
         int heater_pin = gun_fx_get_heater_toggle_pin(gun);
         bool heater_on = gun_fx_get_heater_state(gun);
-        printf("  • Smoke Heater Tog:  GPIO %2d  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs  [%s%-4s" COLOR_RESET "]\n",
-               heater_pin,
+        printf("  • Smoke Heater Tog:  %-7s  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs  [%s%-4s" COLOR_RESET "]",
+               format_input(heater_pin, pin_buf, sizeof(pin_buf)),
                pwm_color(heater_pwm),
                format_pwm(heater_pwm, pwm_buf, sizeof(pwm_buf)),
                bool_color(heater_on),
                heater_on ? "ON" : "OFF");
+        print_health(gun_fx_get_heater_toggle_health(gun, &health), &health);
     }
     
     // Servo inputs
     if (gun) {
-        Servo *pitch_servo = gun_fx_get_pitch_servo(gun);
-        Servo *yaw_servo = gun_fx_get_yaw_servo(gun);
+        int pitch_pin = gun_fx_get_pitch_pin(gun);
+        int yaw_pin = gun_fx_get_yaw_pin(gun);
         
-        if (pitch_servo) {
+        if (gun_fx_get_pitch_health(gun, &health)) {
             int pitch_pwm = gun_fx_get_pitch_pwm(gun);
-            int pitch_pin = gun_fx_get_pitch_pin(gun);
-            printf("  • Pitch Servo Input: GPIO %2d  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs\n",
-                   pitch_pin,
+            printf("  • Pitch Servo Input: %-7s  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs",
+                   format_input(pitch_pin, pin_buf, sizeof(pin_buf)),
                    pwm_color(pitch_pwm),
                    format_pwm(pitch_pwm, pwm_buf, sizeof(pwm_buf)));
+            print_health(gun_fx_get_pitch_health(gun, &health), &health);
         }
         
-        if (yaw_servo) {
+        if (gun_fx_get_yaw_health(gun, &health)) {
             int yaw_pwm = gun_fx_get_yaw_pwm(gun);
-            int yaw_pin = gun_fx_get_yaw_pin(gun);
-            printf("  • Yaw Servo Input:   GPIO %2d  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs\n",
-                   yaw_pin,
+            printf("  • Yaw Servo Input:   %-7s  " COLOR_BOLD "→" COLOR_RESET "  %s%-6s" COLOR_RESET " µs",
+                   format_input(yaw_pin, pin_buf, sizeof(pin_buf)),
                    pwm_color(yaw_pwm),
                    format_pwm(yaw_pwm, pwm_buf, sizeof(pwm_buf)));
+            print_health(gun_fx_get_yaw_health(gun, &health), &health);
         }
     }
 }
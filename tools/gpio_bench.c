@@ -0,0 +1,630 @@
+/**
+ * @file gpio_bench.c
+ * @brief PWM input jitter, latency and CPU benchmark
+ *
+ * Drives every input channel from a gpio-sim chip (live kernel edges) or from
+ * an edge trace (recorded, or synthesised at the requested rate) and measures,
+ * relative to each edge timestamp:
+ *   - edge -> process_pwm_event()   (gpio.c built with -DGPIO_BENCH)
+ *   - edge -> pulse callback
+ *   - edge -> visible through pwm_monitor_get_average()
+ *   - edge -> FX decision (event fd wake-up + average read, as in the FX threads)
+ * plus the CPU time of the monitoring thread per channel.
+ *
+ * Pulse widths step by --step-us every --step-ms so the averaged value crosses
+ * the change threshold and FX decisions are exercised.
+ *
+ * --mode average instead times pwm_monitor_get_average() (seqlock read of the
+ * running sum) against the former full ring scan, per call, on one virtual
+ * monitor fed at --rate. No input source is used.
+ *
+ * Usage: gpio_bench [--mode latency|average] [--source sim|trace] [--trace FILE]
+ *                   [--channels N] [--rate HZ] [--jitter US] [--seconds S]
+ *                   [--step-us US] [--step-ms MS] [--poll-us US] [--realtime PRIO]
+ *                   [--cpus LIST]
+ * The sim source needs root and the gpio-sim module; the trace source runs anywhere.
+ */
+
+#include "gpio.h"
+#include "gpio_sim.h"
+#include "config_loader.h"
+#include "logging.h"
+#include "rt_sched.h"
+#include <dirent.h>
+#include <errno.h>
+#include <poll.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <threads.h>
+#include <unistd.h>
+
+#ifndef GPIO_BENCH
+#error "gpio_bench needs gpio.c built with -DGPIO_BENCH (make bench-gpio)"
+#endif
+
+#define BENCH_MAX_SAMPLES 262144
+#define AVG_BENCH_CHUNK   20000     // get_average calls timed between window refreshes
+
+typedef enum {
+    STAGE_PROCESS = 0,
+    STAGE_CALLBACK,
+    STAGE_VISIBLE,
+    STAGE_DECISION,
+    STAGE_COUNT
+} BenchStage;
+
+static const char *stage_names[STAGE_COUNT] = {
+    "edge -> process_pwm_event",
+    "edge -> callback",
+    "edge -> get_average visible",
+    "edge -> FX decision",
+};
+
+// Each stage has a single writer thread; results are read after it has stopped
+typedef struct {
+    int64_t samples_ns[BENCH_MAX_SAMPLES];
+    int count;
+} StageSamples;
+
+static StageSamples stages[STAGE_COUNT];
+
+static GPIOSimLine lines[GPIO_SIM_MAX_CHANNELS];
+static PWMMonitor *monitors[GPIO_SIM_MAX_CHANNELS];
+static int num_channels = 8;
+static int rate_hz = 50;
+static int jitter_us = 5;
+static int seconds = 10;
+static int step_us = 400;
+static int step_ms = 250;
+static int poll_us = 20;
+static bool use_sim = true;
+static bool average_mode = false;
+static const char *trace_path = nullptr;
+static int rt_priority = 0;
+static char *rt_cpus = nullptr;
+
+static atomic_bool measuring = false;
+static int decisions_high = 0;
+
+static void stage_add(BenchStage stage, int64_t latency_ns) {
+    StageSamples *s = &stages[stage];
+    if (s->count < BENCH_MAX_SAMPLES) {
+        s->samples_ns[s->count++] = latency_ns;
+    }
+}
+
+// ============================================================================
+// MEASUREMENT POINTS
+// ============================================================================
+
+// Monitoring / replay thread, as each edge enters decoding
+static void on_edge(int pin, uint64_t edge_ns, int64_t now_ns) {
+    (void)pin;
+    if (atomic_load_explicit(&measuring, memory_order_relaxed)) {
+        stage_add(STAGE_PROCESS, now_ns - (int64_t)edge_ns);
+    }
+}
+
+// Monitoring / replay thread, for every decoded pulse
+static void on_pulse(PWMReading reading, void *user_data) {
+    (void)user_data;
+    if (atomic_load_explicit(&measuring, memory_order_relaxed)) {
+        stage_add(STAGE_CALLBACK, gpio_sim_now_ns() - reading.timestamp_ns);
+    }
+}
+
+// Polls every channel's average and records when a new pulse becomes visible
+static int visibility_thread(void *arg) {
+    (void)arg;
+    int64_t last_seen[GPIO_SIM_MAX_CHANNELS] = {0};
+
+    while (atomic_load(&measuring)) {
+        for (int i = 0; i < num_channels; i++) {
+            int avg;
+            int64_t newest_ns;
+            if (pwm_monitor_get_average_ts(monitors[i], &avg, &newest_ns) && newest_ns != last_seen[i]) {
+                if (last_seen[i] != 0) {
+                    stage_add(STAGE_VISIBLE, gpio_sim_now_ns() - newest_ns);
+                }
+                last_seen[i] = newest_ns;
+            }
+        }
+        if (poll_us > 0) {
+            gpio_sim_sleep_until(gpio_sim_now_ns() + (int64_t)poll_us * 1000);
+        }
+    }
+    return 0;
+}
+
+// Same pattern as the FX processing threads: block on the change event fds,
+// then read the averages and decide
+static int decision_thread(void *arg) {
+    (void)arg;
+    struct pollfd fds[GPIO_SIM_MAX_CHANNELS];
+    for (int i = 0; i < num_channels; i++) {
+        fds[i] = (struct pollfd){ .fd = pwm_monitor_get_event_fd(monitors[i]), .events = POLLIN };
+    }
+
+    while (atomic_load(&measuring)) {
+        if (poll(fds, (nfds_t)num_channels, 100) <= 0) continue;
+
+        for (int i = 0; i < num_channels; i++) {
+            if (!(fds[i].revents & POLLIN)) continue;
+            pwm_monitor_clear_event(monitors[i]);
+
+            int avg;
+            int64_t newest_ns;
+            if (pwm_monitor_get_average_ts(monitors[i], &avg, &newest_ns)) {
+                int64_t now = gpio_sim_now_ns();
+                decisions_high += avg > lines[i].nominal_us + step_us / 2 ? 1 : 0;
+                stage_add(STAGE_DECISION, now - newest_ns);
+            }
+        }
+    }
+    return 0;
+}
+
+// ============================================================================
+// CPU ACCOUNTING
+// ============================================================================
+
+// Find the monitoring thread by name and return its time on CPU (schedstat, ns)
+static int64_t monitor_thread_cpu_ns(void) {
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir) return -1;
+
+    int64_t cpu_ns = -1;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL && cpu_ns < 0) {
+        if (entry->d_name[0] == '.') continue;
+
+        char path[300];
+        char comm[32] = "";
+        snprintf(path, sizeof(path), "/proc/self/task/%s/comm", entry->d_name);
+        FILE *f = fopen(path, "r");
+        if (!f) continue;
+        bool ok = fgets(comm, sizeof(comm), f) != NULL;
+        fclose(f);
+        if (!ok || strncmp(comm, "sfx-pwm", 7) != 0) continue;
+
+        snprintf(path, sizeof(path), "/proc/self/task/%s/schedstat", entry->d_name);
+        f = fopen(path, "r");
+        if (!f) continue;
+        long long runtime;
+        if (fscanf(f, "%lld", &runtime) == 1) {
+            cpu_ns = runtime;
+        }
+        fclose(f);
+    }
+    closedir(dir);
+    return cpu_ns;
+}
+
+// ============================================================================
+// INPUT SOURCES
+// ============================================================================
+
+static void channel_setup(void) {
+    for (int i = 0; i < num_channels; i++) {
+        lines[i].pin = channel_to_gpio(i + 1);
+        lines[i].nominal_us = 1100 + i * 100;
+        lines[i].pull_fd = -1;
+    }
+}
+
+// Write an edge trace with the same frames the gpio-sim generator would produce
+static int trace_synthesise(const char *path, GPIOSimGenerator *gen, int duration_s) {
+    FILE *file = fopen(path, "wb");
+    if (!file) {
+        fprintf(stderr, "Cannot create %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    fwrite(GPIO_TRACE_MAGIC, GPIO_TRACE_MAGIC_LEN, 1, file);
+
+    int64_t period_ns = 1000000000LL / gen->rate_hz;
+    int64_t frames = (int64_t)duration_s * gen->rate_hz;
+    int widths[GPIO_SIM_MAX_CHANNELS];
+    int order[GPIO_SIM_MAX_CHANNELS];
+    uint8_t record[GPIO_TRACE_RECORD_SIZE];
+
+    for (int64_t frame = 0; frame < frames; frame++) {
+        uint64_t frame_ns = 1000000000ULL + (uint64_t)(frame * period_ns);
+        gpio_sim_frame_widths(gen, frame, widths, order);
+
+        for (int i = 0; i < 2 * gen->count; i++) {
+            bool rising = i < gen->count;
+            int line = rising ? i : order[i - gen->count];
+            uint64_t ns = rising ? frame_ns : frame_ns + (uint64_t)widths[line] * 1000;
+            uint16_t offset = (uint16_t)gen->lines[line].pin;
+            memcpy(record, &ns, sizeof(ns));
+            memcpy(record + 8, &offset, sizeof(offset));
+            record[10] = rising ? 1 : 0;
+            fwrite(record, sizeof(record), 1, file);
+        }
+    }
+    return fclose(file) == 0 ? 0 : -1;
+}
+
+// Use the line offsets present in a recorded trace as the benchmark channels
+static int trace_scan_pins(const char *path) {
+    FILE *file = fopen(path, "rb");
+    char magic[GPIO_TRACE_MAGIC_LEN];
+    bool v1 = false;
+    if (file && fread(magic, sizeof(magic), 1, file) == 1) {
+        v1 = memcmp(magic, GPIO_TRACE_MAGIC_V1, GPIO_TRACE_MAGIC_LEN) == 0;
+    }
+    if (!file || (!v1 && memcmp(magic, GPIO_TRACE_MAGIC, GPIO_TRACE_MAGIC_LEN) != 0)) {
+        fprintf(stderr, "%s is not an edge trace\n", path);
+        if (file) fclose(file);
+        return -1;
+    }
+
+    uint8_t record[GPIO_TRACE_RECORD_SIZE];
+    size_t record_size = v1 ? GPIO_TRACE_RECORD_SIZE_V1 : GPIO_TRACE_RECORD_SIZE;
+    num_channels = 0;
+    while (fread(record, record_size, 1, file) == 1 && num_channels < GPIO_SIM_MAX_CHANNELS) {
+        uint16_t offset = record[8];
+        if (!v1) {
+            memcpy(&offset, record + 8, sizeof(offset));
+        }
+        bool known = false;
+        for (int i = 0; i < num_channels; i++) {
+            known |= lines[i].pin == offset;
+        }
+        if (!known) {
+            lines[num_channels].pin = offset;
+            lines[num_channels].nominal_us = 1500;
+            lines[num_channels].pull_fd = -1;
+            num_channels++;
+        }
+    }
+    fclose(file);
+    return num_channels > 0 ? 0 : -1;
+}
+
+// ============================================================================
+// AVERAGE READ COST
+// ============================================================================
+
+// pwm_monitor_get_average() before the seqlock: every call scanned all ring
+// slots and aged them against a fresh CLOCK_MONOTONIC read. Kept here only
+// as the baseline for --mode average.
+#define OLD_AVG_MAX_SAMPLES 128
+
+typedef struct {
+    atomic_int avg_window_ms;
+    struct {
+        atomic_int duration_us;
+        struct timespec ts;
+    } samples[OLD_AVG_MAX_SAMPLES];
+    atomic_int sample_head;
+} OldAverageRing;
+
+static void old_average_push(OldAverageRing *ring, int duration_us, int64_t ts_ns) {
+    int head = atomic_load(&ring->sample_head);
+    ring->samples[head].ts.tv_sec = ts_ns / 1000000000LL;
+    ring->samples[head].ts.tv_nsec = ts_ns % 1000000000LL;
+    atomic_store(&ring->samples[head].duration_us, duration_us);
+    atomic_store(&ring->sample_head, (head + 1) % OLD_AVG_MAX_SAMPLES);
+}
+
+static bool old_average_get(OldAverageRing *ring, int *avg_us) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    long long window_ns = (long long)atomic_load(&ring->avg_window_ms) * 1000000LL;
+    long long sum = 0;
+    int count = 0;
+
+    for (int i = 0; i < OLD_AVG_MAX_SAMPLES; i++) {
+        struct timespec ts = ring->samples[i].ts;
+        if (ts.tv_sec == 0 && ts.tv_nsec == 0) continue;
+        long long age_ns = ((long long)(now.tv_sec - ts.tv_sec) * 1000000000LL) + (now.tv_nsec - ts.tv_nsec);
+        if (age_ns >= 0 && age_ns <= window_ns) {
+            sum += atomic_load(&ring->samples[i].duration_us);
+            count++;
+        }
+    }
+
+    if (count == 0) {
+        return false;
+    }
+    *avg_us = (int)(sum / count);
+    return true;
+}
+
+typedef struct {
+    int64_t chunks;
+    int64_t calls;
+    int64_t valid;           // Calls that returned an average
+    int64_t total_ns;
+    double best_ns_per_call;
+} AverageBenchResult;
+
+// Feed both implementations the pulses due up to now, so the window stays
+// current while calls are timed (not part of the measured time)
+static void average_bench_feed(OldAverageRing *ring, PWMMonitor *monitor, int64_t *next_ns, int64_t period_ns) {
+    int64_t now = gpio_sim_now_ns();
+    while (*next_ns <= now) {
+        old_average_push(ring, 1500, *next_ns);
+        pwm_monitor_inject_pulse(monitor, 1500, *next_ns);
+        *next_ns += period_ns;
+    }
+}
+
+static void average_bench_run(bool seqlock, OldAverageRing *ring, PWMMonitor *monitor,
+                              int64_t *next_ns, int64_t period_ns, AverageBenchResult *result) {
+    memset(result, 0, sizeof(*result));
+    result->best_ns_per_call = 1e12;
+    int64_t end = gpio_sim_now_ns() + (int64_t)seconds * 1000000000LL;
+    volatile int sink = 0;
+
+    while (gpio_sim_now_ns() < end) {
+        average_bench_feed(ring, monitor, next_ns, period_ns);
+
+        int valid = 0;
+        int64_t start = gpio_sim_now_ns();
+        for (int i = 0; i < AVG_BENCH_CHUNK; i++) {
+            int avg;
+            if (seqlock ? pwm_monitor_get_average(monitor, &avg) : old_average_get(ring, &avg)) {
+                sink = avg;
+                valid++;
+            }
+        }
+        int64_t elapsed = gpio_sim_now_ns() - start;
+
+        result->chunks++;
+        result->calls += AVG_BENCH_CHUNK;
+        result->valid += valid;
+        result->total_ns += elapsed;
+        double per_call = (double)elapsed / AVG_BENCH_CHUNK;
+        if (per_call < result->best_ns_per_call) {
+            result->best_ns_per_call = per_call;
+        }
+    }
+    (void)sink;
+}
+
+// Per-call cost of reading a channel average, old scan vs seqlock
+static int run_average_bench(void) {
+    int64_t period_ns = 1000000000LL / rate_hz;
+    printf("PWM average read benchmark: %d Hz pulses, %d calls per timed chunk, %d s per implementation\n",
+           rate_hz, AVG_BENCH_CHUNK, seconds);
+
+    // Replay mode only so gpio_init() opens no chip; the virtual monitor
+    // never starts the replay thread
+    if (gpio_trace_set_replay("/dev/null", false, false) != 0 || gpio_init(nullptr) != 0) {
+        return 2;
+    }
+    PWMMonitor *monitor = pwm_monitor_create_virtual("bench", nullptr, nullptr);
+    if (!monitor || pwm_monitor_start(monitor) != 0) {
+        pwm_monitor_destroy(monitor);
+        gpio_cleanup();
+        return 2;
+    }
+
+    // Start with a full old ring (as after a few seconds of input) and a full window
+    static OldAverageRing ring;
+    atomic_init(&ring.avg_window_ms, 200);
+    int64_t next_ns = gpio_sim_now_ns() - OLD_AVG_MAX_SAMPLES * period_ns;
+    average_bench_feed(&ring, monitor, &next_ns, period_ns);
+
+    AverageBenchResult results[2];
+    average_bench_run(false, &ring, monitor, &next_ns, period_ns, &results[0]);
+    average_bench_run(true, &ring, monitor, &next_ns, period_ns, &results[1]);
+
+    static const char *names[2] = { "old scan (128 slots)", "seqlock running sum" };
+    printf("\n  %-22s %12s %10s %12s %12s\n", "implementation", "calls", "valid", "mean ns", "best ns");
+    for (int i = 0; i < 2; i++) {
+        printf("  %-22s %12lld %9.1f%% %12.1f %12.1f\n", names[i], (long long)results[i].calls,
+               results[i].calls > 0 ? 100.0 * (double)results[i].valid / (double)results[i].calls : 0.0,
+               results[i].calls > 0 ? (double)results[i].total_ns / (double)results[i].calls : 0.0,
+               results[i].best_ns_per_call);
+    }
+
+    pwm_monitor_stop(monitor);
+    pwm_monitor_destroy(monitor);
+    gpio_cleanup();
+    return 0;
+}
+
+// ============================================================================
+// REPORT
+// ============================================================================
+
+static int compare_i64(const void *a, const void *b) {
+    int64_t x = *(const int64_t *)a, y = *(const int64_t *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentile_us(const int64_t *sorted, int count, double p) {
+    if (count == 0) return 0.0;
+    int idx = (int)(p * (count - 1));
+    return (double)sorted[idx] / 1000.0;
+}
+
+static void print_report(int64_t cpu_ns, double wall_s) {
+    printf("\n  %-28s %8s %9s %9s %9s %9s %9s  (µs)\n", "stage", "samples", "min", "p50", "p90", "p99", "max");
+    for (int s = 0; s < STAGE_COUNT; s++) {
+        StageSamples *st = &stages[s];
+        qsort(st->samples_ns, (size_t)st->count, sizeof(st->samples_ns[0]), compare_i64);
+        printf("  %-28s %8d %9.1f %9.1f %9.1f %9.1f %9.1f\n", stage_names[s], st->count,
+               percentile_us(st->samples_ns, st->count, 0.0),
+               percentile_us(st->samples_ns, st->count, 0.50),
+               percentile_us(st->samples_ns, st->count, 0.90),
+               percentile_us(st->samples_ns, st->count, 0.99),
+               percentile_us(st->samples_ns, st->count, 1.0));
+    }
+    if (poll_us > 0) {
+        printf("  (visibility includes up to %d µs of polling interval)\n", poll_us);
+    }
+
+    if (cpu_ns < 0) {
+        printf("\nMonitoring thread CPU: unavailable (no /proc schedstat)\n");
+        return;
+    }
+    int edges = stages[STAGE_PROCESS].count;
+    double cpu_pct = 100.0 * (double)cpu_ns / (wall_s * 1e9);
+    printf("\nMonitoring thread CPU: %.1f ms in %.1f s = %.3f%% (%.3f%% per channel, %.0f ns per edge)\n",
+           (double)cpu_ns / 1e6, wall_s, cpu_pct, cpu_pct / num_channels,
+           edges > 0 ? (double)cpu_ns / edges : 0.0);
+}
+
+// ============================================================================
+// MAIN
+// ============================================================================
+
+static void parse_args(int argc, char *argv[]) {
+    for (int i = 1; i < argc; i++) {
+        bool has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--mode") == 0 && has_value) average_mode = strcmp(argv[++i], "average") == 0;
+        else if (strcmp(argv[i], "--source") == 0 && has_value) use_sim = strcmp(argv[++i], "trace") != 0;
+        else if (strcmp(argv[i], "--trace") == 0 && has_value) { trace_path = argv[++i]; use_sim = false; }
+        else if (strcmp(argv[i], "--channels") == 0 && has_value) num_channels = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--rate") == 0 && has_value) rate_hz = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--jitter") == 0 && has_value) jitter_us = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seconds") == 0 && has_value) seconds = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--step-us") == 0 && has_value) step_us = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--step-ms") == 0 && has_value) step_ms = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--poll-us") == 0 && has_value) poll_us = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--realtime") == 0 && has_value) rt_priority = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--cpus") == 0 && has_value) rt_cpus = argv[++i];
+        else {
+            fprintf(stderr, "Usage: %s [--mode latency|average] [--source sim|trace] [--trace FILE] [--channels 1-%d] [--rate HZ] "
+                    "[--jitter US] [--seconds S] [--step-us US] [--step-ms MS] [--poll-us US] "
+                    "[--realtime 1-99] [--cpus LIST]\n", argv[0], GPIO_SIM_MAX_CHANNELS);
+            exit(2);
+        }
+    }
+    if (num_channels < 1) num_channels = 1;
+    if (num_channels > GPIO_SIM_MAX_CHANNELS) num_channels = GPIO_SIM_MAX_CHANNELS;
+    if (rate_hz < 1 || rate_hz > 400) rate_hz = 50;
+    if (seconds < 1) seconds = 1;
+    if (poll_us < 0) poll_us = 0;
+    if (rt_priority < 0 || rt_priority > 99) rt_priority = 0;
+}
+
+int main(int argc, char *argv[]) {
+    parse_args(argc, argv);
+    logging_init(NULL, 0, 0);
+    if (average_mode) {
+        int result = run_average_bench();
+        logging_shutdown();
+        return result;
+    }
+    channel_setup();
+
+    GPIOSimGenerator generator = {
+        .lines = lines,
+        .count = num_channels,
+        .rate_hz = rate_hz,
+        .jitter_us = jitter_us,
+        .step_us = step_us,
+        .step_ms = step_ms,
+    };
+    RealtimeConfig rt_config = {
+        .lock_memory = rt_priority > 0,
+        .input = { .policy = rt_priority > 0 ? "fifo" : nullptr, .priority = rt_priority, .cpus = rt_cpus },
+    };
+
+    char dev_path[128] = "";
+    char sysfs_dir[192];
+    char synth_path[64] = "";
+    int exit_code = 2;
+
+    if (use_sim) {
+        if (gpio_sim_chip_create(dev_path, sizeof(dev_path), sysfs_dir, sizeof(sysfs_dir)) != 0) {
+            return 2;
+        }
+    } else if (trace_path) {
+        if (trace_scan_pins(trace_path) != 0) {
+            return 2;
+        }
+        generator.count = num_channels;
+    } else {
+        // Cover the warm-up second plus a spare one so replay never runs dry
+        snprintf(synth_path, sizeof(synth_path), "/tmp/sfxhub-bench-%d.trace", (int)getpid());
+        if (trace_synthesise(synth_path, &generator, seconds + 2) != 0) {
+            return 2;
+        }
+        trace_path = synth_path;
+    }
+
+    printf("PWM input benchmark: %s, %d channels, %d Hz, ±%d µs jitter, %+d µs step every %d ms, %d s, %s\n",
+           use_sim ? dev_path : trace_path, num_channels, rate_hz, jitter_us, step_us, step_ms, seconds,
+           rt_priority > 0 ? "SCHED_FIFO" : "CFS");
+
+    if (rt_sched_init(&rt_config) != 0) {
+        goto out_source;
+    }
+    if (!use_sim) {
+        gpio_trace_set_replay(trace_path, true, false);
+    }
+    if (gpio_init(use_sim ? dev_path : nullptr) != 0) {
+        goto out_source;
+    }
+    gpio_bench_set_edge_hook(on_edge);
+
+    for (int i = 0; i < num_channels; i++) {
+        if (use_sim && gpio_sim_line_open(&lines[i], sysfs_dir) != 0) {
+            goto out_gpio;
+        }
+        monitors[i] = pwm_monitor_create_with_name(lines[i].pin, "bench", on_pulse, nullptr);
+        if (!monitors[i] || pwm_monitor_start(monitors[i]) != 0) {
+            goto out_gpio;
+        }
+    }
+
+    if (use_sim && gpio_sim_generator_start(&generator) != 0) {
+        goto out_gpio;
+    }
+
+    // Let the averaging windows fill before measuring
+    sleep(1);
+    thrd_t visibility, decision;
+    atomic_store(&measuring, true);
+    int64_t cpu_start = monitor_thread_cpu_ns();
+    int64_t wall_start = gpio_sim_now_ns();
+    if (thrd_create(&visibility, visibility_thread, nullptr) != thrd_success ||
+        thrd_create(&decision, decision_thread, nullptr) != thrd_success) {
+        atomic_store(&measuring, false);
+        goto out_generator;
+    }
+
+    sleep((unsigned int)seconds);
+
+    int64_t cpu_end = monitor_thread_cpu_ns();
+    double wall_s = (double)(gpio_sim_now_ns() - wall_start) / 1e9;
+    atomic_store(&measuring, false);
+    thrd_join(visibility, nullptr);
+    thrd_join(decision, nullptr);
+
+    print_report(cpu_start >= 0 && cpu_end >= 0 ? cpu_end - cpu_start : -1, wall_s);
+    printf("FX decisions: %d (%d above step midpoint)\n", stages[STAGE_DECISION].count, decisions_high);
+    exit_code = 0;
+
+out_generator:
+    if (use_sim) {
+        gpio_sim_generator_stop(&generator);
+    }
+out_gpio:
+    for (int i = 0; i < num_channels; i++) {
+        if (monitors[i]) {
+            pwm_monitor_stop(monitors[i]);
+            pwm_monitor_destroy(monitors[i]);
+        }
+        gpio_sim_line_close(&lines[i]);
+    }
+    gpio_cleanup();
+out_source:
+    if (use_sim) {
+        gpio_sim_chip_destroy();
+    }
+    if (synth_path[0]) {
+        unlink(synth_path);
+    }
+    logging_shutdown();
+    return exit_code;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file gpio_sim.c
+ * @brief gpio-sim chip and RC PWM signal generator shared by the test tools
+ */
+
+#include "gpio_sim.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SIM_CONFIGFS   "/sys/kernel/config/gpio-sim/sfxhub-test"
+#define SIM_NUM_LINES  28
+
+int64_t gpio_sim_now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (int64_t)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void gpio_sim_sleep_until(int64_t target_ns) {
+    struct timespec ts = { .tv_sec = target_ns / 1000000000LL, .tv_nsec = target_ns % 1000000000LL };
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR) {}
+}
+
+static int write_file(const char *path, const char *value) {
+    int fd = open(path, O_WRONLY);
+    if (fd < 0) return -1;
+    ssize_t n = write(fd, value, strlen(value));
+    close(fd);
+    return n == (ssize_t)strlen(value) ? 0 : -1;
+}
+
+static int read_file(const char *path, char *buf, size_t size) {
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    bool ok = fgets(buf, (int)size, f) != NULL;
+    fclose(f);
+    if (!ok) return -1;
+    buf[strcspn(buf, "\n")] = '\0';
+    return 0;
+}
+
+// ============================================================================
+// GPIO-SIM CHIP
+// ============================================================================
+
+void gpio_sim_chip_destroy(void) {
+    write_file(SIM_CONFIGFS "/live", "0");
+    rmdir(SIM_CONFIGFS "/bank0");
+    rmdir(SIM_CONFIGFS);
+}
+
+int gpio_sim_chip_create(char *dev_path, size_t dev_size, char *sysfs_dir, size_t sysfs_size) {
+    char num_lines[16];
+    char dev_name[64];
+    char chip_name[64];
+
+    gpio_sim_chip_destroy();  // Leftover from an aborted run
+    snprintf(num_lines, sizeof(num_lines), "%d", SIM_NUM_LINES);
+
+    if (mkdir(SIM_CONFIGFS, 0755) != 0 || mkdir(SIM_CONFIGFS "/bank0", 0755) != 0) {
+        fprintf(stderr, "Cannot create %s: %s (is gpio-sim loaded and configfs mounted?)\n",
+                SIM_CONFIGFS, strerror(errno));
+        return -1;
+    }
+    if (write_file(SIM_CONFIGFS "/bank0/num_lines", num_lines) != 0 ||
+        write_file(SIM_CONFIGFS "/live", "1") != 0 ||
+        read_file(SIM_CONFIGFS "/dev_name", dev_name, sizeof(dev_name)) != 0 ||
+        read_file(SIM_CONFIGFS "/bank0/chip_name", chip_name, sizeof(chip_name)) != 0) {
+        fprintf(stderr, "Cannot bring up gpio-sim chip: %s\n", strerror(errno));
+        gpio_sim_chip_destroy();
+        return -1;
+    }
+
+    snprintf(dev_path, dev_size, "/dev/%s", chip_name);
+    snprintf(sysfs_dir, sysfs_size, "/sys/devices/platform/%s/%s", dev_name, chip_name);
+    return 0;
+}
+
+// ============================================================================
+// LINES
+// ============================================================================
+
+static void line_set(GPIOSimLine *line, bool high) {
+    const char *value = high ? "pull-up" : "pull-down";
+    if (pwrite(line->pull_fd, value, strlen(value), 0) < 0) {
+        fprintf(stderr, "Pull write failed on GPIO %d: %s\n", line->pin, strerror(errno));
+    }
+}
+
+int gpio_sim_line_open(GPIOSimLine *line, const char *sysfs_dir) {
+    char path[256];
+    snprintf(path, sizeof(path), "%s/sim_gpio%d/pull", sysfs_dir, line->pin);
+    line->pull_fd = open(path, O_WRONLY);
+    if (line->pull_fd < 0) {
+        fprintf(stderr, "Cannot open %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+    line_set(line, false);
+    return 0;
+}
+
+void gpio_sim_line_close(GPIOSimLine *line) {
+    if (line->pull_fd >= 0) {
+        close(line->pull_fd);
+        line->pull_fd = -1;
+    }
+}
+
+// ============================================================================
+// SIGNAL GENERATOR
+// ============================================================================
+
+void gpio_sim_frame_widths(GPIOSimGenerator *gen, int64_t frame_index, int *widths, int *order) {
+    int step = 0;
+    if (gen->step_us != 0 && gen->step_ms > 0) {
+        int64_t frames_per_step = (int64_t)gen->rate_hz * gen->step_ms / 1000;
+        if (frames_per_step < 1) frames_per_step = 1;
+        step = (frame_index / frames_per_step) % 2 ? gen->step_us : 0;
+    }
+
+    for (int i = 0; i < gen->count; i++) {
+        int jitter = gen->jitter_us > 0 ? (rand() % (2 * gen->jitter_us + 1)) - gen->jitter_us : 0;
+        widths[i] = gen->lines[i].nominal_us + step + jitter;
+        order[i] = i;
+    }
+    for (int i = 1; i < gen->count; i++) {
+        for (int j = i; j > 0 && widths[order[j]] < widths[order[j - 1]]; j--) {
+            int t = order[j]; order[j] = order[j - 1]; order[j - 1] = t;
+        }
+    }
+}
+
+static int generator_thread(void *arg) {
+    GPIOSimGenerator *gen = arg;
+    int64_t period_ns = 1000000000LL / gen->rate_hz;
+    int64_t frame_ns = gpio_sim_now_ns() + 10000000LL;
+    int order[GPIO_SIM_MAX_CHANNELS];
+    int widths[GPIO_SIM_MAX_CHANNELS];
+
+    for (int64_t frame = 0; atomic_load(&gen->running); frame++) {
+        gpio_sim_frame_widths(gen, frame, widths, order);
+
+        gpio_sim_sleep_until(frame_ns);
+        for (int i = 0; i < gen->count; i++) {
+            line_set(&gen->lines[i], true);
+        }
+        for (int i = 0; i < gen->count; i++) {
+            GPIOSimLine *line = &gen->lines[order[i]];
+            gpio_sim_sleep_until(frame_ns + (int64_t)widths[order[i]] * 1000);
+            atomic_store(&line->fall_issued_ns, gpio_sim_now_ns());
+            line_set(line, false);
+        }
+        frame_ns += period_ns;
+    }
+    return 0;
+}
+
+int gpio_sim_generator_start(GPIOSimGenerator *gen) {
+    if (gen->count < 1 || gen->count > GPIO_SIM_MAX_CHANNELS || gen->rate_hz < 1) {
+        return -1;
+    }
+    atomic_store(&gen->running, true);
+    if (thrd_create(&gen->thread, generator_thread, gen) != thrd_success) {
+        atomic_store(&gen->running, false);
+        return -1;
+    }
+    return 0;
+}
+
+void gpio_sim_generator_stop(GPIOSimGenerator *gen) {
+    if (atomic_exchange(&gen->running, false)) {
+        thrd_join(gen->thread, NULL);
+    }
+}
@@ -0,0 +1,105 @@
+#ifndef GPIO_SIM_H
+#define GPIO_SIM_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <threads.h>
+
+/**
+ * @file gpio_sim.h
+ * @brief gpio-sim chip and RC PWM signal generator shared by the test tools
+ *
+ * The chip is created through configfs and its lines are driven by writing
+ * pull-up / pull-down to sysfs, which the kernel reports as edges to any
+ * gpiod request on the simulated chip. Needs root and the gpio-sim module.
+ */
+
+#define GPIO_SIM_MAX_CHANNELS 8
+
+// One simulated input line
+typedef struct {
+    int pin;                          // Line offset (= BCM pin of the input channel)
+    int nominal_us;                   // Pulse width without jitter or step
+    int pull_fd;                      // sysfs pull attribute (-1 = not open)
+    _Atomic int64_t fall_issued_ns;   // Written just before each falling edge
+} GPIOSimLine;
+
+// Frame generator: all lines rise together at the start of each frame and fall
+// in width order, so any frame rate with period > 2.2 ms works for every line
+typedef struct {
+    GPIOSimLine *lines;
+    int count;
+    int rate_hz;
+    int jitter_us;                    // Uniform ± jitter on every pulse
+    int step_us;                      // Added to every width on alternate step periods (0 = steady)
+    int step_ms;                      // Step period
+    atomic_bool running;
+    thrd_t thread;
+} GPIOSimGenerator;
+
+/**
+ * Current CLOCK_MONOTONIC time (same clock as gpiod edge timestamps)
+ * @return Nanoseconds
+ */
+int64_t gpio_sim_now_ns(void);
+
+/**
+ * Sleep until an absolute CLOCK_MONOTONIC time
+ * @param target_ns Deadline in nanoseconds
+ */
+void gpio_sim_sleep_until(int64_t target_ns);
+
+/**
+ * Create a live gpio-sim chip, removing one left over from an aborted run
+ * @param dev_path Out: /dev/gpiochipN of the new chip
+ * @param dev_size Size of dev_path
+ * @param sysfs_dir Out: sysfs directory holding the sim_gpioN line attributes
+ * @param sysfs_size Size of sysfs_dir
+ * @return 0 on success, -1 on error
+ */
+int gpio_sim_chip_create(char *dev_path, size_t dev_size, char *sysfs_dir, size_t sysfs_size);
+
+/**
+ * Take the chip offline and remove it from configfs
+ */
+void gpio_sim_chip_destroy(void);
+
+/**
+ * Open a line's pull attribute and drive it low
+ * @param line Line to open (pin and nominal_us set by the caller)
+ * @param sysfs_dir Directory from gpio_sim_chip_create()
+ * @return 0 on success, -1 on error
+ */
+int gpio_sim_line_open(GPIOSimLine *line, const char *sysfs_dir);
+
+/**
+ * Close a line opened with gpio_sim_line_open()
+ * @param line Line to close
+ */
+void gpio_sim_line_close(GPIOSimLine *line);
+
+/**
+ * Pulse widths for one frame, including jitter and the current step
+ * @param gen Generator settings
+ * @param frame_index Frame number since start (selects the step phase)
+ * @param widths Out: width per line in microseconds
+ * @param order Out: line indices sorted by width (falling edge order)
+ */
+void gpio_sim_frame_widths(GPIOSimGenerator *gen, int64_t frame_index, int *widths, int *order);
+
+/**
+ * Start driving the lines from a generator thread
+ * @param gen Generator (lines, count, rate and jitter set by the caller)
+ * @return 0 on success, -1 on error
+ */
+int gpio_sim_generator_start(GPIOSimGenerator *gen);
+
+/**
+ * Stop the generator thread and wait for it
+ * @param gen Generator
+ */
+void gpio_sim_generator_stop(GPIOSimGenerator *gen);
+
+#endif // GPIO_SIM_H